@@ -117,17 +117,24 @@ protected:
     DEFINE_DATA_WITH_PARENT(
         ICarbonCalc,
         
-        //! Above ground total emissions by year
+        //! Above ground total emissions by year, only years from
+        //! CarbonModelUtils::getRetainedStartYear() are kept
         DEFINE_VARIABLE( ARRAY | NOT_PARSABLE, "above-ground-land-use-change-emissions", mTotalEmissionsAbove, objects::YearVector<double> ),
         
-        //! Below ground total emissions by year
+        //! Below ground total emissions by year, only years from
+        //! CarbonModelUtils::getRetainedStartYear() are kept
         DEFINE_VARIABLE( ARRAY | NOT_PARSABLE, "below-ground-land-use-change-emissions", mTotalEmissionsBelow, objects::YearVector<double> ),
         
-        //! Above ground carbon stock
-        DEFINE_VARIABLE( ARRAY | STATE | NOT_PARSABLE, "above-ground-carbon-stock", mCarbonStock, objects::YearVector<Value> ),
+        //! Above ground carbon stock at the end of each model period.  Only this
+        //! value is needed to start the next period so the years in between are
+        //! not tracked as state.
+        DEFINE_VARIABLE( ARRAY | STATE | NOT_PARSABLE, "above-ground-carbon-stock", mCarbonStock, objects::PeriodVector<Value> ),
+        
+        //! Above ground carbon stock by year as of the last time results were stored
+        DEFINE_VARIABLE( ARRAY | NOT_PARSABLE, "annual-above-ground-carbon-stock", mAnnualCarbonStock, objects::YearVector<double> ),
         
         //! Track gross positive above ground emissions explicitly so we can partition the net emissions to gross
-        //! to report to the climate model
+        //! to report to the climate model, only years from CarbonModelUtils::getRetainedStartYear() are kept
         DEFINE_VARIABLE( ARRAY | NOT_PARSABLE, "gross-positive-above-ground-land-use-change-emissions", mPositiveEmissionsAbove, objects::YearVector<double> ),
         
         //! Time scale for soil carbon emissions
@@ -216,6 +223,9 @@ protected:
                                         const int aYear,
                                         const int aEndYear,
                                         objects::YearVector<double>& aEmissVector);
+
+    void storeHistoricEmissions( const objects::YearVector<double>& aEmissionsAbove,
+                                 const objects::YearVector<double>& aEmissionsBelow );
 private:
     void calcSigmoidCurve( const double aCarbonDiff,
                            const int aYear,
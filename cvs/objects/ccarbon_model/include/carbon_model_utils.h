@@ -63,6 +63,7 @@ public:
 
     static double getSoilTimeScale();
     static int getStartYear();
+    static int getRetainedStartYear();
     static int getEndYear();
 
     static double interpYearHelper( const objects::PeriodVector<double>& aPeriodVector,
@@ -55,10 +55,10 @@ using namespace objects;
 extern Scenario* scenario;
 
 ASimpleCarbonCalc::ASimpleCarbonCalc():
-mTotalEmissionsAbove( CarbonModelUtils::getStartYear(), CarbonModelUtils::getEndYear() ),
-mTotalEmissionsBelow( CarbonModelUtils::getStartYear(), CarbonModelUtils::getEndYear() ),
-mPositiveEmissionsAbove( CarbonModelUtils::getStartYear(), CarbonModelUtils::getEndYear() ),
-mCarbonStock( scenario->getModeltime()->getStartYear(), CarbonModelUtils::getEndYear() )
+mTotalEmissionsAbove( CarbonModelUtils::getRetainedStartYear(), CarbonModelUtils::getEndYear() ),
+mTotalEmissionsBelow( CarbonModelUtils::getRetainedStartYear(), CarbonModelUtils::getEndYear() ),
+mAnnualCarbonStock( scenario->getModeltime()->getStartYear(), CarbonModelUtils::getEndYear() ),
+mPositiveEmissionsAbove( CarbonModelUtils::getRetainedStartYear(), CarbonModelUtils::getEndYear() )
 {
     int endYear = CarbonModelUtils::getEndYear();
     const Modeltime* modeltime = scenario->getModeltime();
@@ -101,19 +101,25 @@ double ASimpleCarbonCalc::calc( const int aPeriod, const int aEndYear, const Car
             const double aboveGroundCarbonDensity = mLandUseHistory->getHistoricAboveGroundCarbonDensity();
             const double belowGroundCarbonDensity = mLandUseHistory->getHistoricBelowGroundCarbonDensity();
             
+            // The full history is accumulated into temporary vectors, of which only the
+            // retained years are kept.  Future periods only need the resulting carbon stock.
+            YearVector<double> historyEmissionsAbove( CarbonModelUtils::getStartYear(), aEndYear, 0.0 );
+            YearVector<double> historyEmissionsBelow( CarbonModelUtils::getStartYear(), aEndYear, 0.0 );
             double currCarbonStock = aboveGroundCarbonDensity * mLandUseHistory->getAllocation( CarbonModelUtils::getStartYear() );
             
             double prevLand = mLandUseHistory->getAllocation( CarbonModelUtils::getStartYear() - 1 );
             for( int year = CarbonModelUtils::getStartYear(); year <= mLandUseHistory->getMaxYear(); ++year ) {
                 double currLand = mLandUseHistory->getAllocation( year );
                 double landDifference = prevLand - currLand;
-                calcAboveGroundCarbonEmission( aCalcMode, currCarbonStock, prevLand, currLand, aboveGroundCarbonDensity, year, aEndYear, mTotalEmissionsAbove );
-                calcBelowGroundCarbonEmission( landDifference * belowGroundCarbonDensity, year, aEndYear, mTotalEmissionsBelow );
+                calcAboveGroundCarbonEmission( aCalcMode, currCarbonStock, prevLand, currLand, aboveGroundCarbonDensity, year, aEndYear, historyEmissionsAbove );
+                calcBelowGroundCarbonEmission( landDifference * belowGroundCarbonDensity, year, aEndYear, historyEmissionsBelow );
                 prevLand = currLand;
-                currCarbonStock -= mTotalEmissionsAbove[ year ];
+                currCarbonStock -= historyEmissionsAbove[ year ];
             }
+            storeHistoricEmissions( historyEmissionsAbove, historyEmissionsBelow );
             mHasCalculatedHistoricEmiss = true;
-            mCarbonStock[ modeltime->getStartYear() ] = currCarbonStock;
+            mCarbonStock[ 0 ] = currCarbonStock;
+            mAnnualCarbonStock[ modeltime->getStartYear() ] = currCarbonStock;
         }
     }
     else {
@@ -133,6 +139,9 @@ double ASimpleCarbonCalc::calc( const int aPeriod, const int aEndYear, const Car
         const double avgAnnualChangeInLand = ( mLandLeaf->getLandAllocation( mLandLeaf->getName(), aPeriod ) - currLand )
             / modeltime->gettimestep( aPeriod );
         double prevCarbonBelow = currLand * getActualBelowGroundCarbonDensity( year );
+        // The carbon stock is only tracked by year while calculating, starting
+        // from the stock at the end of the previous period
+        double carbonStock = mCarbonStock[ aPeriod - 1 ];
 
         for( ++year; year <= modelYear; ++year ) {
             double prevLand = currLand;
@@ -141,16 +150,22 @@ double ASimpleCarbonCalc::calc( const int aPeriod, const int aEndYear, const Car
             // we need to be careful about accessing the carbon stock from a previous timestep
             // when we are intending to calculate in eReverseCalc as the previous timestep may have
             // already calculated in eStoreResults
-            calcAboveGroundCarbonEmission( aCalcMode, aCalcMode == eReverseCalc && (year - 1) == prevModelYear ?
-                                          mSavedCarbonStock[ aPeriod - 1 ] :
-                                          mCarbonStock[ year - 1 ], prevLand, currLand, getActualAboveGroundCarbonDensity( year ), year, aEndYear, currEmissionsAbove );
+            calcAboveGroundCarbonEmission( aCalcMode, aCalcMode != eReverseCalc ? carbonStock :
+                                          (year - 1) == prevModelYear ? mSavedCarbonStock[ aPeriod - 1 ] :
+                                          mAnnualCarbonStock[ year - 1 ], prevLand, currLand, getActualAboveGroundCarbonDensity( year ), year, aEndYear, currEmissionsAbove );
             calcBelowGroundCarbonEmission( prevCarbonBelow - currCarbonBelow, year, aEndYear, currEmissionsBelow );
 
             if( aCalcMode != eReverseCalc ) {
-                mCarbonStock[ year ] = mCarbonStock[ year - 1 ] - ( mTotalEmissionsAbove[ year ] + currEmissionsAbove[ year ] );
+                carbonStock -= mTotalEmissionsAbove[ year ] + currEmissionsAbove[ year ];
+                if( aCalcMode == eStoreResults ) {
+                    mAnnualCarbonStock[ year ] = carbonStock;
+                }
             }
             prevCarbonBelow = currCarbonBelow;
         }
+        if( aCalcMode != eReverseCalc ) {
+            mCarbonStock[ aPeriod ] = carbonStock;
+        }
         
         if( aCalcMode == eStoreResults ) {
             // add current emissions to the total
@@ -158,7 +173,7 @@ double ASimpleCarbonCalc::calc( const int aPeriod, const int aEndYear, const Car
                 mTotalEmissionsAbove[ year ] += currEmissionsAbove[ year ];
                 mTotalEmissionsBelow[ year ] += currEmissionsBelow[ year ];
             }
-            mSavedCarbonStock[ aPeriod - 1 ] = mCarbonStock[ prevModelYear ];
+            mSavedCarbonStock[ aPeriod - 1 ] = mCarbonStock[ aPeriod - 1 ];
             mSavedLandAllocation[ aPeriod - 1 ] = mLandLeaf->getLandAllocation( mLandLeaf->getName(), aPeriod - 1 );
         }
         else if( aCalcMode == eReverseCalc ) {
@@ -205,6 +220,8 @@ void ASimpleCarbonCalc::calcAboveGroundCarbonEmission( const CarbonCalcMode aCal
     if( util::isEqual( carbonDiff, 0.0 ) ) {
         return;
     }
+    // Gross positive emissions are not kept for years prior to those retained.
+    const bool isRetainedYear = aYear >= static_cast<int>( mPositiveEmissionsAbove.getStartYear() );
     
     // Finally, calculate net land use change emissions from changes in
     // above ground carbon.
@@ -219,7 +236,7 @@ void ASimpleCarbonCalc::calcAboveGroundCarbonEmission( const CarbonCalcMode aCal
         // then the calculation below will generate a NaN.  Avoid that
         // by taking the appropriate limit here.
         aEmissVector[ aYear ] += carbonDiff;
-        if(aCalcMode == eStoreResults && carbonDiff > 0.0) {
+        if(aCalcMode == eStoreResults && carbonDiff > 0.0 && isRetainedYear) {
             mPositiveEmissionsAbove[ aYear ] += carbonDiff;
         }
         else if(aCalcMode == eReverseCalc) {
@@ -237,7 +254,7 @@ void ASimpleCarbonCalc::calcAboveGroundCarbonEmission( const CarbonCalcMode aCal
         // but you can show that the formula below just reduces to the
         // expression for carbonDiff at the top of the function.)
         aEmissVector[ aYear ] += ( aPrevCarbonStock / aPrevLandArea ) * ( aPrevLandArea - aCurrLandArea );
-        if(aCalcMode == eStoreResults) {
+        if(aCalcMode == eStoreResults && isRetainedYear) {
             mPositiveEmissionsAbove[ aYear ] += ( aPrevCarbonStock / aPrevLandArea ) * ( aPrevLandArea - aCurrLandArea );
         }
         else if(aCalcMode == eReverseCalc) {
@@ -316,16 +333,33 @@ void ASimpleCarbonCalc::calcSigmoidCurve( const double aCarbonDiff,
     }
 }
 
+/*!
+ * \brief Add the emissions calculated over the historical period to the totals.
+ * \details Only the years from CarbonModelUtils::getRetainedStartYear() onward
+ *          are kept as earlier years are no longer needed once the historical
+ *          carbon stock has been calculated.
+ * \param aEmissionsAbove Above ground emissions accumulated over the full history.
+ * \param aEmissionsBelow Below ground emissions accumulated over the full history.
+ */
+void ASimpleCarbonCalc::storeHistoricEmissions( const YearVector<double>& aEmissionsAbove,
+                                                const YearVector<double>& aEmissionsBelow )
+{
+    for( int year = mTotalEmissionsAbove.getStartYear(); year <= static_cast<int>( mTotalEmissionsAbove.getEndYear() ); ++year ) {
+        mTotalEmissionsAbove[ year ] += aEmissionsAbove[ year ];
+        mTotalEmissionsBelow[ year ] += aEmissionsBelow[ year ];
+    }
+}
+
 double ASimpleCarbonCalc::getNetLandUseChangeEmission( const int aYear ) const {
-    return mTotalEmissionsAbove[ aYear ] + mTotalEmissionsBelow[ aYear ];
+    return getNetLandUseChangeEmissionAbove( aYear ) + getNetLandUseChangeEmissionBelow( aYear );
 }
 
 double ASimpleCarbonCalc::getNetLandUseChangeEmissionAbove( const int aYear ) const {
-    return mTotalEmissionsAbove[ aYear ];
+    return aYear >= static_cast<int>( mTotalEmissionsAbove.getStartYear() ) ? mTotalEmissionsAbove[ aYear ] : 0;
 }
 
 double ASimpleCarbonCalc::getNetLandUseChangeEmissionBelow( const int aYear ) const {
-    return mTotalEmissionsBelow[ aYear ];
+    return aYear >= static_cast<int>( mTotalEmissionsBelow.getStartYear() ) ? mTotalEmissionsBelow[ aYear ] : 0;
 }
 
 void ASimpleCarbonCalc::accept( IVisitor* aVisitor, const int aPeriod ) const {
@@ -417,7 +451,7 @@ mData( CarbonModelUtils::getEndYear() - CarbonModelUtils::getStartYear() + 1 )
 
 double ASimpleCarbonCalc::getAboveGroundCarbonStock( const int aYear ) const {
     const Modeltime* modeltime = scenario->getModeltime();
-    return aYear >= modeltime->getStartYear() ? mCarbonStock[ aYear ] : 0;
+    return aYear >= modeltime->getStartYear() ? mAnnualCarbonStock[ aYear ] : 0;
 }
 
 double ASimpleCarbonCalc::getBelowGroundCarbonStock( const int aYear ) const {
@@ -426,5 +460,5 @@ double ASimpleCarbonCalc::getBelowGroundCarbonStock( const int aYear ) const {
 }
 
 double ASimpleCarbonCalc::getGrossPositiveLandUseChangeEmissionAbove( const int aYear ) const {
-    return mPositiveEmissionsAbove[ aYear ];
+    return aYear >= static_cast<int>( mPositiveEmissionsAbove.getStartYear() ) ? mPositiveEmissionsAbove[ aYear ] : 0;
 }
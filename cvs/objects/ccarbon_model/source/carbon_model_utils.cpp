@@ -44,6 +44,7 @@
 
 #include "ccarbon_model/include/carbon_model_utils.h"
 #include "util/base/include/util.h"
+#include "util/base/include/configuration.h"
 #include "land_allocator/include/land_use_history.h"
 #include "climate/include/iclimate_model.h"
 
@@ -121,6 +122,23 @@ int CarbonModelUtils::getStartYear(){
     return START_YEAR;
 }
 
+/*!
+ * \brief A static function to return the first year for which land-use change
+ *        emissions are kept after the historical calculation.
+ * \details Emissions for earlier years are only needed while calculating the
+ *          historical carbon stock.  The years kept are those which may still be
+ *          reported: the years of the first model period which are passed to the
+ *          climate model and the years written to the output database starting
+ *          from the carbon-output-start-year configuration parameter.
+ * \return The first year for which emissions are kept.
+ */
+int CarbonModelUtils::getRetainedStartYear(){
+    const static int RETAINED_START_YEAR = max( getStartYear(), min(
+        Configuration::getInstance()->getInt( "carbon-output-start-year", 1990 ),
+        scenario->getModeltime()->getStartYear() - scenario->getModeltime()->gettimestep( 0 ) + 1 ) );
+    return RETAINED_START_YEAR;
+}
+
 /*!
  * \brief Return the last year of the climate calculation.
  * \author Jim Naslund
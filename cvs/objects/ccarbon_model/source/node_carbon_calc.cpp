@@ -155,6 +155,11 @@ void NodeCarbonCalc::calcLandUseHistory()
     vector<double> currLand( mCarbonCalcs.size() );
     vector<double> diffLand( mCarbonCalcs.size() );
     vector<double> carbonStock( mCarbonCalcs.size() );
+    // The full history is accumulated into temporary vectors, of which only the
+    // retained years are kept by the carbon calcs.
+    vector<YearVector<double> > emissionsAbove( mCarbonCalcs.size(),
+        YearVector<double>( CarbonModelUtils::getStartYear(), CarbonModelUtils::getEndYear(), 0.0 ) );
+    vector<YearVector<double> > emissionsBelow( emissionsAbove );
     double prevLandTotal = 0;
     for( size_t i = 0; i < mCarbonCalcs.size(); ++i ) {
         double land = mCarbonCalcs[ i ]->mLandUseHistory->getAllocation( CarbonModelUtils::getStartYear() - 1 );
@@ -188,12 +193,12 @@ void NodeCarbonCalc::calcLandUseHistory()
                 assert( diffLand[ i ] == 0 || diffLandTotal == 0 );
                 mCarbonCalcs[ i ]->calcAboveGroundCarbonEmission( ICarbonCalc::eStoreResults, carbonStock[ i ], prevLand[ i ], prevLand[ i ] + newDiff,
                                                                   aboveGroundCarbonDensity[ i ], year,
-                                                                  CarbonModelUtils::getEndYear(), mCarbonCalcs[ i ]->mTotalEmissionsAbove );
+                                                                  CarbonModelUtils::getEndYear(), emissionsAbove[ i ] );
                 mCarbonCalcs[ i ]->calcBelowGroundCarbonEmission( -1 * newDiff * belowGroundCarbonDensity[ i ], year,
-                                                                  CarbonModelUtils::getEndYear(), mCarbonCalcs[ i ]->mTotalEmissionsBelow );
+                                                                  CarbonModelUtils::getEndYear(), emissionsBelow[ i ] );
             }
             // Adjust carbon stock for any emissions that occurred from this change.
-            carbonStock[ i ] -= mCarbonCalcs[ i ]->mTotalEmissionsAbove[ year ];
+            carbonStock[ i ] -= emissionsAbove[ i ][ year ];
         }
         // The difference in total land area change should have all been allocated
         // across the various land types.
@@ -234,7 +239,7 @@ void NodeCarbonCalc::calcLandUseHistory()
         // options that increased in land.
         for( size_t i = 0; i < mCarbonCalcs.size(); ++i ) {
             if( diffLand[ i ] > 0 ) {
-                double emissBeforeMove = mCarbonCalcs[ i ]->mTotalEmissionsAbove[ year ];
+                double emissBeforeMove = emissionsAbove[ i ][ year ];
                 // Calculate the difference in carbon densities which would drive any
                 // emissions or uptake.
                 double fractionOfGain = diffLand[ i ] / totalLandGain;
@@ -242,12 +247,12 @@ void NodeCarbonCalc::calcLandUseHistory()
                 double carbonDiffAboveDensity = -1 * ( currCarbonMove / diffLand[ i ] - aboveGroundCarbonDensity[ i ] );
                 double carbonDiffBelow = -1 * ( diffLand[ i ] * belowGroundCarbonDensity[ i ] - fractionOfGain * carbonPrevBelow );
                 mCarbonCalcs[ i ]->calcAboveGroundCarbonEmission( ICarbonCalc::eStoreResults, 0, 0, diffLand[ i ], carbonDiffAboveDensity, year,
-                                                                  CarbonModelUtils::getEndYear(), mCarbonCalcs[ i ]->mTotalEmissionsAbove );
+                                                                  CarbonModelUtils::getEndYear(), emissionsAbove[ i ] );
                 mCarbonCalcs[ i ]->calcBelowGroundCarbonEmission( carbonDiffBelow, year, CarbonModelUtils::getEndYear(),
-                                                                  mCarbonCalcs[ i ]->mTotalEmissionsBelow );
+                                                                  emissionsBelow[ i ] );
                 // Adjust carbon stock to include the carbon being moved in minus any emissions because of moving
                 // the carbon.
-                carbonStock[ i ] += currCarbonMove - ( mCarbonCalcs[ i ]->mTotalEmissionsAbove[ year ] - emissBeforeMove );
+                carbonStock[ i ] += currCarbonMove - ( emissionsAbove[ i ][ year ] - emissBeforeMove );
             }
         }
         
@@ -257,7 +262,9 @@ void NodeCarbonCalc::calcLandUseHistory()
 
     // Make sure future year calculations start from the correct historical carbon stock.
     for( size_t i = 0; i < mCarbonCalcs.size(); ++i ) {
-        mCarbonCalcs[ i ]->mCarbonStock[ mCarbonCalcs[ i ]->mLandUseHistory->getMaxYear() ] = carbonStock[ i ];
+        mCarbonCalcs[ i ]->storeHistoricEmissions( emissionsAbove[ i ], emissionsBelow[ i ] );
+        mCarbonCalcs[ i ]->mCarbonStock[ 0 ] = carbonStock[ i ];
+        mCarbonCalcs[ i ]->mAnnualCarbonStock[ mCarbonCalcs[ i ]->mLandUseHistory->getMaxYear() ] = carbonStock[ i ];
     }
 
     mHasCalculatedHistoricEmiss = true;
@@ -366,7 +373,7 @@ void NodeCarbonCalc::calc( const int aPeriod, const int aEndYear, const ICarbonC
                 // already calculated in eStoreResults
                 double currCarbonMovedByYear = -1 * ( aCalcMode == ICarbonCalc::eReverseCalc ?
                                                         mCarbonCalcs[ i ]->mSavedCarbonStock[ aPeriod - 1 ] :
-                                                        mCarbonCalcs[ i ]->mCarbonStock[ prevModelYear ] )
+                                                        mCarbonCalcs[ i ]->mCarbonStock[ aPeriod - 1 ] )
                     * diffLandByTimestep[ i ] / prevLandByTimestep[ i ] / modelTimestep;
                 totalInternalCarbonAboveMovedByYear += currCarbonMovedByYear;
                 internalCarbonAboveMovedByYear[ i ] = currCarbonMovedByYear;
@@ -382,13 +389,25 @@ void NodeCarbonCalc::calc( const int aPeriod, const int aEndYear, const ICarbonC
 
         vector<double> prevLand( prevLandByTimestep );
         vector<double> currLand( mCarbonCalcs.size() );
+        // The carbon stock is only tracked by year while calculating, starting
+        // from the stock at the end of the previous period.
+        vector<double> carbonStock( mCarbonCalcs.size() );
+        vector<double> prevCarbonStock( mCarbonCalcs.size() );
+        for( size_t i = 0; i < mCarbonCalcs.size(); ++i ) {
+            carbonStock[ i ] = mCarbonCalcs[ i ]->mCarbonStock[ aPeriod - 1 ];
+        }
         for( year = prevModelYear + 1; year <= modelYear; ++year ) {
             // Initialize the carbon stock in this year to the carbon stock of the previous year minus
             // any emissions that have already been allocated in this year from earlier year land decisions.
-            if( aCalcMode != ICarbonCalc::eReverseCalc ) {
-                for( size_t i = 0; i < mCarbonCalcs.size(); ++i ) {
-                    mCarbonCalcs[ i ]->mCarbonStock[ year ] = mCarbonCalcs[ i ]->mCarbonStock[ year - 1 ] -
-                        ( mCarbonCalcs[ i ]->mTotalEmissionsAbove[ year ] + (*currEmissionsAbove[ i ])[ year ] );
+            for( size_t i = 0; i < mCarbonCalcs.size(); ++i ) {
+                // we need to be careful about accessing the carbon stock from a previous timestep
+                // when we are intending to calculate in eReverseCalc as the previous timestep may have
+                // already calculated in eStoreResults
+                prevCarbonStock[ i ] = aCalcMode != ICarbonCalc::eReverseCalc ? carbonStock[ i ] :
+                    (year - 1) == prevModelYear ? mCarbonCalcs[ i ]->mSavedCarbonStock[ aPeriod - 1 ] :
+                    mCarbonCalcs[ i ]->mAnnualCarbonStock[ year - 1 ];
+                if( aCalcMode != ICarbonCalc::eReverseCalc ) {
+                    carbonStock[ i ] -= mCarbonCalcs[ i ]->mTotalEmissionsAbove[ year ] + (*currEmissionsAbove[ i ])[ year ];
                 }
             }
             // Calculate emissions from changes in land that was removed/added from outside of this node.
@@ -396,17 +415,12 @@ void NodeCarbonCalc::calc( const int aPeriod, const int aEndYear, const ICarbonC
                 currLand[ i ] = prevLand[ i ] + diffLandFromExternalByYear[ i ];
                 double carbonDiffBelowPerYear = -1 * diffLandFromExternalByYear[ i ] * belowGroundCarbonDensity[ i ];
                 double prevEmiss = (*currEmissionsAbove[ i ])[ year ];
-                // we need to be careful about accessing the carbon stock from a previous timestep
-                // when we are intending to calculate in eReverseCalc as the previous timestep may have
-                // already calculated in eStoreResults
-                mCarbonCalcs[ i ]->calcAboveGroundCarbonEmission( aCalcMode, aCalcMode == ICarbonCalc::eReverseCalc && (year - 1) == prevModelYear ?
-                                                                        mCarbonCalcs[ i ]->mSavedCarbonStock[ aPeriod - 1 ] :
-                                                                        mCarbonCalcs[ i ]->mCarbonStock[ year - 1 ],
+                mCarbonCalcs[ i ]->calcAboveGroundCarbonEmission( aCalcMode, prevCarbonStock[ i ],
                                                                   prevLand[ i ], currLand[ i ], aboveGroundCarbonDensity[ i ], year, aEndYear,
                                                                   *currEmissionsAbove[ i ] );
                 mCarbonCalcs[ i ]->calcBelowGroundCarbonEmission( carbonDiffBelowPerYear, year, aEndYear, *currEmissionsBelow[ i ] );
                 if( aCalcMode != ICarbonCalc::eReverseCalc ) {
-                    mCarbonCalcs[ i ]->mCarbonStock[ year ] -= (*currEmissionsAbove[ i ])[ year ] - prevEmiss;
+                    carbonStock[ i ] -= (*currEmissionsAbove[ i ])[ year ] - prevEmiss;
                 }
             }
             // Calculate emissions from changes in land internal to this node.  Carbon can move internally
@@ -430,17 +444,25 @@ void NodeCarbonCalc::calc( const int aPeriod, const int aEndYear, const ICarbonC
                     // Adjust carbon stock to include the carbon being moved in minus any emissions because of moving
                     // the carbon.
                     if( aCalcMode != ICarbonCalc::eReverseCalc ) {
-                        mCarbonCalcs[ i ]->mCarbonStock[ year ] += currCarbonMove - ( (*currEmissionsAbove[ i ])[ year ] - emissBeforeMove );
+                        carbonStock[ i ] += currCarbonMove - ( (*currEmissionsAbove[ i ])[ year ] - emissBeforeMove );
                     }
                 }
                 else {
                     // Remove the carbon that is changing land type from the carbon stock without
                     // emissions.
                     if( aCalcMode != ICarbonCalc::eReverseCalc ) {
-                        mCarbonCalcs[ i ]->mCarbonStock[ year ] -= internalCarbonAboveMovedByYear[ i ];
+                        carbonStock[ i ] -= internalCarbonAboveMovedByYear[ i ];
                     }
                 }
                 prevLand[ i ] = currLand[ i ];
+                if( aCalcMode == ICarbonCalc::eStoreResults ) {
+                    mCarbonCalcs[ i ]->mAnnualCarbonStock[ year ] = carbonStock[ i ];
+                }
+            }
+        }
+        if( aCalcMode != ICarbonCalc::eReverseCalc ) {
+            for( size_t i = 0; i < mCarbonCalcs.size(); ++i ) {
+                mCarbonCalcs[ i ]->mCarbonStock[ aPeriod ] = carbonStock[ i ];
             }
         }
 
@@ -450,7 +472,7 @@ void NodeCarbonCalc::calc( const int aPeriod, const int aEndYear, const ICarbonC
                 for( year = prevModelYear + 1; year <= aEndYear; ++year ) {
                     mCarbonCalcs[ i ]->mTotalEmissionsAbove[ year ] += (*currEmissionsAbove[ i ])[ year ];
                     mCarbonCalcs[ i ]->mTotalEmissionsBelow[ year ] += (*currEmissionsBelow[ i ])[ year ];
-                    mCarbonCalcs[ i ]->mSavedCarbonStock[ aPeriod - 1 ] = mCarbonCalcs[ i ]->mCarbonStock[ prevModelYear ];
+                    mCarbonCalcs[ i ]->mSavedCarbonStock[ aPeriod - 1 ] = mCarbonCalcs[ i ]->mCarbonStock[ aPeriod - 1 ];
                     mCarbonCalcs[ i ]->mSavedLandAllocation[ aPeriod - 1 ] = mCarbonCalcs[ i ]->mLandLeaf->getLandAllocation( mCarbonCalcs[ i ]->mLandLeaf->getName(), aPeriod - 1 );
                 }
             }
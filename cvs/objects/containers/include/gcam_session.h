@@ -0,0 +1,151 @@
+#ifndef _GCAM_SESSION_H_
+#define _GCAM_SESSION_H_
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+
+/*! 
+ * \file gcam_session.h
+ * \ingroup Objects
+ * \brief The GCAMSession class header file.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class Scenario;
+
+/*! 
+ * \ingroup Objects
+ * \brief An in process interface to set up, modify, run, and query a single
+ *        scenario.
+ * \details GCAMSession allows tools which link against the GCAM library to drive
+ *          the model without going through the command line executable.  The
+ *          configuration and logger set up are read once during initialize after
+ *          which callers may:
+ *          - Apply add-on XML given either as a string or a file name.
+ *          - Set fixed tax policy vectors for a GHG market.
+ *          - Run the scenario starting from any period up to any period.
+ *          - Query model data using the GCAMFusion search syntax, for instance
+ *            "world/region[NamedFilter,StringEquals,USA]/sector/subsector/technology/period[YearFilter,IntEquals,2020]/output/physical-output".
+ *          - Save a marker of the changes applied so far and later reset the
+ *            session back to it.
+ *
+ *          Add-on XML may create new objects which must go through completeInit
+ *          so the session keeps a journal of every change made to it.  The
+ *          scenario is rebuilt from the configured inputs and the journal the
+ *          next time it is needed after add-on XML was applied or the session was
+ *          reset, otherwise changes such as taxes are applied to the running
+ *          scenario directly.  The journal is also what allows saved states to
+ *          be restored exactly.
+ *
+ *          The session sets the global scenario pointer to the scenario it manages
+ *          and so only one session may be active per process.  Programs which use
+ *          this class must define the globals normally defined in main.cpp.
+ */
+class GCAMSession {
+public:
+    GCAMSession();
+    ~GCAMSession();
+
+    bool initialize( const std::string& aConfigurationFile,
+                     const std::string& aLoggerFactoryFile );
+
+    bool applyXMLString( const std::string& aXMLContent );
+
+    bool applyXMLFile( const std::string& aXMLFile );
+
+    bool setPolicyValues( const std::string& aPolicyName,
+                          const std::string& aMarket,
+                          const std::vector<double>& aTaxes );
+
+    bool run( const int aFromPeriod, const int aToPeriod );
+
+    std::vector<double> query( const std::string& aQueryPath );
+
+    int saveState();
+
+    bool resetState( const int aStateID );
+
+    Scenario* getScenario();
+
+private:
+    /*!
+     * \brief A single change made to the session which must be replayed when
+     *        the scenario is rebuilt.
+     */
+    struct JournalEntry {
+        //! The type of change.
+        enum EntryType {
+            XML_STRING,
+            XML_FILE,
+            POLICY
+        } mType;
+
+        //! The XML content, XML file name, or policy name.
+        std::string mContent;
+
+        //! The market of a POLICY entry.
+        std::string mMarket;
+
+        //! The taxes by period of a POLICY entry.
+        std::vector<double> mTaxes;
+    };
+
+    //! The scenario being managed, null until it has been set up.
+    std::unique_ptr<Scenario> mScenario;
+
+    //! All of the changes made to the session in the order they were made.
+    std::vector<JournalEntry> mJournal;
+
+    //! The journal length at each saved state, indexed by state ID.
+    std::vector<unsigned int> mSavedStates;
+
+    //! Whether initialize has succeeded.
+    bool mIsInitialized;
+
+    //! Whether the scenario must be rebuilt before it is next used.
+    bool mNeedsRebuild;
+
+    bool rebuildScenario();
+
+    void applyPolicy( const JournalEntry& aEntry );
+
+    bool ensureScenario();
+};
+
+#endif // _GCAM_SESSION_H_
@@ -49,6 +49,38 @@
 
 class Tabs;
 
+/*!
+* \ingroup Objects
+* \brief A key into an IInfo which has been resolved ahead of time.
+* \details Keys which are part of the Info schema of well known keys are
+*          resolved to a fixed slot index when the InfoKey is created so that
+*          lookups through it are a direct array access with no string
+*          comparisons.  Keys which are not part of the schema fall back to a
+*          search by name.  InfoKeys are intended to be created once, for
+*          instance as static constants, and reused in calculations.
+*/
+class InfoKey
+{
+public:
+    explicit InfoKey( const std::string& aName );
+
+    //! Get the name of the key.
+    const std::string& getName() const {
+        return mName;
+    }
+
+    //! Get the schema slot of the key or -1 if it is not in the schema.
+    int getSlot() const {
+        return mSlot;
+    }
+private:
+    //! The name of the key.
+    std::string mName;
+
+    //! The schema slot index or -1 if the key is not a well known key.
+    int mSlot;
+};
+
 /*!
 * \ingroup Objects
 * \brief This interface represents a set of properties which can be accessed by
@@ -201,6 +233,45 @@ public:
     */
     virtual bool hasValue( const std::string& aStringKey ) const = 0;
 
+    /*! \brief Get a boolean from the IInfo with a pre-resolved key.
+    * \param aKey The key for which to search the IInfo object.
+    * \param aMustExist Whether the value should exist in the IInfo.
+    * \return The boolean associated with the key or false if it does not exist.
+    * \sa getBoolean( const std::string&, const bool )
+    */
+    virtual bool getBoolean( const InfoKey& aKey, const bool aMustExist ) const = 0;
+
+    /*! \brief Get an integer from the IInfo with a pre-resolved key.
+    * \param aKey The key for which to search the IInfo object.
+    * \param aMustExist Whether the value should exist in the IInfo.
+    * \return The integer associated with the key or zero if it does not exist.
+    * \sa getInteger( const std::string&, const bool )
+    */
+    virtual int getInteger( const InfoKey& aKey, const bool aMustExist ) const = 0;
+
+    /*! \brief Get a double from the IInfo with a pre-resolved key.
+    * \param aKey The key for which to search the IInfo object.
+    * \param aMustExist Whether the value should exist in the IInfo.
+    * \return The double associated with the key or zero if it does not exist.
+    * \sa getDouble( const std::string&, const bool )
+    */
+    virtual double getDouble( const InfoKey& aKey, const bool aMustExist ) const = 0;
+
+    //! \sa getBooleanHelper( const std::string&, bool& )
+    virtual bool getBooleanHelper( const InfoKey& aKey, bool& aFound ) const = 0;
+
+    //! \sa getIntegerHelper( const std::string&, bool& )
+    virtual int getIntegerHelper( const InfoKey& aKey, bool& aFound ) const = 0;
+
+    //! \sa getDoubleHelper( const std::string&, bool& )
+    virtual double getDoubleHelper( const InfoKey& aKey, bool& aFound ) const = 0;
+
+    /*! \brief Return whether a value exists in the IInfo with a pre-resolved key.
+    * \param aKey The key for which to search the IInfo object.
+    * \return Whether the key exists in the IInfo.
+    */
+    virtual bool hasValue( const InfoKey& aKey ) const = 0;
+
     /*! \brief Write the IInfo object to an output stream as XML.
     * \details Writes the set of keys and values to an output stream as XML.
     * \param aPeriod Model period for which to write debugging information.
@@ -52,6 +52,8 @@
 #include "containers/include/iinfo.h"
 
 #include <map>
+#include <vector>
+#include "util/base/include/atom.h"
 #include "util/base/include/xml_helper.h"
 #include "util/base/include/configuration.h"
 #include "util/base/include/definitions.h"
@@ -102,7 +104,23 @@ public:
 
     bool hasValue( const std::string& aStringKey ) const;
 
+    bool getBoolean( const InfoKey& aKey, const bool aMustExist ) const;
+
+    int getInteger( const InfoKey& aKey, const bool aMustExist ) const;
+
+    double getDouble( const InfoKey& aKey, const bool aMustExist ) const;
+
+    bool getBooleanHelper( const InfoKey& aKey, bool& aFound ) const;
+
+    int getIntegerHelper( const InfoKey& aKey, bool& aFound ) const;
+
+    double getDoubleHelper( const InfoKey& aKey, bool& aFound ) const;
+
+    bool hasValue( const InfoKey& aKey ) const;
+
     void toDebugXML( const int aPeriod, Tabs* aTabs, std::ostream& aOut ) const;
+
+    static int getSchemaSlot( const std::string& aStringKey );
 protected:
     Info( const IInfo* aParentInfo, const std::string& aOwnerName );
 
@@ -110,10 +128,50 @@ private:
 
     std::string mOwnerName;
 
+    //! The types of values which may be stored in a schema slot.  Note that
+    //! strings are always stored in the fallback map.
+    enum SlotType {
+        EMPTY,
+        BOOLEAN,
+        INTEGER,
+        DOUBLE
+    };
+
+    //! A single typed value for a well known key.
+    struct SlotValue {
+        SlotValue():mType( EMPTY ), mDouble( 0 ) {}
+
+        //! The type of value currently stored or EMPTY if not set.
+        SlotType mType;
+
+        union {
+            bool mBoolean;
+            int mInteger;
+            double mDouble;
+        };
+    };
+
+    static const std::vector<const objects::Atom*>& getSchema();
+
+    static bool getSlotValue( const SlotValue& aSlot, bool& aValue );
+    static bool getSlotValue( const SlotValue& aSlot, int& aValue );
+    static bool getSlotValue( const SlotValue& aSlot, double& aValue );
+    static bool getSlotValue( const SlotValue& aSlot, std::string& aValue );
+
+    static bool setSlotValue( SlotValue& aSlot, const bool aValue );
+    static bool setSlotValue( SlotValue& aSlot, const int aValue );
+    static bool setSlotValue( SlotValue& aSlot, const double aValue );
+    static bool setSlotValue( SlotValue& aSlot, const std::string& aValue );
+
     template<class T> bool setItemValueLocal( const std::string& aStringKey,
+                                              const int aSlot,
                                               const T& aValue );
 
-    template<class T> T getItemValueLocal( const std::string& aStringKey, bool& aExists ) const;
+    template<class T> T getItemValueLocal( const std::string& aStringKey,
+                                           const int aSlot,
+                                           bool& aExists ) const;
+
+    bool hasValueLocal( const std::string& aStringKey, const int aSlot ) const;
 
     void printItemNotFoundWarning( const std::string& aStringKey ) const;
 
@@ -128,7 +186,12 @@ private:
     //! Type of the internal storage map.
     typedef std::map<const std::string, boost::any> InfoMap;
 
-    //! Internal storage mapping item names to item values.
+    //! Values for keys in the schema indexed by slot.  This is only sized as
+    //! large as the largest slot which has been set.
+    std::vector<SlotValue> mSlotValues;
+
+    //! Internal storage mapping item names to item values for keys which are not
+    //! in the schema or hold strings.
     InfoMap mInfoMap;
 #if GCAM_PARALLEL_ENABLED
     // actions that modify mInfoMap MUST obtain a write lock on the info map.
@@ -144,11 +207,14 @@ private:
 * \details This function will check the info map for the associated key, if it
 *          exists it will update the associated value to itemValue, otherwise it
 *          will create a new name value pair.
+*          Values of well known keys are stored directly in their schema slot
+*          unless they are strings.
 * \param aStringKey The string key to use as the key for this information value.
-* \param aType Enum value of the type.
+* \param aSlot The schema slot of the key or -1 if it is not in the schema.
 * \param aValue The value to be associated with this key. 
 */
 template<class T> bool Info::setItemValueLocal( const std::string& aStringKey,
+                                                const int aSlot,
                                                 const T& aValue )
 {
     /*! \pre A valid key was passed. */
@@ -166,7 +232,14 @@ template<class T> bool Info::setItemValueLocal( const std::string& aStringKey,
         tbb::spin_rw_mutex::scoped_lock readlock(mInfoMapMutex,false);
 #endif
         InfoMap::const_iterator curr = mInfoMap.find( aStringKey );
-        if( curr != mInfoMap.end() ){
+        if( aSlot != -1 && aSlot < mSlotValues.size() && mSlotValues[ aSlot ].mType != EMPTY ){
+            // Check that the types match.
+            T existingValue;
+            if( !getSlotValue( mSlotValues[ aSlot ], existingValue ) ){
+                printBadCastWarning( aStringKey, true );
+            }
+        }
+        else if( curr != mInfoMap.end() ){
             // Check that the types match.
             try {
                 boost::any_cast<T>( curr->second );
@@ -186,6 +259,18 @@ template<class T> bool Info::setItemValueLocal( const std::string& aStringKey,
     tbb::spin_rw_mutex::scoped_lock writelock(mInfoMapMutex, true);
 #endif
     // Add the value regardless of whether a warning was printed.
+    if( aSlot != -1 ){
+        if( aSlot >= mSlotValues.size() ){
+            mSlotValues.resize( aSlot + 1 );
+        }
+        if( setSlotValue( mSlotValues[ aSlot ], aValue ) ){
+            // Make sure a previous value of another type does not linger.
+            if( !mInfoMap.empty() ){
+                mInfoMap.erase( aStringKey );
+            }
+            return true;
+        }
+    }
     mInfoMap[ aStringKey ] = boost::any( aValue );
     return true;
 }
@@ -194,7 +279,7 @@ template<class T> bool Info::setItemValueLocal( const std::string& aStringKey,
 *          location.
 * \author Josh Lurz
 * \param aStringKey The string key for which to find the value.
-* \param aMustExist Whether it is an error for the item to be missing.
+* \param aSlot The schema slot of the key or -1 if it is not in the schema.
 * \param aExists Return parameter to update with whether the item existed.
 * \return The value associated with the key if it exists, the default value
 *         otherwise. 
@@ -208,7 +293,8 @@ template<class T> bool Info::setItemValueLocal( const std::string& aStringKey,
 */
 template<class T>
 T Info::getItemValueLocal( const std::string& aStringKey,
-                                 bool& aExists ) const
+                           const int aSlot,
+                           bool& aExists ) const
 {
     /*! \pre A valid key was passed. */
     assert( !aStringKey.empty() );
@@ -217,6 +303,18 @@ T Info::getItemValueLocal( const std::string& aStringKey,
     // read lock for reading the map
     tbb::spin_rw_mutex::scoped_lock readlock(mInfoMapMutex, false);
 #endif
+    // Check the schema slot first which requires no search.
+    if( aSlot != -1 && aSlot < mSlotValues.size() && mSlotValues[ aSlot ].mType != EMPTY ){
+        T value;
+        if( getSlotValue( mSlotValues[ aSlot ], value ) ){
+            aExists = true;
+            return value;
+        }
+        printBadCastWarning( aStringKey, false );
+        aExists = false;
+        return T();
+    }
+
     // Check for the value.
     InfoMap::const_iterator curr = mInfoMap.find( aStringKey );
     if( curr != mInfoMap.end() ){
@@ -98,6 +98,8 @@ public:
 
     const std::vector<IActivity*> getOrdering( const int aMarketNumber = -1 ) const;
 
+    std::vector<int> getAffectedMarkets( const int aMarketNumber ) const;
+
 #if GCAM_PARALLEL_ENABLED
     GcamFlowGraph* getFlowGraph( const int aMarketNumber = -1 );
 #endif
@@ -316,10 +318,14 @@ public:
         std::set<CalcVertex*> mImpliedVertices;
 
         //! A complete list of vertices to re-calculate should this market change
-        //! it's price.  Note that this is essentially a cache and only computed
-        //! the first time it is needed.
+        //! it's price.  These are computed for all markets at once at the end of
+        //! createOrdering.
         std::vector<IActivity*> mCalcList;
 
+        //! The sorted numbers of the markets linked to any of the activities
+        //! in mCalcList.  This gives the market to market sparsity pattern.
+        std::vector<int> mAffectedMarkets;
+
 #if GCAM_PARALLEL_ENABLED
         //! A flow graph of vertices to re-calculate in parallel should this market
         //! change it's price.  Note that this is essentially a cache and only computed
@@ -361,11 +367,11 @@ public:
     GcamFlowGraph* mTBBGraphGlobal;
 #endif
     
-    void findVerticesToCalculate( CalcVertex* aVertex, std::set<IActivity*>& aVisited ) const;
     void findStronglyConnected( CalcVertex* aCurrVertex, int& aMaxIndex,std::list<CalcVertex*>& aHasVisited,
                                 CalcVertexCountMap& aTotalVisits ) const;
     int markCycles( CalcVertex* aCurrVertex, std::list<CalcVertex*>& aHasVisited, CalcVertexCountMap& aTotalVisits ) const;
     void createTrialsForItem( CItemIterator aItemToReset, CalcVertexCountMap& aNumDependencies );
+    void createMarketOrderings();
 };
 
 #endif // _MARKET_DEPENDENCY_FINDER_H_
@@ -66,6 +66,7 @@ class AResource;
 class IInfo;
 class Tabs;
 class NationalAccountContainer;
+class ObjectArena;
 
 // Need to forward declare the subclasses as well.
 class RegionMiniCAM;
@@ -93,6 +94,7 @@ public:
     virtual void postCalc( const int aPeriod );
 
     void setTax( const GHGPolicy* aTax );
+    void hashPeriodInputs( const int aPeriod, std::size_t& aSeed ) const;
     const Curve* getEmissionsQuantityCurve( const std::string& ghgName ) const;
     const Curve* getEmissionsPriceCurve( const std::string& ghgName ) const;
     
@@ -101,6 +103,8 @@ public:
     virtual bool isAllCalibrated( const int period, double calAccuracy, const bool printWarnings ) const { return true; };
 
     virtual void accept( IVisitor* aVisitor, const int aPeriod ) const;
+
+    ObjectArena* getObjectArena() const;
 protected:
     
     DEFINE_DATA(
@@ -131,6 +135,12 @@ protected:
     virtual const std::string& getXMLName() const = 0;
     virtual void toDebugXMLDerived( const int period, std::ostream& out, Tabs* tabs ) const = 0;
 private:
+    //! The arena the technologies, inputs, outputs, and GHGs of this region are
+    //! allocated from when parsing and initializing, or null if the
+    //! region-arena-allocation flag is not set.  It is destroyed after all of
+    //! the objects in the region have been deleted.
+    std::unique_ptr<ObjectArena> mObjectArena;
+
     void clear();
 };
 
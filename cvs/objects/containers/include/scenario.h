@@ -48,8 +48,10 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <functional>
 #include <boost/shared_ptr.hpp>
 
+#include "util/base/include/definitions.h"
 #include "util/base/include/aparsable.h"
 #include "util/base/include/ivisitable.h"
 #include "util/base/include/data_definition_util.h"
@@ -68,6 +70,7 @@ class OutputMetaData;
 class SolutionInfoParamParser;
 class IModelFeedbackCalc;
 class ManageStateVariables;
+class PeriodResultsOutputter;
 
 /*!
 * \ingroup Objects
@@ -90,6 +93,7 @@ class Scenario: public AParsable, public IVisitable
 {
     friend class LogEDFun;
     friend class gcam;
+    friend class GCAMBench;
 public:
     Scenario();
     ~Scenario();
@@ -161,6 +165,15 @@ protected:
     
     ManageStateVariables* mManageStateVars;
 
+    //! Writes the results of each period as soon as it has been calculated
+    //! when requested, null otherwise.
+    PeriodResultsOutputter* mPeriodResultsOutputter;
+
+    //! A hash of the inputs, including those of all preceding periods, with
+    //! which each period was last successfully calculated or zero if it was
+    //! not.  Used to skip recalculating periods whose inputs have not changed.
+    std::vector<std::size_t> mPeriodInputHashes;
+
     bool solve( const int period );
 
     bool calculatePeriod( const int aPeriod,
@@ -168,8 +181,13 @@ protected:
         Tabs* aTabs,
         const bool aPrintDebugging );
 
+#if GCAM_PARALLEL_ENABLED
+    bool checkParallelCalc( const int aPeriod );
+#endif
+
     void printGraphs( const int aPeriod ) const;
     void printLandAllocatorGraph( const int aPeriod, const bool aPrintValues ) const;
+    void forEachDebugRegion( const std::function<void( const std::string& )>& aWriteRegion ) const;
  
     void logRunBeginning() const;
     void logPeriodBeginning( const int aPeriod ) const;
@@ -181,6 +199,10 @@ protected:
         const int aPeriod ) const;
 
     void initSolvers();
+
+    std::size_t calcPeriodInputHash( const int aPeriod ) const;
+
+    bool canReusePeriod( const int aPeriod ) const;
 };
 
 #endif // _SCENARIO_H_
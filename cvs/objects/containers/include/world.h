@@ -49,6 +49,7 @@
 #include <vector>
 #include <list>
 #include <memory>
+#include <functional>
 #include <boost/core/noncopyable.hpp>
 
 #include "util/base/include/definitions.h"
@@ -68,6 +69,7 @@ class Tabs;
 
 #if GCAM_PARALLEL_ENABLED
 class GcamFlowGraph;
+class NumaRegionScheduler;
 #endif
 
 /*! 
@@ -96,12 +98,13 @@ public:
 
     void calc( const int period );
     void calc( const int period, const std::vector<IActivity*>& aRegionsToCalc );
-    void setEmissions( int period );
+    void setEmissions( const int aStartPeriod, const int aEndPeriod );
     void runClimateModel();
     void runClimateModel( int period );
     const std::map<std::string,int> getOutputRegionMap() const;
     bool isAllCalibrated( const int period, double calAccuracy, const bool printWarnings ) const;
     void setTax( const GHGPolicy* aTax );
+    void hashPeriodInputs( const int aPeriod, std::size_t& aSeed ) const;
     const IClimateModel* getClimateModel() const;
     std::map<std::string, const Curve*> getEmissionsQuantityCurves( const std::string& ghgName ) const;
     std::map<std::string, const Curve*> getEmissionsPriceCurves( const std::string& ghgName ) const;
@@ -118,6 +121,14 @@ public:
   protected:
     //! TBB flow graph for a complete model evaluation
     GcamFlowGraph* mTBBGraphGlobal;
+
+    //! Assigns regions to NUMA nodes when numa-region-scheduling is enabled,
+    //! null otherwise.
+    NumaRegionScheduler* mRegionScheduler;
+
+    //! Whether the regions should be initialized and post calculated in parallel
+    //! as set by the parallel-region-init configuration flag.
+    bool mIsParallelRegionInit;
   public:
     void calc( const int aPeriod, GcamFlowGraph *aWorkGraph, const std::vector<IActivity*>* aCalcList = 0 );
     /*!
@@ -160,6 +171,8 @@ protected:
     std::vector<IActivity*> mGlobalOrdering;
 
     void clear();
+
+    void forEachRegion( const std::function<void( Region* )>& aRegionFunction );
 };
 
 #endif // _WORLD_H_
@@ -0,0 +1,423 @@
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+
+/*! 
+ * \file gcam_session.cpp
+ * \ingroup Objects
+ * \brief GCAMSession class source file.
+ */
+
+#include "util/base/include/definitions.h"
+#include <list>
+
+#include "containers/include/gcam_session.h"
+#include "containers/include/scenario.h"
+#include "policy/include/policy_ghg.h"
+#include "util/base/include/configuration.h"
+#include "util/base/include/model_time.h"
+#include "util/base/include/xml_parse_helper.h"
+#include "util/base/include/gcam_fusion.hpp"
+#include "util/base/include/gcam_data_containers.h"
+#include "util/logger/include/ilogger.h"
+#include "util/logger/include/logger_factory.h"
+
+using namespace std;
+
+extern Scenario* scenario;
+
+namespace {
+    /*!
+     * \brief Collects the numeric values found by a GCAMFusion search.
+     * \details Single values are collected as is and arrays such as PeriodVectors
+     *          are collected element by element in period order.  Data which
+     *          can not be represented as a number, such as strings, is ignored.
+     */
+    class QueryCollector {
+    public:
+        //! The values found so far.
+        vector<double> mValues;
+
+        template<typename DataType>
+        void processData( DataType& aData );
+    };
+
+    template<typename DataType>
+    void QueryCollector::processData( DataType& aData ) {
+        // ignore non-numeric types
+    }
+
+    template<>
+    void QueryCollector::processData<Value>( Value& aData ) {
+        mValues.push_back( aData );
+    }
+
+    template<>
+    void QueryCollector::processData<double>( double& aData ) {
+        mValues.push_back( aData );
+    }
+
+    template<>
+    void QueryCollector::processData<int>( int& aData ) {
+        mValues.push_back( aData );
+    }
+
+    template<>
+    void QueryCollector::processData<bool>( bool& aData ) {
+        mValues.push_back( aData ? 1.0 : 0.0 );
+    }
+
+    template<>
+    void QueryCollector::processData<objects::PeriodVector<Value> >( objects::PeriodVector<Value>& aData ) {
+        for( auto iter = aData.begin(); iter != aData.end(); ++iter ) {
+            mValues.push_back( *iter );
+        }
+    }
+
+    template<>
+    void QueryCollector::processData<objects::PeriodVector<double> >( objects::PeriodVector<double>& aData ) {
+        mValues.insert( mValues.end(), aData.begin(), aData.end() );
+    }
+
+    template<>
+    void QueryCollector::processData<objects::TechVintageVector<Value> >( objects::TechVintageVector<Value>& aData ) {
+        for( auto iter = aData.begin(); iter != aData.end(); ++iter ) {
+            mValues.push_back( *iter );
+        }
+    }
+
+    template<>
+    void QueryCollector::processData<objects::YearVector<double> >( objects::YearVector<double>& aData ) {
+        mValues.insert( mValues.end(), aData.begin(), aData.end() );
+    }
+}
+
+//! Constructor
+GCAMSession::GCAMSession():
+mIsInitialized( false ),
+mNeedsRebuild( true )
+{
+}
+
+//! Destructor
+GCAMSession::~GCAMSession() {
+    if( scenario == mScenario.get() ) {
+        scenario = 0;
+    }
+}
+
+/*!
+ * \brief Read the logger and model configuration and set up the scenario.
+ * \details This must be called once before any other method.  The base input
+ *          file and scenario components listed in the configuration are parsed
+ *          and the scenario is initialized but not run.
+ * \param aConfigurationFile The model configuration file.
+ * \param aLoggerFactoryFile The logger configuration file.
+ * \return Whether the session was successfully initialized.
+ */
+bool GCAMSession::initialize( const string& aConfigurationFile,
+                              const string& aLoggerFactoryFile )
+{
+    if( mIsInitialized ) {
+        ILogger& mainLog = ILogger::getLogger( "main_log" );
+        mainLog.setLevel( ILogger::WARNING );
+        mainLog << "GCAMSession has already been initialized." << endl;
+        return false;
+    }
+
+    XMLParseHelper::initParser();
+    LoggerFactoryWrapper loggerFactoryWrapper;
+    bool success = XMLParseHelper::parseXML( aLoggerFactoryFile, &loggerFactoryWrapper )
+        && XMLParseHelper::parseXML( aConfigurationFile, Configuration::getInstance() );
+    XMLParseHelper::cleanupParser();
+    if( !success ) {
+        return false;
+    }
+
+    mIsInitialized = true;
+    return ensureScenario();
+}
+
+/*!
+ * \brief Apply add-on XML given as a string to the scenario.
+ * \details The XML must have a scenario root node, as with any add-on file.
+ *          The scenario will be rebuilt before it is next used.
+ * \param aXMLContent The add-on XML.
+ * \return Whether the XML was successfully applied.
+ */
+bool GCAMSession::applyXMLString( const string& aXMLContent ) {
+    JournalEntry entry;
+    entry.mType = JournalEntry::XML_STRING;
+    entry.mContent = aXMLContent;
+    mJournal.push_back( entry );
+    mNeedsRebuild = true;
+    return ensureScenario();
+}
+
+/*!
+ * \brief Apply an add-on XML file to the scenario.
+ * \details The scenario will be rebuilt before it is next used.
+ * \param aXMLFile The add-on XML file name.
+ * \return Whether the file was successfully applied.
+ */
+bool GCAMSession::applyXMLFile( const string& aXMLFile ) {
+    JournalEntry entry;
+    entry.mType = JournalEntry::XML_FILE;
+    entry.mContent = aXMLFile;
+    mJournal.push_back( entry );
+    mNeedsRebuild = true;
+    return ensureScenario();
+}
+
+/*!
+ * \brief Set a fixed tax by period for a GHG policy.
+ * \details This replaces any policy with the same name in the regions contained
+ *          in the market.  Periods which should not have a tax should be set to
+ *          Marketplace::NO_MARKET_PRICE.  Periods which were already run are not
+ *          invalidated, callers should run from the first period which changed.
+ * \param aPolicyName The name of the policy which is also the name of the gas
+ *        which is taxed.
+ * \param aMarket The market region of the policy.
+ * \param aTaxes The tax in each model period.
+ * \return Whether the policy was successfully set.
+ */
+bool GCAMSession::setPolicyValues( const string& aPolicyName,
+                                   const string& aMarket,
+                                   const vector<double>& aTaxes )
+{
+    if( !ensureScenario() ) {
+        return false;
+    }
+
+    const int maxPeriod = mScenario->getModeltime()->getmaxper();
+    if( aTaxes.size() != static_cast<unsigned int>( maxPeriod ) ) {
+        ILogger& mainLog = ILogger::getLogger( "main_log" );
+        mainLog.setLevel( ILogger::ERROR );
+        mainLog << "Expected " << maxPeriod << " taxes for policy " << aPolicyName
+                << " but " << aTaxes.size() << " were given." << endl;
+        return false;
+    }
+
+    JournalEntry entry;
+    entry.mType = JournalEntry::POLICY;
+    entry.mContent = aPolicyName;
+    entry.mMarket = aMarket;
+    entry.mTaxes = aTaxes;
+    mJournal.push_back( entry );
+    applyPolicy( entry );
+    return true;
+}
+
+/*!
+ * \brief Run the scenario.
+ * \details All periods from aFromPeriod onward are invalidated first so that
+ *          they will be recalculated.  Periods before aFromPeriod which have not
+ *          yet been calculated, for instance because the scenario was rebuilt,
+ *          will be calculated as well.
+ * \param aFromPeriod The first period to recalculate.
+ * \param aToPeriod The last period to calculate.
+ * \return Whether all calculated periods solved.
+ */
+bool GCAMSession::run( const int aFromPeriod, const int aToPeriod ) {
+    if( !ensureScenario() ) {
+        return false;
+    }
+
+    const int maxPeriod = mScenario->getModeltime()->getmaxper();
+    if( aFromPeriod < 0 || aFromPeriod > aToPeriod || aToPeriod >= maxPeriod ) {
+        ILogger& mainLog = ILogger::getLogger( "main_log" );
+        mainLog.setLevel( ILogger::ERROR );
+        mainLog << "Invalid periods " << aFromPeriod << " to " << aToPeriod
+                << " requested to run." << endl;
+        return false;
+    }
+
+    for( int period = aFromPeriod; period < maxPeriod; ++period ) {
+        mScenario->invalidatePeriod( period );
+    }
+    return mScenario->run( aToPeriod, false, mScenario->getName() );
+}
+
+/*!
+ * \brief Search the scenario for data.
+ * \details The query uses the same syntax as other GCAMFusion searches and starts
+ *          from the scenario, for instance "world/region/sector/price".  Numeric
+ *          values are returned in the order they were found with arrays expanded
+ *          in period order.
+ * \param aQueryPath The GCAMFusion search string.
+ * \return The values found.
+ */
+vector<double> GCAMSession::query( const string& aQueryPath ) {
+    QueryCollector collector;
+    if( !ensureScenario() ) {
+        return collector.mValues;
+    }
+
+    vector<FilterStep*> steps = parseFilterString( aQueryPath );
+    GCAMFusion<QueryCollector> search( collector, steps );
+    search.startFilter( mScenario.get() );
+    for( FilterStep* step : steps ) {
+        delete step;
+    }
+    return collector.mValues;
+}
+
+/*!
+ * \brief Save a marker of the changes made to the session so far.
+ * \return An ID which may be passed to resetState.
+ */
+int GCAMSession::saveState() {
+    mSavedStates.push_back( mJournal.size() );
+    return mSavedStates.size() - 1;
+}
+
+/*!
+ * \brief Undo all changes made since a state was saved.
+ * \details The scenario is rebuilt with only the changes made before the state
+ *          was saved and so must be run again before results are available.
+ *          States saved after aStateID remain valid only if no further changes
+ *          are made.
+ * \param aStateID An ID returned by saveState.
+ * \return Whether the session was reset.
+ */
+bool GCAMSession::resetState( const int aStateID ) {
+    if( aStateID < 0 || aStateID >= static_cast<int>( mSavedStates.size() ) ) {
+        ILogger& mainLog = ILogger::getLogger( "main_log" );
+        mainLog.setLevel( ILogger::ERROR );
+        mainLog << "Unknown saved state " << aStateID << "." << endl;
+        return false;
+    }
+
+    mJournal.resize( mSavedStates[ aStateID ] );
+    mNeedsRebuild = true;
+    return ensureScenario();
+}
+
+/*!
+ * \brief Get the scenario managed by this session.
+ * \details The scenario is rebuilt first if necessary.
+ * \return The scenario or null if it could not be set up.
+ */
+Scenario* GCAMSession::getScenario() {
+    return ensureScenario() ? mScenario.get() : 0;
+}
+
+/*!
+ * \brief Rebuild the scenario if any change requires it.
+ * \return Whether the scenario is ready to be used.
+ */
+bool GCAMSession::ensureScenario() {
+    if( !mIsInitialized ) {
+        ILogger& mainLog = ILogger::getLogger( "main_log" );
+        mainLog.setLevel( ILogger::ERROR );
+        mainLog << "GCAMSession must be initialized before it is used." << endl;
+        return false;
+    }
+    if( mNeedsRebuild ) {
+        mNeedsRebuild = !rebuildScenario();
+    }
+    return !mNeedsRebuild;
+}
+
+/*!
+ * \brief Create a new scenario from the configured inputs and the journal.
+ * \details Inputs are read in the same order as SingleScenarioRunner reads them
+ *          followed by any add-on XML in the journal.  Once the scenario is
+ *          initialized the policies in the journal are applied.
+ * \return Whether the scenario was successfully set up.
+ */
+bool GCAMSession::rebuildScenario() {
+    const Configuration* conf = Configuration::getInstance();
+    ILogger& mainLog = ILogger::getLogger( "main_log" );
+
+    if( scenario == mScenario.get() ) {
+        scenario = 0;
+    }
+    mScenario.reset( new Scenario );
+    scenario = mScenario.get();
+
+    XMLParseHelper::initParser();
+    bool success = XMLParseHelper::parseXML( conf->getFile( "xmlInputFileName" ),
+                                             mScenario.get() );
+
+    list<string> scenComponents = conf->getScenarioComponents();
+    for( list<string>::const_iterator currComp = scenComponents.begin();
+         success && currComp != scenComponents.end(); ++currComp )
+    {
+        mainLog.setLevel( ILogger::NOTICE );
+        mainLog << "Parsing " << *currComp << " scenario component." << endl;
+        success = XMLParseHelper::parseXML( *currComp, mScenario.get() );
+    }
+
+    for( vector<JournalEntry>::const_iterator entry = mJournal.begin();
+         success && entry != mJournal.end(); ++entry )
+    {
+        if( entry->mType == JournalEntry::XML_FILE ) {
+            mainLog.setLevel( ILogger::NOTICE );
+            mainLog << "Parsing " << entry->mContent << " session add-on." << endl;
+            success = XMLParseHelper::parseXML( entry->mContent, mScenario.get() );
+        }
+        else if( entry->mType == JournalEntry::XML_STRING ) {
+            success = XMLParseHelper::parseXMLString( entry->mContent, mScenario.get() );
+        }
+    }
+    if( !success ) {
+        XMLParseHelper::cleanupParser();
+        return false;
+    }
+
+    const string overrideName = conf->getString( "scenarioName" );
+    if( !overrideName.empty() ) {
+        mScenario->setName( overrideName );
+    }
+
+    mScenario->completeInit();
+    XMLParseHelper::cleanupParser();
+
+    for( vector<JournalEntry>::const_iterator entry = mJournal.begin();
+         entry != mJournal.end(); ++entry )
+    {
+        if( entry->mType == JournalEntry::POLICY ) {
+            applyPolicy( *entry );
+        }
+    }
+    return true;
+}
+
+/*!
+ * \brief Set the tax described by a POLICY journal entry into the scenario.
+ * \param aEntry The journal entry.
+ */
+void GCAMSession::applyPolicy( const JournalEntry& aEntry ) {
+    GHGPolicy tax( aEntry.mContent, aEntry.mMarket, aEntry.mTaxes );
+    mScenario->setTax( &tax );
+}
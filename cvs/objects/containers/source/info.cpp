@@ -43,9 +43,47 @@
 #include "containers/include/info.h"
 #include "util/logger/include/ilogger.h"
 #include "util/base/include/xml_helper.h"
+#include "util/base/include/atom_registry.h"
+#include <boost/unordered_map.hpp>
 
 using namespace std;
 
+namespace {
+    /*!
+     * \brief The well known keys which make up the Info schema.
+     * \details These are the keys which are accessed while calculating the model
+     *          and will be stored in a fixed slot rather than searched for by
+     *          name.  The order determines the slot index so the most commonly
+     *          set keys come first to keep the slot arrays short.
+     */
+    const char* SCHEMA_KEYS[] = {
+        "lower-bound-supply-price",
+        "upper-bound-supply-price",
+        "correction-slope",
+        "price-adjust",
+        "demand-adjust",
+        "new-vintage-tech",
+        "is-final-energy",
+        "fully-calibrated",
+        "base-price",
+        "CO2coefficient",
+        "CO2Coef",
+        "AccumulatedRsc",
+        "export-nominal",
+        "export-real"
+    };
+}
+
+/*!
+ * \brief Constructor which resolves the key against the Info schema.
+ * \param aName The name of the key.
+ */
+InfoKey::InfoKey( const string& aName ):
+mName( aName ),
+mSlot( Info::getSchemaSlot( aName ) )
+{
+}
+
 /*! \brief Constructor
 * \details Constructs the Info object by allocating a hashmap to store the
 *          information objects, and initializes a link to the conceptual parent
@@ -70,27 +108,109 @@ mParentInfo( aParentInfo )
 Info::~Info(){
 }
 
+/*!
+ * \brief Get the well known keys which make up the schema indexed by slot.
+ * \details The keys are interned as Atoms the first time the schema is needed.
+ * \return The schema keys by slot.
+ */
+const vector<const objects::Atom*>& Info::getSchema() {
+    static const vector<const objects::Atom*> schema = [] {
+        vector<const objects::Atom*> keys;
+        for( const char* key : SCHEMA_KEYS ) {
+            const objects::Atom* atom = objects::AtomRegistry::getInstance()->findAtom( key );
+            keys.push_back( atom ? atom : new objects::Atom( key ) );
+        }
+        return keys;
+    }();
+    return schema;
+}
+
+/*!
+ * \brief Get the schema slot for a key.
+ * \details Callers which look up the same key repeatedly should hold an InfoKey
+ *          instead which resolves the slot only once.
+ * \param aStringKey The key to resolve.
+ * \return The slot index for the key or -1 if it is not a well known key.
+ */
+int Info::getSchemaSlot( const string& aStringKey ) {
+    typedef boost::unordered_map<string, int> SlotMap;
+    static const SlotMap slotMap = [] {
+        SlotMap slots;
+        const vector<const objects::Atom*>& schema = getSchema();
+        for( int slot = 0; slot < schema.size(); ++slot ) {
+            slots[ schema[ slot ]->getID() ] = slot;
+        }
+        return slots;
+    }();
+    SlotMap::const_iterator iter = slotMap.find( aStringKey );
+    return iter != slotMap.end() ? iter->second : -1;
+}
+
+bool Info::getSlotValue( const SlotValue& aSlot, bool& aValue ) {
+    aValue = aSlot.mBoolean;
+    return aSlot.mType == BOOLEAN;
+}
+
+bool Info::getSlotValue( const SlotValue& aSlot, int& aValue ) {
+    aValue = aSlot.mInteger;
+    return aSlot.mType == INTEGER;
+}
+
+bool Info::getSlotValue( const SlotValue& aSlot, double& aValue ) {
+    aValue = aSlot.mDouble;
+    return aSlot.mType == DOUBLE;
+}
+
+bool Info::getSlotValue( const SlotValue& aSlot, string& aValue ) {
+    // Strings are never stored in slots.
+    return false;
+}
+
+bool Info::setSlotValue( SlotValue& aSlot, const bool aValue ) {
+    aSlot.mType = BOOLEAN;
+    aSlot.mBoolean = aValue;
+    return true;
+}
+
+bool Info::setSlotValue( SlotValue& aSlot, const int aValue ) {
+    aSlot.mType = INTEGER;
+    aSlot.mInteger = aValue;
+    return true;
+}
+
+bool Info::setSlotValue( SlotValue& aSlot, const double aValue ) {
+    aSlot.mType = DOUBLE;
+    aSlot.mDouble = aValue;
+    return true;
+}
+
+bool Info::setSlotValue( SlotValue& aSlot, const string& aValue ) {
+    // Strings are stored in the map so clear any previous value of another type.
+    aSlot.mType = EMPTY;
+    return false;
+}
+
 bool Info::setBoolean( const string& aStringKey, const bool aValue ){
-    return setItemValueLocal( aStringKey, aValue );
+    return setItemValueLocal( aStringKey, getSchemaSlot( aStringKey ), aValue );
 }
 
 bool Info::setInteger( const string& aStringKey, const int aValue ){
-    return setItemValueLocal( aStringKey, aValue );
+    return setItemValueLocal( aStringKey, getSchemaSlot( aStringKey ), aValue );
 }
 
 bool Info::setDouble( const string& aStringKey, const double aValue ){
-    return setItemValueLocal( aStringKey, aValue );
+    return setItemValueLocal( aStringKey, getSchemaSlot( aStringKey ), aValue );
 }
 
 bool Info::setString( const string& aStringKey, const string& aValue ){
-    return setItemValueLocal( aStringKey, aValue );
+    return setItemValueLocal( aStringKey, getSchemaSlot( aStringKey ), aValue );
 }
     
 bool Info::getBoolean( const string& aStringKey, const bool aMustExist ) const
 {
     // Perform a local search.
     bool found = false;
-    bool value = getItemValueLocal<bool>( aStringKey, found );
+    bool value = getItemValueLocal<bool>( aStringKey, getSchemaSlot( aStringKey ), found );
     
     // If the item wasn't found search the parent info.
     if( !found ){
@@ -109,7 +229,7 @@ int Info::getInteger( const string& aStringKey, const bool aMustExist ) const
 {
     // Perform a local search.
     bool found = false;
-    int value = getItemValueLocal<int>( aStringKey, found );
+    int value = getItemValueLocal<int>( aStringKey, getSchemaSlot( aStringKey ), found );
     
     // If the item wasn't found search the parent info.
     if( !found ){
@@ -128,7 +248,7 @@ double Info::getDouble( const string& aStringKey, const bool aMustExist ) const
 {
     // Perform a local search.
     bool found = false;
-    double value = getItemValueLocal<double>( aStringKey, found );
+    double value = getItemValueLocal<double>( aStringKey, getSchemaSlot( aStringKey ), found );
 
     // If the item wasn't found search the parent info.
     if( !found ){
@@ -147,7 +267,7 @@ const string Info::getString( const string& aStringKey, const bool aMustExist )
 {
     // Perform a local search.
     bool found = false;
-    const string value = getItemValueLocal<string>( aStringKey, found );
+    const string value = getItemValueLocal<string>( aStringKey, getSchemaSlot( aStringKey ), found );
     if( !found ){
         // If the item wasn't found search the parent info.
         if( mParentInfo ){
@@ -166,7 +286,7 @@ const string Info::getString( const string& aStringKey, const bool aMustExist )
 bool Info::getBooleanHelper( const string& aStringKey, bool& aFound ) const
 {
     // Perform a local search.
-    bool value = getItemValueLocal<bool>( aStringKey, aFound );
+    bool value = getItemValueLocal<bool>( aStringKey, getSchemaSlot( aStringKey ), aFound );
     
     // If the item wasn't found and parent exists, search the parent info.
     if( !aFound && mParentInfo ){
@@ -178,7 +298,7 @@ bool Info::getBooleanHelper( const string& aStringKey, bool& aFound ) const
 int Info::getIntegerHelper( const string& aStringKey, bool& aFound ) const
 {
     // Perform a local search.
-    int value = getItemValueLocal<int>( aStringKey, aFound );
+    int value = getItemValueLocal<int>( aStringKey, getSchemaSlot( aStringKey ), aFound );
     
     // If the item wasn't found and parent exists, search the parent info.
     if( !aFound && mParentInfo ){
@@ -190,7 +310,7 @@ int Info::getIntegerHelper( const string& aStringKey, bool& aFound ) const
 double Info::getDoubleHelper( const string& aStringKey, bool& aFound ) const
 {
     // Perform a local search.
-    double value = getItemValueLocal<double>( aStringKey, aFound );
+    double value = getItemValueLocal<double>( aStringKey, getSchemaSlot( aStringKey ), aFound );
     
     // If the item wasn't found and parent exists, search the parent info.
     if( !aFound && mParentInfo ){
@@ -202,7 +322,7 @@ double Info::getDoubleHelper( const string& aStringKey, bool& aFound ) const
 const string Info::getStringHelper( const string& aStringKey, bool& aFound ) const
 {
     // Perform a local search.
-    const string value = getItemValueLocal<string>( aStringKey, aFound );
+    const string value = getItemValueLocal<string>( aStringKey, getSchemaSlot( aStringKey ), aFound );
     
     // If the item wasn't found and parent exists, search the parent info.
     if( !aFound && mParentInfo ){
@@ -212,18 +332,9 @@ const string Info::getStringHelper( const string& aStringKey, bool& aFound ) con
 }
 
 bool Info::hasValue( const string& aStringKey ) const {
-#if GCAM_PARALLEL_ENABLED
-    // get a read lock on the info map
-    tbb::spin_rw_mutex::scoped_lock readlock(mInfoMapMutex,false);
-#endif
     // Check the local store. 
-    bool currHasValue = ( mInfoMap.find( aStringKey ) != mInfoMap.end() );
+    bool currHasValue = hasValueLocal( aStringKey, getSchemaSlot( aStringKey ) );
 
-#if GCAM_PARALLEL_ENABLED
-    // the lock on our local map is no longer needed.  Release before
-    // recursing into parent structures
-    readlock.release();
-#endif
     // If the value was not found, check the parent.
     if( !currHasValue && mParentInfo ){
         currHasValue = mParentInfo->hasValue( aStringKey );
@@ -231,12 +342,151 @@ bool Info::hasValue( const string& aStringKey ) const {
     return currHasValue;
 }
 
+bool Info::getBoolean( const InfoKey& aKey, const bool aMustExist ) const
+{
+    // Perform a local search.
+    bool found = false;
+    bool value = getItemValueLocal<bool>( aKey.getName(), aKey.getSlot(), found );
+    
+    // If the item wasn't found search the parent info.
+    if( !found ){
+        if( mParentInfo ){
+            value = mParentInfo->getBooleanHelper( aKey, found );
+        }
+        // The item must exist and was not found or there was no parent to search.
+        if( aMustExist && !found ){
+            printItemNotFoundWarning( aKey.getName() );
+        }
+    }
+    return value;
+}
+
+int Info::getInteger( const InfoKey& aKey, const bool aMustExist ) const
+{
+    // Perform a local search.
+    bool found = false;
+    int value = getItemValueLocal<int>( aKey.getName(), aKey.getSlot(), found );
+    
+    // If the item wasn't found search the parent info.
+    if( !found ){
+        if( mParentInfo ){
+            value = mParentInfo->getIntegerHelper( aKey, found );
+        }
+        // The item must exist and was not found or there was no parent to search.
+        if( aMustExist && !found ){
+            printItemNotFoundWarning( aKey.getName() );
+        }
+    }
+    return value;
+}
+
+double Info::getDouble( const InfoKey& aKey, const bool aMustExist ) const
+{
+    // Perform a local search.
+    bool found = false;
+    double value = getItemValueLocal<double>( aKey.getName(), aKey.getSlot(), found );
+
+    // If the item wasn't found search the parent info.
+    if( !found ){
+        if( mParentInfo ){
+            value = mParentInfo->getDoubleHelper( aKey, found );
+        }
+        // The item must exist and was not found or there was no parent to search.
+        if( aMustExist && !found ){
+            printItemNotFoundWarning( aKey.getName() );
+        }
+    }
+    return value;
+}
+
+bool Info::getBooleanHelper( const InfoKey& aKey, bool& aFound ) const
+{
+    // Perform a local search.
+    bool value = getItemValueLocal<bool>( aKey.getName(), aKey.getSlot(), aFound );
+    
+    // If the item wasn't found and parent exists, search the parent info.
+    if( !aFound && mParentInfo ){
+        value = mParentInfo->getBooleanHelper( aKey, aFound );
+    }
+    return value;
+}
+
+int Info::getIntegerHelper( const InfoKey& aKey, bool& aFound ) const
+{
+    // Perform a local search.
+    int value = getItemValueLocal<int>( aKey.getName(), aKey.getSlot(), aFound );
+    
+    // If the item wasn't found and parent exists, search the parent info.
+    if( !aFound && mParentInfo ){
+        value = mParentInfo->getIntegerHelper( aKey, aFound );
+    }
+    return value;
+}
+
+double Info::getDoubleHelper( const InfoKey& aKey, bool& aFound ) const
+{
+    // Perform a local search.
+    double value = getItemValueLocal<double>( aKey.getName(), aKey.getSlot(), aFound );
+    
+    // If the item wasn't found and parent exists, search the parent info.
+    if( !aFound && mParentInfo ){
+        value = mParentInfo->getDoubleHelper( aKey, aFound );
+    }
+    return value;
+}
+
+bool Info::hasValue( const InfoKey& aKey ) const {
+    // Check the local store. 
+    bool currHasValue = hasValueLocal( aKey.getName(), aKey.getSlot() );
+
+    // If the value was not found, check the parent.
+    if( !currHasValue && mParentInfo ){
+        currHasValue = mParentInfo->hasValue( aKey );
+    }
+    return currHasValue;
+}
+
+/*!
+ * \brief Check if a value exists in the local store without searching the parent.
+ * \param aStringKey The key for which to search.
+ * \param aSlot The schema slot of the key or -1 if it is not in the schema.
+ * \return Whether the key exists locally.
+ */
+bool Info::hasValueLocal( const string& aStringKey, const int aSlot ) const {
+#if GCAM_PARALLEL_ENABLED
+    // get a read lock on the info map
+    tbb::spin_rw_mutex::scoped_lock readlock(mInfoMapMutex,false);
+#endif
+    if( aSlot != -1 && aSlot < mSlotValues.size() && mSlotValues[ aSlot ].mType != EMPTY ){
+        return true;
+    }
+    return mInfoMap.find( aStringKey ) != mInfoMap.end();
+}
+
 void Info::toDebugXML( const int aperiod, Tabs* aTabs, ostream& aOut ) const {
 #if GCAM_PARALLEL_ENABLED
     // get read lock for the info map
     tbb::spin_rw_mutex::scoped_lock readlock(mInfoMapMutex, false);
 #endif
     XMLWriteOpeningTag( "Info", aOut, aTabs );
+    const vector<const objects::Atom*>& schema = getSchema();
+    for( int slot = 0; slot < mSlotValues.size(); ++slot ){
+        if( mSlotValues[ slot ].mType == EMPTY ){
+            continue;
+        }
+        XMLWriteOpeningTag( "Pair", aOut, aTabs );
+        XMLWriteElement( schema[ slot ]->getID(), "Key", aOut, aTabs );
+        if( mSlotValues[ slot ].mType == BOOLEAN ){
+            XMLWriteElement( mSlotValues[ slot ].mBoolean, "Value", aOut, aTabs );
+        }
+        else if( mSlotValues[ slot ].mType == INTEGER ){
+            XMLWriteElement( mSlotValues[ slot ].mInteger, "Value", aOut, aTabs );
+        }
+        else {
+            XMLWriteElement( mSlotValues[ slot ].mDouble, "Value", aOut, aTabs );
+        }
+        XMLWriteClosingTag( "Pair", aOut, aTabs );
+    }
     for( InfoMap::const_iterator item = mInfoMap.begin(); item != mInfoMap.end(); ++item ){
         XMLWriteOpeningTag( "Pair", aOut, aTabs );
         XMLWriteElement( item->first, "Key", aOut, aTabs );
@@ -40,6 +40,8 @@
 
 #include "util/base/include/definitions.h"
 #include <cassert>
+#include <algorithm>
+#include <map>
 #include <boost/algorithm/string/predicate.hpp>
 #include "containers/include/market_dependency_finder.h"
 #include "util/logger/include/ilogger.h"
@@ -49,6 +51,7 @@
 #include "marketplace/include/market.h"
 #include "marketplace/include/linked_market.h"
 #include "containers/include/iactivity.h"
+#include "parallel/include/bitvector.hpp"
 
 #if GCAM_PARALLEL_ENABLED
 #include "parallel/include/gcam_parallel.hpp"
@@ -219,43 +222,29 @@ const vector<IActivity*> MarketDependencyFinder::getOrdering( const int aMarketN
             exit( 1 );
         }
 
-        // First check the MarketToDependencyItem and see if we have this cached.
-        if( !(*mrktIter)->mCalcList.empty() ) {
-            return (*mrktIter)->mCalcList;
-        }
-
-        // We must generate the full list of nodes to calculate.  The createOrdering
-        // method has created a link from markets to "entry points" into the graph.
-        // We must then do a search on the graph from those entry points to come up
-        // with a full set of items which must be recalculated.
-        // To ensure the set of items are in order we can utilize the already created
-        // global ordering.
-        
-        
-        // Do a search from all of the entry points to get a set of unique items
-        // to calculate.
-        set<IActivity*> dependenentCalcs;
-        typedef set<CalcVertex*>::const_iterator CVertexIterator;
-        for( CVertexIterator it = (*mrktIter)->mImpliedVertices.begin(); it != (*mrktIter)->mImpliedVertices.end(); ++it ) {
-            findVerticesToCalculate( *it, dependenentCalcs );
-        }
-        
-        // Loop over the global ordering and move an item from the dependenentCalcs
-        // into the ordered list to return should it exist in dependenentCalcs.
-        vector<IActivity*> orderedListForMarket;
-        for( vector<IActivity*>::const_iterator it = mGlobalOrdering.begin(); it != mGlobalOrdering.end(); ++it ) {
-            set<IActivity*>::iterator dependIter = dependenentCalcs.find( *it );
-            if( dependIter != dependenentCalcs.end() ) {
-                orderedListForMarket.push_back( *dependIter );
-                dependenentCalcs.erase( dependIter );
-            }
-        }
-        // Go ahead and cache this list so we do not need to calculate it again.
-        (*mrktIter)->mCalcList = orderedListForMarket;
-        return orderedListForMarket;
+        // The per market orderings have all been generated already by
+        // createMarketOrderings.
+        return (*mrktIter)->mCalcList;
     }
 }
 
+/*!
+ * \brief Get the markets which would be affected should the given market change
+ *        it's price.
+ * \details A market is considered affected if it is linked to any activity in
+ *          the ordering returned by getOrdering( aMarketNumber ).  Solvers may
+ *          use this as the sparsity pattern of the market to market interactions,
+ *          for instance to skip evaluating derivatives known to be zero.
+ * \param aMarketNumber The market number which would change prices.
+ * \return The sorted market numbers affected, which will be empty if the market
+ *         is not linked to any entry points into the graph.
+ */
+vector<int> MarketDependencyFinder::getAffectedMarkets( const int aMarketNumber ) const {
+    unique_ptr<MarketToDependencyItem> marketToDep( new MarketToDependencyItem( aMarketNumber ) );
+    CMarketToDepIterator mrktIter = mMarketsToDep.find( marketToDep.get() );
+    return mrktIter != mMarketsToDep.end() ? (*mrktIter)->mAffectedMarkets : vector<int>();
+}
+
 #if GCAM_PARALLEL_ENABLED
 /*!
  * \brief Get flow graph which can be used to calculate the model in parallel.
@@ -305,35 +294,6 @@ GcamFlowGraph* MarketDependencyFinder::getFlowGraph( const int aMarketNumber ) {
 }
 #endif
 
-/*!
- * \brief A depth first search collecting a unique set of the vertices visited.
- * \details Recursively search for vertices.  The end points for recursion are if
- *          at vertices which have already been found or that have no out edges.
- * \param aVertex The current vertex being visited.
- * \param aVisited The set of vertices which have already been visited.
- */
-void MarketDependencyFinder::findVerticesToCalculate( CalcVertex* aVertex, std::set<IActivity*>& aVisited ) const {
-    // Attempt to add the current vertex to the list of visited vertices.
-    if( !aVisited.insert( aVertex->mCalcItem ).second ) {
-        // Already processed this subgraph so no need to continue search from
-        // here.
-        return;
-    }
-    
-    // Visit all vertices along the out edges from aVertex.
-    typedef vector<CalcVertex*>::const_iterator CVertexIterator;
-    for( CVertexIterator it = aVertex->mOutEdges.begin(); it != aVertex->mOutEdges.end(); ++it ) {
-        findVerticesToCalculate( *it, aVisited );
-    }
-
-    // Add any implied in edges that should be calculated (special case for the
-    // land-allocator).
-    typedef set<CalcVertex*>::const_iterator CImpVertexIterator;
-    for( CImpVertexIterator it = aVertex->mImpliedInEdges.begin(); it != aVertex->mImpliedInEdges.end(); ++it ) {
-        findVerticesToCalculate( *it, aVisited );
-    }
-}
-
 /*!
  * \brief A comparison functor to distinguish between DependencyItems.  Provides
  *        a way to determine if one DependencyItem is less than another.
@@ -694,6 +654,8 @@ void MarketDependencyFinder::createOrdering() {
     for( vector<IActivity*>::iterator it = mGlobalOrdering.begin(); it != mGlobalOrdering.end(); ++it ) {
         depLog << "- " << (*it)->getDescription() << endl;
     }
+
+    createMarketOrderings();
 }
 
 /*!
@@ -894,3 +856,121 @@ void MarketDependencyFinder::createTrialsForItem( CItemIterator aItemToReset, Ca
     }
 }
 
+
+/*!
+ * \brief Generate the in-order lists of activities to calculate, and the
+ *        affected markets, for all markets at once.
+ * \details Rather than searching the graph from the entry points of each market
+ *          separately we assign every market an index into a bit set and make a
+ *          single sweep over the vertices in global order.  Each vertex starts
+ *          with the markets for which it is an entry point and passes the union
+ *          of the markets that reach it on to all of its out and implied in edges.
+ *          The out edges always point forward in the global ordering however
+ *          implied in edges may point backwards in which case the sweep is
+ *          repeated until no further changes are made.  Once complete the calc
+ *          list for each market is simply every vertex, in order, which has that
+ *          market's bit set.
+ */
+void MarketDependencyFinder::createMarketOrderings() {
+    // Map each activity to it's position in the global ordering and each position
+    // back to the vertex which will do the calculation.
+    map<IActivity*, int> activityIndex;
+    for( int i = 0; i < mGlobalOrdering.size(); ++i ) {
+        activityIndex[ mGlobalOrdering[ i ] ] = i;
+    }
+    vector<CalcVertex*> orderedVertices( mGlobalOrdering.size(), 0 );
+    vector<int> vertexMarket( mGlobalOrdering.size(), -1 );
+    for( CItemIterator it = mDependencyItems.begin(); it != mDependencyItems.end(); ++it ) {
+        for( int isPrice = 0; isPrice < 2; ++isPrice ) {
+            const VertexList& vertices = isPrice ? (*it)->mPriceVertices : (*it)->mDemandVertices;
+            for( CVertexIterator vertexIter = vertices.begin(); vertexIter != vertices.end(); ++vertexIter ) {
+                map<IActivity*, int>::const_iterator indexIter = activityIndex.find( (*vertexIter)->mCalcItem );
+                if( indexIter != activityIndex.end() ) {
+                    orderedVertices[ (*indexIter).second ] = *vertexIter;
+                    vertexMarket[ (*indexIter).second ] = (*it)->mLinkedMarket;
+                }
+            }
+        }
+    }
+
+    // Assign each market a bit index and mark the entry points into the graph.
+    // Note the demand vertex of an item solved via trials is linked to the trial
+    // demand market rather than the price market.
+    vector<MarketToDependencyItem*> markets( mMarketsToDep.begin(), mMarketsToDep.end() );
+    vector<bitvector> reachingMarkets( mGlobalOrdering.size(), bitvector( markets.size() ) );
+    for( int marketIndex = 0; marketIndex < markets.size(); ++marketIndex ) {
+        markets[ marketIndex ]->mCalcList.clear();
+        markets[ marketIndex ]->mAffectedMarkets.clear();
+        const set<CalcVertex*>& impliedVertices = markets[ marketIndex ]->mImpliedVertices;
+        for( set<CalcVertex*>::const_iterator it = impliedVertices.begin(); it != impliedVertices.end(); ++it ) {
+            map<IActivity*, int>::const_iterator indexIter = activityIndex.find( (*it)->mCalcItem );
+            if( indexIter != activityIndex.end() ) {
+                reachingMarkets[ (*indexIter).second ].set( marketIndex );
+                if( (*it)->mDepItem->mIsSolved && *it == (*it)->mDepItem->getFirstDemandVertex() ) {
+                    vertexMarket[ (*indexIter).second ] = markets[ marketIndex ]->mMarket;
+                }
+            }
+        }
+    }
+
+    // Convert the out and implied in edges of each vertex into positions in the
+    // global ordering so that the sweeps below need no further lookups.
+    vector<vector<int> > edgeIndices( orderedVertices.size() );
+    for( int i = 0; i < orderedVertices.size(); ++i ) {
+        if( !orderedVertices[ i ] ) {
+            continue;
+        }
+        VertexList edges( orderedVertices[ i ]->mOutEdges );
+        edges.insert( edges.end(), orderedVertices[ i ]->mImpliedInEdges.begin(), orderedVertices[ i ]->mImpliedInEdges.end() );
+        for( CVertexIterator it = edges.begin(); it != edges.end(); ++it ) {
+            map<IActivity*, int>::const_iterator indexIter = activityIndex.find( (*it)->mCalcItem );
+            if( indexIter != activityIndex.end() && (*indexIter).second != i ) {
+                edgeIndices[ i ].push_back( (*indexIter).second );
+            }
+        }
+    }
+
+    // Propagate the reaching markets along the edges in global order.
+    bool changed = !markets.empty();
+    while( changed ) {
+        changed = false;
+        for( int i = 0; i < edgeIndices.size(); ++i ) {
+            if( reachingMarkets[ i ].empty() ) {
+                continue;
+            }
+            for( vector<int>::const_iterator it = edgeIndices[ i ].begin(); it != edgeIndices[ i ].end(); ++it ) {
+                if( *it < i ) {
+                    // A backwards edge, we will need another sweep if it adds
+                    // any new markets.
+                    const unsigned prevCount = reachingMarkets[ *it ].count();
+                    reachingMarkets[ *it ].setunion( reachingMarkets[ i ] );
+                    changed |= reachingMarkets[ *it ].count() != prevCount;
+                }
+                else {
+                    reachingMarkets[ *it ].setunion( reachingMarkets[ i ] );
+                }
+            }
+        }
+    }
+
+    // Collect the calc lists and affected markets which will naturally be in
+    // global order.
+    for( int i = 0; i < reachingMarkets.size(); ++i ) {
+        if( markets.empty() || reachingMarkets[ i ].empty() ) {
+            continue;
+        }
+        bitvector_iterator marketIter( &reachingMarkets[ i ] );
+        while( marketIter.next() ) {
+            MarketToDependencyItem* market = markets[ marketIter.bindex() ];
+            market->mCalcList.push_back( mGlobalOrdering[ i ] );
+            if( vertexMarket[ i ] != -1 ) {
+                market->mAffectedMarkets.push_back( vertexMarket[ i ] );
+            }
+        }
+    }
+    for( int marketIndex = 0; marketIndex < markets.size(); ++marketIndex ) {
+        vector<int>& affected = markets[ marketIndex ]->mAffectedMarkets;
+        sort( affected.begin(), affected.end() );
+        affected.erase( unique( affected.begin(), affected.end() ), affected.end() );
+    }
+}
@@ -73,6 +73,9 @@
 
 #include "util/logger/include/ilogger.h"
 #include "util/base/include/xml_helper.h"
+#include "util/base/include/configuration.h"
+#include "util/base/include/object_arena.h"
+#include "util/base/include/debug_filter.h"
 
 using namespace std;
 
@@ -89,6 +92,9 @@ typedef std::vector<AResource*>::const_iterator CResourceIterator;
 Region::Region() {
     mDemographic = 0;
     mRegionInfo = 0;
+    if( Configuration::getInstance()->getBool( "region-arena-allocation", false, false ) ) {
+        mObjectArena.reset( new ObjectArena() );
+    }
 }
 
 //! Default destructor destroys sector, demsector, Resource, and
@@ -97,6 +103,17 @@ Region::~Region() {
     clear();
 }
 
+/*!
+ * \brief Get the arena to allocate the objects of this region from.
+ * \details Callers which create the objects of this region, such as when parsing
+ *          or initializing it, should set an ObjectArena::Scope with this arena so
+ *          that the objects are laid out together in memory.
+ * \return The arena for this region or null if arena allocation is not enabled.
+ */
+ObjectArena* Region::getObjectArena() const {
+    return mObjectArena.get();
+}
+
 //! Clear member variables and initialize elemental members.
 void Region::clear(){
     for ( SectorIterator secIter = mSupplySector.begin(); secIter != mSupplySector.end(); secIter++ ) {
@@ -144,12 +161,16 @@ void Region::toDebugXML( const int period, ostream& out, Tabs* tabs ) const {
 
     // write out supply sector objects.
     for( CSectorIterator j = mSupplySector.begin(); j != mSupplySector.end(); j++ ){
-        ( *j )->toDebugXML( period, out, tabs );
+        if( DebugFilter::isDebugSector( ( *j )->getName() ) ){
+            ( *j )->toDebugXML( period, out, tabs );
+        }
     }
     
     // write out the resources objects.
     for( CResourceIterator currResource = mResources.begin(); currResource != mResources.end(); ++currResource ){
-        (*currResource)->toDebugXML( period, out, tabs );
+        if( DebugFilter::isDebugSector( ( *currResource )->getName() ) ){
+            (*currResource)->toDebugXML( period, out, tabs );
+        }
     }
 
     toDebugXMLDerived( period, out, tabs );
@@ -274,6 +295,16 @@ void Region::setTax( const GHGPolicy* aTax ){
     insertedTax->completeInit( mName );
 }
 
+/*! \brief Combine the policy inputs of this region for a period into a hash.
+* \param aPeriod Model period.
+* \param aSeed The hash value to combine the inputs into.
+*/
+void Region::hashPeriodInputs( const int aPeriod, size_t& aSeed ) const {
+    for( unsigned int i = 0; i < mGhgPolicies.size(); i++ ){
+        mGhgPolicies[ i ]->hashPeriodInputs( aPeriod, aSeed );
+    }
+}
+
 /*! \brief A function to generate a ghg emissions quantity curve based on an
 *          already performed model run.
 * \details This function used the information stored in it to create a curve,
@@ -80,6 +80,7 @@
 #include "util/base/include/configuration.h"
 #include "util/base/include/util.h"
 #include "util/logger/include/ilogger.h"
+#include "util/base/include/debug_filter.h"
 
 #include "containers/include/national_account_container_activity.h"
 #include "containers/include/resource_activity.h"
@@ -268,7 +269,9 @@ void RegionMiniCAM::toDebugXMLDerived( const int period, std::ostream& out, Tabs
 
     // write out demand sector objects.
     for( CFinalDemandIterator currSector = mFinalDemands.begin(); currSector != mFinalDemands.end(); ++currSector ){
-        (*currSector)->toDebugXML( period, out, tabs );
+        if( DebugFilter::isDebugSector( ( *currSector )->getName() ) ){
+            (*currSector)->toDebugXML( period, out, tabs );
+        }
     }
 
     // write out consumer objects.
@@ -44,6 +44,7 @@
 #include <cassert>
 #include <ctime>
 #include <iomanip>
+#include <boost/functional/hash.hpp>
 
 #include "containers/include/scenario.h"
 #include "util/base/include/model_time.h"
@@ -66,10 +67,17 @@
 #include "util/base/include/manage_state_variables.hpp"
 #include "util/base/include/supply_demand_curve_saver.h"
 #include "containers/include/calc_base_price.h"
+#include "reporting/include/period_results_outputter.h"
+#include "reporting/include/memory_report.h"
+#include "util/base/include/debug_filter.h"
 
-#if GCAM_PARALLEL_ENABLED && PARALLEL_DEBUG
-#include <stdlib.h>
+#if GCAM_PARALLEL_ENABLED
+#include <tbb/parallel_for_each.h>
+#endif
+
+#if GCAM_PARALLEL_ENABLED
 #include <tbb/tick_count.h>
+#include "util/base/include/fltcmp.hpp"
 #endif
 
 using namespace std;
@@ -89,6 +97,7 @@ Scenario::Scenario() {
     mSolutionInfoParamParser = 0;
     
     mManageStateVars = 0;
+    mPeriodResultsOutputter = 0;
 }
 
 //! Destructor
@@ -97,6 +106,8 @@ Scenario::~Scenario() {
     delete mWorld;
     delete mSolutionInfoParamParser;
     delete mManageStateVars;
+    ManageStateVariables::clearStateRegistry();
+    delete mPeriodResultsOutputter;
     // model time is really a singleton and so don't
     // try to delete it
 }
@@ -233,6 +244,14 @@ void Scenario::completeInit() {
     // Set the valid period vector to false.
     mIsValidPeriod.clear();
     mIsValidPeriod.resize( mModeltime->getmaxper(), false );
+    mPeriodInputHashes.clear();
+    mPeriodInputHashes.resize( mModeltime->getmaxper(), 0 );
+
+    // Now that all objects have been created find the STATE data once so that
+    // each period does not need to search the full model for it.
+    if( mWorld ) {
+        ManageStateVariables::collectStateRegistry();
+    }
 }
 
 //! Return scenario name.
@@ -269,7 +288,8 @@ bool Scenario::run( const int aSinglePeriod,
     mUnsolvedPeriods.clear();
     
     // Open the debugging files.
-    AutoOutputFile XMLDebugFile( "xmlDebugFileName", "debug.xml", aPrintDebugging );
+    AutoOutputFile XMLDebugFile( "xmlDebugFileName", "debug.xml", aPrintDebugging,
+                                 Configuration::getInstance()->getBool( "debug-xml-compress", false ) );
     Tabs tabs;
     if( aPrintDebugging ) {
         // Write opening tags for debug XML
@@ -279,6 +299,12 @@ bool Scenario::run( const int aSinglePeriod,
         tabs.increaseIndent();
     }
 
+    // Stream the results of each period as it completes if requested.  Similar
+    // to the debugging files we avoid doing this for intermediate runs.
+    if( aPrintDebugging && PeriodResultsOutputter::isEnabled() ) {
+        mPeriodResultsOutputter = new PeriodResultsOutputter();
+    }
+
     Timer& fullScenarioTimer = TimerRegistry::getInstance().getTimer( TimerRegistry::FULLSCENARIO );
     fullScenarioTimer.start();
     
@@ -287,10 +313,22 @@ bool Scenario::run( const int aSinglePeriod,
 
     bool success = true;
 
+    // Periods whose inputs did not change since they were last solved may be
+    // skipped if requested.  Periods may only be reused from the previous run as
+    // long as all periods before them were reused as well since otherwise the
+    // state they start from may have changed.  We never skip periods when writing
+    // debugging output as those files should contain every period.
+    bool canReuse = conf->getBool( "skip-unchanged-periods", false, false ) && !aPrintDebugging;
+
     // If the single period is RUN_ALL_PERIODS that means to calculate all periods. Loop over
     // time steps and operate model.
     if( aSinglePeriod == RUN_ALL_PERIODS ){
         for( int per = 0; per < mModeltime->getmaxper(); per++ ){
+            canReuse = canReuse && canReusePeriod( per );
+            if( canReuse ) {
+                mIsValidPeriod[ per ] = true;
+                continue;
+            }
             success &= calculatePeriod( per, *XMLDebugFile, &tabs, aPrintDebugging );
             // If QuitFirstFailure bool is set to 1 and model is not running in target finder mode,
             // model will exit after any failed model period (rather than running to completion).
@@ -315,7 +353,11 @@ bool Scenario::run( const int aSinglePeriod,
         // model fails to solve.
         bool runNextPeriod = true;
         for( int per = 0; per < aSinglePeriod; per++ ){
-            if( !mIsValidPeriod[ per ] ){
+            canReuse = canReuse && canReusePeriod( per );
+            if( canReuse ) {
+                mIsValidPeriod[ per ] = true;
+            }
+            else if( !mIsValidPeriod[ per ] ){
                 success &= calculatePeriod( per, *XMLDebugFile, &tabs, aPrintDebugging );
                 // If QuitFirstFailure bool is set to 1 and model is not running in target finder mode,
                 // model will exit after any failed model period (rather than running to completion).
@@ -366,10 +408,24 @@ bool Scenario::run( const int aSinglePeriod,
     // Run the climate model.
     mWorld->runClimateModel();
 
+    // Wait for any period results still being written.
+    if( mPeriodResultsOutputter ) {
+        mPeriodResultsOutputter->finish();
+        delete mPeriodResultsOutputter;
+        mPeriodResultsOutputter = 0;
+    }
+
     // Close the debugging files.
     if( aPrintDebugging ){
         XMLWriteClosingTag( getXMLNameStatic(), *XMLDebugFile, &tabs );
     }
+
+    // Log an estimate of the memory held by each subsystem if requested.
+    if( MemoryReport::isEnabled() ) {
+        MemoryReport memoryReport;
+        memoryReport.collect( this );
+        memoryReport.print( "at the end of the run" );
+    }
     
     // Log that the run has finished.
     logRunEnding();
@@ -417,63 +473,19 @@ bool Scenario::calculatePeriod( const int aPeriod,
     // they got set from a restart file.
     mMarketplace->nullSuppliesAndDemands( aPeriod );
 
-#if GCAM_PARALLEL_ENABLED && PARALLEL_DEBUG
-    mWorld->calc( aPeriod );       // get rid of transient bad data
-    mMarketplace->nullSuppliesAndDemands( aPeriod );
-
-    ILogger &mainlog = ILogger::getLogger("main_log"); 
-    
-    ILogger &pdebug = ILogger::getLogger( "parallel_debug_log" );
-    pdebug.setLevel(ILogger::DEBUG);
-    pdebug << "**************** Starting serial World::calc (period " << aPeriod << ") ****************\n";
-
-    tbb::tick_count t0 = tbb::tick_count::now();
+#if GCAM_PARALLEL_ENABLED
+#if PARALLEL_DEBUG
+    const bool checkParallel = true;
+#else
+    const bool checkParallel = Configuration::getInstance()->getBool( "check-parallel-calc", false );
 #endif
-    
-    mWorld->calc( aPeriod ); // call to calculate initial supply and demand
-
-#if GCAM_PARALLEL_ENABLED && PARALLEL_DEBUG
-    tbb::tick_count t1 = tbb::tick_count::now();
-    
-    pdebug << "****************Ending serial World::calc****************\n";
-    std::vector<double> serialrslt = marketplace->fullstate( aPeriod );
-
-    pdebug << "%%%%%%%%%%%%%%%% Starting parallel World::calc (period " << aPeriod << ") %%%%%%%%%%%%%%%%\n";
-    tbb::tick_count t2;
-    tbb::tick_count t3;
-    mMarketplace->nullSuppliesAndDemands( aPeriod );
-
-    t2 = tbb::tick_count::now();
-    mWorld->calc(aPeriod, world->getGlobalFlowGraph());
-    t3 = tbb::tick_count::now();
-      
-    pdebug << "%%%%%%%%%%%%%%%% Ending parallel World::calc %%%%%%%%%%%%%%%%\n";
-
-    // check for consistency between serial and parallel versions
-
-    ILogger::WarningLevel old_main_log_level = mainlog.setLevel(ILogger::ERROR);
-    if(aPeriod > 0) {
-        if( !mMarketplace->checkstate(aPeriod, serialrslt, &mainlog, DBL_CMP_LOOSE) ) {
-            std::cerr << "ERROR: parallel calc failed to reproduce serial results in period " << aPeriod
-                      << ".\n";
-            mainlog << "ERROR: parallel calc failed to reproduce serial results in period " << aPeriod
-                    << ".\n"; 
-        } 
-        else {
-            mainlog.setLevel(ILogger::NOTICE);
-            std::cerr << "Period " << aPeriod << " parallel calc successful.\n";
-        }
+    if( checkParallel ) {
+        checkParallelCalc( aPeriod );
+        mMarketplace->nullSuppliesAndDemands( aPeriod );
     }
-
-    mainlog.setLevel(ILogger::WARNING);
-    double sertime = (t1-t0).seconds();
-    double partime = (t3-t2).seconds();
-    double ratio   = sertime/partime;
-    mainlog << "===Period: " << aPeriod << ":\tserial time: " << sertime
-            << "\tparallel time:  " << partime << "\tspeedup:  " << ratio << "\n";
-    mainlog.setLevel( old_main_log_level );
 #endif
     
+    mWorld->calc( aPeriod ); // call to calculate initial supply and demand
     
     bool success = solve( aPeriod ); // solution uses Bisect and NR routine to clear markets
 
@@ -482,6 +494,16 @@ bool Scenario::calculatePeriod( const int aPeriod,
     // Mark that the period is now valid.
     mIsValidPeriod[ aPeriod ] = true;
 
+    // Record the inputs this period was solved with so that it may be skipped
+    // in subsequent runs if they do not change.  Unsolved periods are always
+    // recalculated.
+    mPeriodInputHashes[ aPeriod ] = success ? calcPeriodInputHash( aPeriod ) : 0;
+
+    // Keep the solved prices to give related runs a better starting point.
+    if( success ) {
+        mMarketplace->storeWarmStart( mName, aPeriod );
+    }
+
     // Run the climate model for this period (only if the solver is successful)
     if( !success ) {
         ILogger& climatelog = ILogger::getLogger( "climate-log" );
@@ -503,12 +525,63 @@ bool Scenario::calculatePeriod( const int aPeriod,
         writeDebuggingFiles( aXMLDebugFile, aTabs, aPeriod );
     }
 
+    // Collect this period's results, the writing will happen in the background
+    // while the next period is being solved.
+    if( mPeriodResultsOutputter ) {
+        mPeriodResultsOutputter->writePeriod( this, aPeriod );
+    }
+
     delete mManageStateVars;
     mManageStateVars = 0;
     
     return success;
 }
 
+#if GCAM_PARALLEL_ENABLED
+/*!
+ * \brief Check that a parallel World.calc reproduces the serial one.
+ * \details Calculates the period serially and then with the flow graph and
+ *          compares the prices, supplies, and demands of every market.  When
+ *          deterministic-parallel is set the results must be bitwise identical,
+ *          otherwise they are compared with a loose tolerance as they are
+ *          summed in a different order.  The serial and parallel times are
+ *          also logged.  Supplies and demands are left set by the parallel
+ *          calculation.
+ * \param aPeriod The period to check.
+ * \return Whether the results matched.
+ */
+bool Scenario::checkParallelCalc( const int aPeriod ) {
+    // get rid of transient bad data
+    mWorld->calc( aPeriod );
+    mMarketplace->nullSuppliesAndDemands( aPeriod );
+
+    const tbb::tick_count serialStart = tbb::tick_count::now();
+    mWorld->calc( aPeriod );
+    const double serialTime = ( tbb::tick_count::now() - serialStart ).seconds();
+    const vector<double> serialState = mMarketplace->fullstate( aPeriod );
+
+    mMarketplace->nullSuppliesAndDemands( aPeriod );
+    const tbb::tick_count parallelStart = tbb::tick_count::now();
+    mWorld->calc( aPeriod, 0 );
+    const double parallelTime = ( tbb::tick_count::now() - parallelStart ).seconds();
+
+    ILogger& mainLog = ILogger::getLogger( "main_log" );
+    mainLog.setLevel( ILogger::ERROR );
+    const unsigned int tolerance = Marketplace::mIsDeterministicCalc ? 0 : DBL_CMP_LOOSE;
+    const bool isReproduced = mMarketplace->checkstate( aPeriod, serialState, &mainLog, tolerance );
+    if( !isReproduced ) {
+        mainLog << "Parallel calc failed to reproduce serial results in period " << aPeriod
+                << ( tolerance == 0 ? " exactly." : "." ) << endl;
+    }
+
+    mainLog.setLevel( ILogger::NOTICE );
+    mainLog << "Period " << aPeriod << " serial time: " << serialTime
+            << " parallel time: " << parallelTime
+            << " speedup: " << serialTime / parallelTime << endl;
+    return isReproduced;
+}
+#endif
+
 /*! \brief Perform any logging which should occur when a period begins.
 * \param aPeriod Model period.
 */
@@ -558,6 +631,9 @@ void Scenario::writeDebuggingFiles( ostream& aXMLDebugFile,
                                     Tabs* aTabs,
                                     const int aPeriod ) const
 {
+    if( !DebugFilter::isDebugPeriod( aPeriod ) ) {
+        return;
+    }
     mModeltime->toDebugXML( aPeriod, aXMLDebugFile, aTabs );
     mWorld->toDebugXML( aPeriod, aXMLDebugFile, aTabs );
 }
@@ -590,44 +666,73 @@ void Scenario::accept( IVisitor* aVisitor, const int aPeriod ) const {
 * \param aPeriod The period to print graphs for.
 */
 void Scenario::printGraphs( const int aPeriod ) const {
-    // Determine which region to print. Default to the US.
-    const string regionToGraph = Configuration::getInstance()->getString( "debug-region", "USA" );
-    
-    // Open the file. It will automatically close.
-    AutoOutputFile graphStream( "dependencyGraphName", "graph" );
-    if( !graphStream.shouldWrite() ) {
+    const Configuration* conf = Configuration::getInstance();
+    if( !conf->shouldWriteFile( "dependencyGraphName" ) ) {
         return;
     }
+    string fileName = conf->getFile( "dependencyGraphName", "graph" );
+    if( conf->shouldAppendScnToFile( "dependencyGraphName" ) ) {
+        fileName = util::appendScenarioToFileName( fileName );
+    }
     
-    // Create a graph printer.
-    GraphPrinter graphPrinter( regionToGraph, *graphStream );
-    
-    // Update the graph printer with information from the model.
-    accept( &graphPrinter, aPeriod );
-    
-    // Print the graph.
-    graphPrinter.finish();
+    // Print a graph for each of the debug regions, default to the US.
+    forEachDebugRegion( [this, aPeriod, &fileName]( const string& aRegionToGraph ) {
+        // Open the file. It will automatically close.
+        AutoOutputFile graphStream( DebugFilter::getRegionFileName( fileName, aRegionToGraph ) );
+        
+        // Create a graph printer.
+        GraphPrinter graphPrinter( aRegionToGraph, *graphStream );
+        
+        // Update the graph printer with information from the model.
+        accept( &graphPrinter, aPeriod );
+        
+        // Print the graph.
+        graphPrinter.finish();
+    } );
 }
 
 void Scenario::printLandAllocatorGraph( const int aPeriod, const bool aPrintValues ) const {
-    // Determine which region to print.  Default to the US.
-    const string regionToGraph = Configuration::getInstance()->getString( "debug-region", "USA" );
-    
-    // Open the file.  It will automatically close.
-    AutoOutputFile landAllocatorStream( "landAllocatorGraphName", "LandAllocatorGraph" );
-    if( !landAllocatorStream.shouldWrite() ) {
+    const Configuration* conf = Configuration::getInstance();
+    if( !conf->shouldWriteFile( "landAllocatorGraphName" ) ) {
         return;
     }
+    string fileName = conf->getFile( "landAllocatorGraphName", "LandAllocatorGraph" );
+    if( conf->shouldAppendScnToFile( "landAllocatorGraphName" ) ) {
+        fileName = util::appendScenarioToFileName( fileName );
+    }
+    
+    // Print a graph for each of the debug regions, default to the US.
+    forEachDebugRegion( [this, aPeriod, aPrintValues, &fileName]( const string& aRegionToGraph ) {
+        // Open the file.  It will automatically close.
+        AutoOutputFile landAllocatorStream( DebugFilter::getRegionFileName( fileName, aRegionToGraph ) );
+        
+        // Create the land allocator printer.
+        LandAllocatorPrinter landAllocatorPrinter( aRegionToGraph, *landAllocatorStream,
+                                                   aPrintValues, true );
+        
+        // Update the land allocator printer with information from the model.
+        accept( &landAllocatorPrinter, aPeriod );
+        
+        // Print the graph.
+        landAllocatorPrinter.finish();
+    } );
+}
 
-    // Create the land allocator printer.
-    LandAllocatorPrinter landAllocatorPrinter( regionToGraph, *landAllocatorStream,
-                                               aPrintValues, true );
-
-    // Update the land allocator printer with information from the model.
-    accept( &landAllocatorPrinter, aPeriod );
-
-    // Print the graph.
-    landAllocatorPrinter.finish();
+/*!
+ * \brief Write some debugging output for each of the debug regions.
+ * \details The regions are written concurrently when possible as each is
+ *          written to its own file and only reads the model.
+ * \param aWriteRegion A function which writes the output for a single region.
+ */
+void Scenario::forEachDebugRegion( const function<void( const string& )>& aWriteRegion ) const {
+    const vector<string>& debugRegions = DebugFilter::getDebugRegions();
+#if GCAM_PARALLEL_ENABLED
+    tbb::parallel_for_each( debugRegions.begin(), debugRegions.end(), aWriteRegion );
+#else
+    for( const auto& region : debugRegions ) {
+        aWriteRegion( region );
+    }
+#endif
 }
 
 /*! \brief Set a tax into all regions.
@@ -636,6 +741,9 @@ void Scenario::printLandAllocatorGraph( const int aPeriod, const bool aPrintValu
 */
 void Scenario::setTax( const GHGPolicy* aTax ){
     mWorld->setTax( aTax );
+    // Setting a tax may replace policy objects and create markets so the STATE
+    // registry will need to be rebuilt.
+    ManageStateVariables::clearStateRegistry();
 }
 
 /*! \brief Get the climate model.
@@ -713,6 +821,9 @@ void Scenario::writeOutputFiles() const {
     const Configuration* conf = Configuration::getInstance();
     bool printValues = conf->getBool("PrintValuesOnGraphs");
     for( int period = 0; period  < getModeltime()->getmaxper(); ++period  ){
+        if( !DebugFilter::isDebugPeriod( period ) ) {
+            continue;
+        }
         printGraphs( period );
         // We only need to print a graph for each period if we are printing
         // values on the graphs.  Otherwise they are all the same.
@@ -771,6 +882,45 @@ const vector<int>& Scenario::getUnsolvedPeriods() const {
  *        recalculated to force it to do so the next time run is called.
  * \param aPeriod The model period to invalidate.
  */
+/*!
+ * \brief Calculate a hash of the inputs which determine the results of a period.
+ * \details The policy taxes and constraints are the inputs which are changed
+ *          between runs, for instance by the target finder.  The hash of the
+ *          previous period is included so that the hash of a period also
+ *          captures the state it would start from which is carried forward
+ *          from all previous periods.
+ * \param aPeriod The model period to hash.
+ * \return The hash of the inputs for the period.
+ */
+size_t Scenario::calcPeriodInputHash( const int aPeriod ) const {
+    size_t seed = aPeriod == 0 ? 0 : mPeriodInputHashes[ aPeriod - 1 ];
+    boost::hash_combine( seed, aPeriod );
+    mWorld->hashPeriodInputs( aPeriod, seed );
+    return seed;
+}
+
+/*!
+ * \brief Determine if the results of a previous calculation of a period can be
+ *        used in place of recalculating it.
+ * \details The period must have been solved and its inputs must be unchanged.
+ *          The caller must also ensure no preceding period has been recalculated
+ *          since that could change the state this period starts from.  The state
+ *          of a period is retained in the model objects once it is calculated
+ *          so nothing needs to be restored to reuse it.
+ * \param aPeriod The model period to check.
+ * \return Whether the period can be reused.
+ */
+bool Scenario::canReusePeriod( const int aPeriod ) const {
+    const bool canReuse = mPeriodInputHashes[ aPeriod ] != 0 &&
+        mPeriodInputHashes[ aPeriod ] == calcPeriodInputHash( aPeriod );
+    if( canReuse ) {
+        ILogger& mainLog = ILogger::getLogger( "main_log" );
+        mainLog.setLevel( ILogger::NOTICE );
+        mainLog << "Inputs for period " << aPeriod << " are unchanged, skipping recalculation." << endl;
+    }
+    return canReuse;
+}
+
 void Scenario::invalidatePeriod( const int aPeriod ) {
     mIsValidPeriod[ aPeriod ] = false;
 }
@@ -46,6 +46,7 @@
 #include <vector>
 #include <map>
 #include <algorithm>
+#include <sstream>
 
 #include "util/base/include/xml_helper.h"
 #include "containers/include/world.h"
@@ -74,9 +75,14 @@
 #include "containers/include/market_dependency_finder.h"
 #include "technologies/include/global_technology_database.h"
 #include "containers/include/iactivity.h"
+#include "util/base/include/object_arena.h"
+#include "util/base/include/debug_filter.h"
 
 #if GCAM_PARALLEL_ENABLED
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_for_each.h>
 #include "parallel/include/gcam_parallel.hpp"
+#include "parallel/include/numa_region_scheduler.hpp"
 #endif
 
 // Uncommenting the following two lines will turn on floating-point exceptions within World::calc(),
@@ -96,6 +102,10 @@ World::World()
     mClimateModel = 0;
     mCalcCounter = new CalcCounter();
     mGlobalTechDB = new GlobalTechnologyDatabase();
+#if GCAM_PARALLEL_ENABLED
+    mRegionScheduler = 0;
+    mIsParallelRegionInit = false;
+#endif
 }
 
 //! World destructor. 
@@ -111,6 +121,10 @@ void World::clear(){
     delete mClimateModel;
     delete mCalcCounter;
     delete mGlobalTechDB;
+#if GCAM_PARALLEL_ENABLED
+    GcamFlowGraph::mRegionScheduler = 0;
+    delete mRegionScheduler;
+#endif
 }
 
 /*! \brief Complete the initialization
@@ -128,9 +142,48 @@ void World::completeInit() {
     // Initialize Climate Model
     mClimateModel->completeInit( scenario->getName() );
     
-    // Finish initializing all the regions.
+#if GCAM_PARALLEL_ENABLED
+    mIsParallelRegionInit = Configuration::getInstance()->getBool( "parallel-region-init", false );
+    Marketplace::mIsDeterministicCalc = Configuration::getInstance()->getBool( "deterministic-parallel", false );
+    if( Marketplace::mIsDeterministicCalc && mIsParallelRegionInit ) {
+        // Regions add to markets outside of the flow graph during initCalc and
+        // postCalc so they must run serially for the results to be reproducible.
+        ILogger& mainLog = ILogger::getLogger( "main_log" );
+        mainLog.setLevel( ILogger::WARNING );
+        mainLog << "Ignoring parallel-region-init as deterministic-parallel is set." << endl;
+        mIsParallelRegionInit = false;
+    }
+    if( NumaRegionScheduler::isEnabled() ) {
+        mRegionScheduler = new NumaRegionScheduler();
+        for( CRegionIterator regionIter = mRegions.begin(); regionIter != mRegions.end(); ++regionIter ) {
+            mRegionScheduler->addRegion( ( *regionIter )->getName() );
+        }
+        // The global flow graph built below uses the scheduler to route the
+        // calculations of each region to its home node.
+        GcamFlowGraph::mRegionScheduler = mRegionScheduler;
+    }
+#endif
+
+    // Finish initializing all the regions.  Note this is always done serially
+    // as the order in which regions create markets and add dependencies determines
+    // the market numbering and so must not change from run to run.
     for( RegionIterator regionIter = mRegions.begin(); regionIter != mRegions.end(); regionIter++ ) {
-        ( *regionIter )->completeInit();
+        Region* region = *regionIter;
+        auto initRegion = [region]() {
+            // Objects created while initializing, such as technology vintages, are
+            // allocated along side the rest of the region's objects.
+            ObjectArena::Scope arenaScope( region->getObjectArena() );
+            region->completeInit();
+        };
+#if GCAM_PARALLEL_ENABLED
+        if( mRegionScheduler ) {
+            // Initialize on the region's home node so that memory first touched
+            // here is placed on that node.
+            mRegionScheduler->execute( mRegionScheduler->getHomeNode( region->getName() ), initRegion );
+            continue;
+        }
+#endif
+        initRegion();
     }
 
     // Now that all regions have finished with completeInit we can instruct the
@@ -156,22 +209,46 @@ void World::completeInit() {
 }
 
 //! Write out XML for debugging purposes.
-/*! \warning This only call Region::toInputXML for the US. */
+/*! \warning This only call Region::toDebugXML for the regions selected by
+ *           the DebugFilter.
+ */
 void World::toDebugXML( const int period, ostream& out, Tabs* tabs ) const {
 
     XMLWriteOpeningTag ( getXMLNameStatic(), out, tabs, "", period );
 
     // write the xml for the class members.
 
-    scenario->getMarketplace()->toDebugXML( period, out, tabs );
-
-    // Only print debug XML information for the specified region to avoid
+    // Only print debug XML information for the specified regions to avoid
     // unmanagably large XML files.
-    const static string debugRegion = Configuration::getInstance()->getString( "debug-region", "USA" );
+    vector<const Region*> debugRegions;
     for( CRegionIterator i = mRegions.begin(); i != mRegions.end(); i++ ) {
-        if( ( *i )->getName() == debugRegion ){
-            ( *i )->toDebugXML( period, out, tabs );
+        if( DebugFilter::isDebugRegion( ( *i )->getName() ) ){
+            debugRegions.push_back( *i );
+        }
+    }
+
+    // The marketplace and each region are written to separate chunks, in parallel
+    // when possible, which are then written out in order so that the file is the
+    // same as when they are written serially.
+    vector<ostringstream> chunks( debugRegions.size() + 1 );
+    auto writeChunk = [&]( const size_t aChunk ) {
+        Tabs chunkTabs( *tabs );
+        if( aChunk == 0 ) {
+            scenario->getMarketplace()->toDebugXML( period, chunks[ aChunk ], &chunkTabs );
+        }
+        else {
+            debugRegions[ aChunk - 1 ]->toDebugXML( period, chunks[ aChunk ], &chunkTabs );
         }
+    };
+#if GCAM_PARALLEL_ENABLED
+    tbb::parallel_for( size_t( 0 ), chunks.size(), writeChunk );
+#else
+    for( size_t chunk = 0; chunk < chunks.size(); ++chunk ) {
+        writeChunk( chunk );
+    }
+#endif
+    for( const auto& chunk : chunks ) {
+        out << chunk.str();
     }
 
     // Climate model parameters
@@ -214,9 +291,9 @@ const string& World::getName() const {
 */
 void World::initCalc( const int period ) {
 
-    for( vector<Region*>::iterator i = mRegions.begin(); i != mRegions.end(); i++ ){
-        ( *i )->initCalc( period );
-    }
+    forEachRegion( [period]( Region* aRegion ) {
+        aRegion->initCalc( period );
+    } );
     
     // Reset the calc counter.
     mCalcCounter->startNewPeriod();
@@ -292,8 +369,16 @@ void World::calc( const int aPeriod, GcamFlowGraph *aWorkGraph, const vector<IAc
     }
 
     // do the model calculation
+    const tbb::tick_count start = tbb::tick_count::now();
     aWorkGraph->mHead.try_put( tbb::flow::continue_msg() );
     aWorkGraph->mTBBFlowGraph.wait_for_all();
+    if( mRegionScheduler ) {
+        mRegionScheduler->addWallTime( ( tbb::tick_count::now() - start ).seconds() );
+    }
+    if( Marketplace::mIsDeterministicCalc ) {
+        // sum any supplies and demands not already summed when they were read
+        scenario->getMarketplace()->reduceContributions( aPeriod );
+    }
 
 #ifdef GNU_SOURCE
     feenableexcept(except);
@@ -302,9 +387,13 @@ void World::calc( const int aPeriod, GcamFlowGraph *aWorkGraph, const vector<IAc
 #endif
 
 
-/*! Calculates the global emissions.
+/*! Calculates the global emissions and passes them to the climate model.
+ * \details All emissions are summed with a single visit of the model regardless
+ *          of the number of periods to set.
+ * \param aStartPeriod The first period for which to set emissions.
+ * \param aEndPeriod The last period, inclusive, for which to set emissions.
  */
-void World::setEmissions( int period ) {
+void World::setEmissions( const int aStartPeriod, const int aEndPeriod ) {
     // Declare visitors which will aggregate emissions by period.
     EmissionsSummer co2Summer( "CO2" );
     EmissionsSummer co2fugSummer( "CO2_FUG" );
@@ -403,6 +492,7 @@ void World::setEmissions( int period ) {
     allSummer.addEmissionsSummer( &nh3Summer );
     allSummer.addEmissionsSummer( &nh3agrSummer );
     allSummer.addEmissionsSummer( &nh3awbSummer );
+    allSummer.setLUCEmissionsSummer( &co2LandUseSummer );
 
 
    const double TG_TO_PG = 1000;
@@ -417,222 +507,222 @@ void World::setEmissions( int period ) {
     const double HFC365_TO_245 = ( 794.0 / 1030.0 );
     const double HFC43_TO_134 = ( 1640.0 / 1430.0 );
     
-    // Update all emissions values.
-    accept( &allSummer, period );
-    accept( &co2LandUseSummer, period );
+    // Update all emissions values for all periods at once.
+    accept( &allSummer, aStartPeriod );
+
+    for( int period = aStartPeriod; period <= aEndPeriod; ++period ) {
         
-    // Only set emissions if they are valid. If these are not set
-    // MAGICC will use the default values.
-    if( co2Summer.areEmissionsSet( period ) ){
-        // Note: a climate model will either take the net or gross +/-
-        // but not both, thus we make both available
-        mClimateModel->setEmissions( "CO2", period,
-                                     ( co2Summer.getEmissions( period ) +
-                                       co2fugSummer.getEmissions( period ) )
-                                     / TG_TO_PG );
-        mClimateModel->setEmissions( "CO2FFIEmissions", period,
-                                     ( co2Summer.getEmissionsPositive( period ) +
-                                      co2fugSummer.getEmissions( period ) )
-                                     / TG_TO_PG );
-        // the emissions summer will produce negative emissions
-        // however the climate model wants positive uptake so we apply the
-        // negate here
-        mClimateModel->setEmissions( "CO2DACCCSUptake", period,
-                                     -co2Summer.getEmissionsNegative( period )
-                                     / TG_TO_PG );
-    }
-    
-    const int currYear = scenario->getModeltime()->getper_to_yr( period );
-    const int startYear = currYear - scenario->getModeltime()->gettimestep( period ) + 1;
-    for ( int i = startYear; i <= currYear; i++ ) {
-        if( co2LandUseSummer.areEmissionsSet( i ) ){
+        // Only set emissions if they are valid. If these are not set
+        // MAGICC will use the default values.
+        if( co2Summer.areEmissionsSet( period ) ){
             // Note: a climate model will either take the net or gross +/-
             // but not both, thus we make both available
-            mClimateModel->setLUCEmissions( "CO2NetLandUse", i,
-                                            co2LandUseSummer.getEmissions( i )
-                                            / TG_TO_PG );
-            mClimateModel->setLUCEmissions( "CO2EmissionsLandUse", i,
-                                            co2LandUseSummer.getEmissionsPositive( i )
-                                            / TG_TO_PG );
+            mClimateModel->setEmissions( "CO2", period,
+                                         ( co2Summer.getEmissions( period ) +
+                                           co2fugSummer.getEmissions( period ) )
+                                         / TG_TO_PG );
+            mClimateModel->setEmissions( "CO2FFIEmissions", period,
+                                         ( co2Summer.getEmissionsPositive( period ) +
+                                          co2fugSummer.getEmissions( period ) )
+                                         / TG_TO_PG );
             // the emissions summer will produce negative emissions
             // however the climate model wants positive uptake so we apply the
             // negate here
-            mClimateModel->setLUCEmissions( "CO2UptakeLandUse", i,
-                                            -co2LandUseSummer.getEmissionsNegative( i )
-                                            / TG_TO_PG );
+            mClimateModel->setEmissions( "CO2DACCCSUptake", period,
+                                         -co2Summer.getEmissionsNegative( period )
+                                         / TG_TO_PG );
         }
-    }
     
-    if( ch4Summer.areEmissionsSet( period ) ){
-        mClimateModel->setEmissions( "CH4", period,
-                                     ch4Summer.getEmissions( period ) +
-                                     ch4agrSummer.getEmissions( period ) + 
-                                     ch4awbSummer.getEmissions( period ));
-    }
+        const int currYear = scenario->getModeltime()->getper_to_yr( period );
+        const int startYear = currYear - scenario->getModeltime()->gettimestep( period ) + 1;
+        for ( int i = startYear; i <= currYear; i++ ) {
+            if( co2LandUseSummer.areEmissionsSet( i ) ){
+                // Note: a climate model will either take the net or gross +/-
+                // but not both, thus we make both available
+                mClimateModel->setLUCEmissions( "CO2NetLandUse", i,
+                                                co2LandUseSummer.getEmissions( i )
+                                                / TG_TO_PG );
+                mClimateModel->setLUCEmissions( "CO2EmissionsLandUse", i,
+                                                co2LandUseSummer.getEmissionsPositive( i )
+                                                / TG_TO_PG );
+                // the emissions summer will produce negative emissions
+                // however the climate model wants positive uptake so we apply the
+                // negate here
+                mClimateModel->setLUCEmissions( "CO2UptakeLandUse", i,
+                                                -co2LandUseSummer.getEmissionsNegative( i )
+                                                / TG_TO_PG );
+            }
+        }
     
-    if( coSummer.areEmissionsSet( period ) ){
-        mClimateModel->setEmissions( "CO", period,
-                                     coSummer.getEmissions( period ) +
-                                     coagrSummer.getEmissions( period ) +
-                                     coawbSummer.getEmissions( period ));
-    }
+        if( ch4Summer.areEmissionsSet( period ) ){
+            mClimateModel->setEmissions( "CH4", period,
+                                         ch4Summer.getEmissions( period ) +
+                                         ch4agrSummer.getEmissions( period ) + 
+                                         ch4awbSummer.getEmissions( period ));
+        }
     
-    // MAGICC wants N2O emissions in Tg N, but miniCAM calculates Tg N2O
-    if( n2oSummer.areEmissionsSet( period ) ){
-        mClimateModel->setEmissions( "N2O", period,
-                                     ( n2oSummer.getEmissions( period ) +
-                                       n2oawbSummer.getEmissions( period ) +
-                                       n2oagrSummer.getEmissions( period )  )
-                                     / N_TO_N2O );
-    }
+        if( coSummer.areEmissionsSet( period ) ){
+            mClimateModel->setEmissions( "CO", period,
+                                         coSummer.getEmissions( period ) +
+                                         coagrSummer.getEmissions( period ) +
+                                         coawbSummer.getEmissions( period ));
+        }
     
-    // MAGICC wants NOx emissions in Tg N, but miniCAM calculates Tg NOx
-    // FORTRAN code uses the conversion for NO2
-    if( noxSummer.areEmissionsSet( period ) ){
-        mClimateModel->setEmissions( "NOx", period,
-                                     ( noxSummer.getEmissions( period ) +
-                                       noxagrSummer.getEmissions( period ) +
-                                       noxawbSummer.getEmissions( period ))
-                                     / N_TO_NO2 );
-    }
+        // MAGICC wants N2O emissions in Tg N, but miniCAM calculates Tg N2O
+        if( n2oSummer.areEmissionsSet( period ) ){
+            mClimateModel->setEmissions( "N2O", period,
+                                         ( n2oSummer.getEmissions( period ) +
+                                           n2oawbSummer.getEmissions( period ) +
+                                           n2oagrSummer.getEmissions( period )  )
+                                         / N_TO_N2O );
+        }
     
-    double so2total=0.0;
-    // MAGICC wants SO2 emissions in Tg S, but miniCAM calculates Tg SO2
-    // Region 1 includes SO21 and 60% of SO24 (FSU)
-    if( so21Summer.areEmissionsSet( period ) && so24Summer.areEmissionsSet( period )){
-        double so21 = so21Summer.getEmissions( period ) +
-            so21awbSummer.getEmissions( period )
-            + 0.6*so24Summer.getEmissions( period ) 
-            + 0.6*so24awbSummer.getEmissions( period ); 
+        // MAGICC wants NOx emissions in Tg N, but miniCAM calculates Tg NOx
+        // FORTRAN code uses the conversion for NO2
+        if( noxSummer.areEmissionsSet( period ) ){
+            mClimateModel->setEmissions( "NOx", period,
+                                         ( noxSummer.getEmissions( period ) +
+                                           noxagrSummer.getEmissions( period ) +
+                                           noxawbSummer.getEmissions( period ))
+                                         / N_TO_NO2 );
+        }
+    
+        double so2total=0.0;
+        // MAGICC wants SO2 emissions in Tg S, but miniCAM calculates Tg SO2
+        // Region 1 includes SO21 and 60% of SO24 (FSU)
+        if( so21Summer.areEmissionsSet( period ) && so24Summer.areEmissionsSet( period )){
+            double so21 = so21Summer.getEmissions( period ) +
+                so21awbSummer.getEmissions( period )
+                + 0.6*so24Summer.getEmissions( period ) 
+                + 0.6*so24awbSummer.getEmissions( period ); 
         
-        mClimateModel->setEmissions( "SOXreg1", period, so21/S_TO_SO2);
-        so2total += so21;
-    }
+            mClimateModel->setEmissions( "SOXreg1", period, so21/S_TO_SO2);
+            so2total += so21;
+        }
     
-    // MAGICC wants SO2 emissions in Tg S, but miniCAM calculates Tg SO2
-    // Region 2 includes SO22 and 40% of SO24 (FSU)
-    if( so22Summer.areEmissionsSet( period ) && so24Summer.areEmissionsSet( period )){
-        double so22 = so22Summer.getEmissions( period ) +
-            so22awbSummer.getEmissions( period )
-            + 0.4*so24Summer.getEmissions( period ) 
-            + 0.4*so24awbSummer.getEmissions( period );
+        // MAGICC wants SO2 emissions in Tg S, but miniCAM calculates Tg SO2
+        // Region 2 includes SO22 and 40% of SO24 (FSU)
+        if( so22Summer.areEmissionsSet( period ) && so24Summer.areEmissionsSet( period )){
+            double so22 = so22Summer.getEmissions( period ) +
+                so22awbSummer.getEmissions( period )
+                + 0.4*so24Summer.getEmissions( period ) 
+                + 0.4*so24awbSummer.getEmissions( period );
         
-        mClimateModel->setEmissions( "SOXreg2", period, so22 / S_TO_SO2);
-        so2total += so22;
-    }
+            mClimateModel->setEmissions( "SOXreg2", period, so22 / S_TO_SO2);
+            so2total += so22;
+        }
     
-    // MAGICC wants SO2 emissions in Tg S, but miniCAM calculates Tg SO2
-    if( so23Summer.areEmissionsSet( period ) ){
-        double so23 = so23Summer.getEmissions( period ) +
-            so23awbSummer.getEmissions( period );
+        // MAGICC wants SO2 emissions in Tg S, but miniCAM calculates Tg SO2
+        if( so23Summer.areEmissionsSet( period ) ){
+            double so23 = so23Summer.getEmissions( period ) +
+                so23awbSummer.getEmissions( period );
         
-        mClimateModel->setEmissions( "SOXreg3", period, so23 / S_TO_SO2 );
-        so2total += so23;
-    }
+            mClimateModel->setEmissions( "SOXreg3", period, so23 / S_TO_SO2 );
+            so2total += so23;
+        }
     
-    // set total SO2 emissions for those models that want it.
-    // Emissions are in Tg SO2; it is up to models that want
-    // something different to make their own conversion.
-    mClimateModel->setEmissions("SO2tot", period, so2total);
+        // set total SO2 emissions for those models that want it.
+        // Emissions are in Tg SO2; it is up to models that want
+        // something different to make their own conversion.
+        mClimateModel->setEmissions("SO2tot", period, so2total);
     
-    if( cf4Summer.areEmissionsSet( period ) ){
-        mClimateModel->setEmissions( "CF4", period,
-                                     cf4Summer.getEmissions( period ) );
-    }
+        if( cf4Summer.areEmissionsSet( period ) ){
+            mClimateModel->setEmissions( "CF4", period,
+                                         cf4Summer.getEmissions( period ) );
+        }
     
-    if( c2f6Summer.areEmissionsSet( period ) ){
-        mClimateModel->setEmissions( "C2F6", period,
-                                     c2f6Summer.getEmissions( period ) );
-    }
+        if( c2f6Summer.areEmissionsSet( period ) ){
+            mClimateModel->setEmissions( "C2F6", period,
+                                         c2f6Summer.getEmissions( period ) );
+        }
     
-    if( sf6Summer.areEmissionsSet( period ) ){
-        mClimateModel->setEmissions( "SF6", period,
-                                     sf6Summer.getEmissions( period ) );
-    }
+        if( sf6Summer.areEmissionsSet( period ) ){
+            mClimateModel->setEmissions( "SF6", period,
+                                         sf6Summer.getEmissions( period ) );
+        }
     
-    if( hfc125Summer.areEmissionsSet( period ) ){
-        mClimateModel->setEmissions( "HFC125", period,
-                                     hfc125Summer.getEmissions( period ) );
-    } 
+        if( hfc125Summer.areEmissionsSet( period ) ){
+            mClimateModel->setEmissions( "HFC125", period,
+                                         hfc125Summer.getEmissions( period ) );
+        } 
     
-    if( hfc134aSummer.areEmissionsSet( period ) && hfc43Summer.areEmissionsSet( period )  ){
-        mClimateModel->setEmissions( "HFC134a", period,
-                                     hfc134aSummer.getEmissions( period ) +
-                                     hfc43Summer.getEmissions( period ) * HFC43_TO_134);
-    }
+        if( hfc134aSummer.areEmissionsSet( period ) && hfc43Summer.areEmissionsSet( period )  ){
+            mClimateModel->setEmissions( "HFC134a", period,
+                                         hfc134aSummer.getEmissions( period ) +
+                                         hfc43Summer.getEmissions( period ) * HFC43_TO_134);
+        }
 
-    if( hfc245faSummer.areEmissionsSet( period ) && hfc32Summer.areEmissionsSet( period ) && hfc365mfcSummer.areEmissionsSet( period ) && hfc152aSummer.areEmissionsSet( period ) ){
-        // MAGICC needs HFC245fa in kton of HFC245ca
-        mClimateModel->setEmissions( "HFC245ca", period,
-                                     hfc245faSummer.getEmissions( period ) / HFC_CA_TO_FA +
-                                     hfc32Summer.getEmissions( period ) * HFC32_TO_245 +
-                                     hfc365mfcSummer.getEmissions( period ) * HFC365_TO_245 +
-                                     hfc152aSummer.getEmissions( period ) * HFC152_TO_245);
-        // For models that need ktonnes of HFC245fa (no single model should implement both of these):
-        mClimateModel->setEmissions("HFC245fa", period,
-                                    hfc245faSummer.getEmissions(period)+
-                                    hfc365mfcSummer.getEmissions( period ) * HFC365_TO_245 +
-                                    hfc152aSummer.getEmissions( period ) * HFC152_TO_245);
-        // hector will take HFC32 seperately
-        mClimateModel->setEmissions( "HFC32", period,
-                                     hfc32Summer.getEmissions( period ));
-    }
+        if( hfc245faSummer.areEmissionsSet( period ) && hfc32Summer.areEmissionsSet( period ) && hfc365mfcSummer.areEmissionsSet( period ) && hfc152aSummer.areEmissionsSet( period ) ){
+            // MAGICC needs HFC245fa in kton of HFC245ca
+            mClimateModel->setEmissions( "HFC245ca", period,
+                                         hfc245faSummer.getEmissions( period ) / HFC_CA_TO_FA +
+                                         hfc32Summer.getEmissions( period ) * HFC32_TO_245 +
+                                         hfc365mfcSummer.getEmissions( period ) * HFC365_TO_245 +
+                                         hfc152aSummer.getEmissions( period ) * HFC152_TO_245);
+            // For models that need ktonnes of HFC245fa (no single model should implement both of these):
+            mClimateModel->setEmissions("HFC245fa", period,
+                                        hfc245faSummer.getEmissions(period)+
+                                        hfc365mfcSummer.getEmissions( period ) * HFC365_TO_245 +
+                                        hfc152aSummer.getEmissions( period ) * HFC152_TO_245);
+            // hector will take HFC32 seperately
+            mClimateModel->setEmissions( "HFC32", period,
+                                         hfc32Summer.getEmissions( period ));
+        }
     
-    // MAGICC needs this in tons of VOC. Input is in TgC
-    if( vocSummer.areEmissionsSet( period ) ){
-        mClimateModel->setEmissions( "NMVOCs", period,
-                                     ( vocSummer.getEmissions( period ) +
-                                       vocagrSummer.getEmissions( period ) +
-                                       vocawbSummer.getEmissions( period ) ));
-    }
+        // MAGICC needs this in tons of VOC. Input is in TgC
+        if( vocSummer.areEmissionsSet( period ) ){
+            mClimateModel->setEmissions( "NMVOCs", period,
+                                         ( vocSummer.getEmissions( period ) +
+                                           vocagrSummer.getEmissions( period ) +
+                                           vocawbSummer.getEmissions( period ) ));
+        }
     
-    // MAGICC needs this in GgC. Model output is in TgC
-    if( bcSummer.areEmissionsSet( period ) ){
-        mClimateModel->setEmissions( "BC", period,
-                                     ( bcSummer.getEmissions( period ) +
-                                       bcawbSummer.getEmissions( period ) )
-                                     * TG_TO_PG );
-    }
+        // MAGICC needs this in GgC. Model output is in TgC
+        if( bcSummer.areEmissionsSet( period ) ){
+            mClimateModel->setEmissions( "BC", period,
+                                         ( bcSummer.getEmissions( period ) +
+                                           bcawbSummer.getEmissions( period ) )
+                                         * TG_TO_PG );
+        }
     
-    // MAGICC needs this in GgC. Model output is in TgC
-    if( ocSummer.areEmissionsSet( period ) ){
-        mClimateModel->setEmissions( "OC", period,
-                                     ( ocSummer.getEmissions( period ) +
-                                       ocawbSummer.getEmissions( period ) )
-                                     * TG_TO_PG );
-    }
+        // MAGICC needs this in GgC. Model output is in TgC
+        if( ocSummer.areEmissionsSet( period ) ){
+            mClimateModel->setEmissions( "OC", period,
+                                         ( ocSummer.getEmissions( period ) +
+                                           ocawbSummer.getEmissions( period ) )
+                                         * TG_TO_PG );
+        }
     
     
-    if( hfc227eaSummer.areEmissionsSet( period ) ){
-        mClimateModel->setEmissions( "HFC227ea", period,
-                                     hfc227eaSummer.getEmissions( period ) );
-    }
+        if( hfc227eaSummer.areEmissionsSet( period ) ){
+            mClimateModel->setEmissions( "HFC227ea", period,
+                                         hfc227eaSummer.getEmissions( period ) );
+        }
     
-    if( hfc143aSummer.areEmissionsSet( period ) && hfc236faSummer.areEmissionsSet( period ) ){
-        mClimateModel->setEmissions( "HFC143a", period,
-                                     hfc143aSummer.getEmissions( period ) +
-                                     hfc236faSummer.getEmissions( period ) * HFC236_TO_143);
-    }
+        if( hfc143aSummer.areEmissionsSet( period ) && hfc236faSummer.areEmissionsSet( period ) ){
+            mClimateModel->setEmissions( "HFC143a", period,
+                                         hfc143aSummer.getEmissions( period ) +
+                                         hfc236faSummer.getEmissions( period ) * HFC236_TO_143);
+        }
     
-    if( hfc23Summer.areEmissionsSet( period ) ){
-        mClimateModel->setEmissions( "HFC23", period,
-                                     hfc23Summer.getEmissions( period ) );
-    }
+        if( hfc23Summer.areEmissionsSet( period ) ){
+            mClimateModel->setEmissions( "HFC23", period,
+                                         hfc23Summer.getEmissions( period ) );
+        }
     
-    if( nh3Summer.areEmissionsSet(period) ) {
-        mClimateModel->setEmissions( "NH3",
-                                    period,
-                                    nh3Summer.getEmissions( period ) +
-                                    nh3awbSummer.getEmissions( period ) +
-                                    nh3agrSummer.getEmissions( period ) );
+        if( nh3Summer.areEmissionsSet(period) ) {
+            mClimateModel->setEmissions( "NH3",
+                                        period,
+                                        nh3Summer.getEmissions( period ) +
+                                        nh3awbSummer.getEmissions( period ) +
+                                        nh3agrSummer.getEmissions( period ) );
+        }
     }
 }
     
 void World::runClimateModel() {
     // The Climate model reads in data for the base period, so skip passing it in.
-    for( int period = 1; period < scenario->getModeltime()->getmaxper(); ++period ) {
-        setEmissions( period );
-    }
+    setEmissions( 1, scenario->getModeltime()->getmaxper() - 1 );
     
     // Run the model.
     mClimateModel->runModel();
@@ -640,7 +730,7 @@ void World::runClimateModel() {
 
 void World::runClimateModel( int aPeriod ) {
     if( aPeriod > 0 ) {
-        setEmissions( aPeriod );
+        setEmissions( aPeriod, aPeriod );
         mClimateModel->runModel( scenario->getModeltime()->getper_to_yr( aPeriod ) );
     }
 }
@@ -695,6 +785,16 @@ void World::setTax( const GHGPolicy* aTax ){
     }
 }
 
+/*! \brief Combine the policy inputs of all regions for a period into a hash.
+* \param aPeriod Model period.
+* \param aSeed The hash value to combine the inputs into.
+*/
+void World::hashPeriodInputs( const int aPeriod, size_t& aSeed ) const {
+    for( CRegionIterator iter = mRegions.begin(); iter != mRegions.end(); ++iter ){
+        (*iter)->hashPeriodInputs( aPeriod, aSeed );
+    }
+}
+
 /*! \brief Get the climate model.
 * \return The climate model.
 */
@@ -760,8 +860,37 @@ CalcCounter* World::getCalcCounter() const {
 */
 void World::postCalc( const int aPeriod ){
     // Finalize sectors.
-    for( RegionIterator region = mRegions.begin(); region != mRegions.end(); ++region ){
-        (*region)->postCalc( aPeriod );
+    forEachRegion( [aPeriod]( Region* aRegion ) {
+        aRegion->postCalc( aPeriod );
+    } );
+#if GCAM_PARALLEL_ENABLED
+    if( mRegionScheduler ) {
+        ILogger& mainLog = ILogger::getLogger( "main_log" );
+        mRegionScheduler->printUtilization( mainLog, aPeriod );
+    }
+#endif
+}
+
+/*!
+ * \brief Apply a once per period calculation such as initCalc or postCalc to
+ *        every region.
+ * \details When the parallel-region-init flag is set the regions are processed
+ *          concurrently.  Otherwise they are processed serially in order.  Regions only share
+ *          markets and the marketplace which are protected by locks for any changes
+ *          made during these calculations.
+ * \param aRegionFunction The calculation to perform on a single region.
+ */
+void World::forEachRegion( const function<void( Region* )>& aRegionFunction ) {
+#if GCAM_PARALLEL_ENABLED
+    if( mIsParallelRegionInit ) {
+        tbb::parallel_for_each( mRegions.begin(), mRegions.end(), [&aRegionFunction]( Region* aRegion ) {
+            aRegionFunction( aRegion );
+        } );
+        return;
+    }
+#endif
+    for( RegionIterator regionIter = mRegions.begin(); regionIter != mRegions.end(); ++regionIter ) {
+        aRegionFunction( *regionIter );
     }
 }
 
@@ -56,6 +56,7 @@
 #include "util/base/include/value.h"
 #include "util/base/include/time_vector.h"
 #include "util/base/include/data_definition_util.h"
+#include "util/base/include/object_arena.h"
 #include "marketplace/include/cached_market.h"
 
 // Forward declarations
@@ -80,7 +81,7 @@ class NonCO2Emissions;
  *          The last one of these read in determines the method used.
  * \author Sonny Kim, Marshall Wise, Steve Smith, Nick Fernandez, Jim Naslund
  */
-class AGHG: public INamed, public IVisitable, private boost::noncopyable
+class AGHG: public INamed, public IVisitable, public ArenaAllocated, private boost::noncopyable
 { 
     friend class XMLDBOutputter;
 
@@ -172,6 +173,10 @@ public:
                                const int aPeriod ) = 0;
     
     double getEmission( const int aPeriod ) const;
+
+    int getGasIndex() const;
+
+    static int getGasIndex( const std::string& aGHGName );
     
     virtual void postCalc( const std::string& aRegionName,
                            const bool aIsInitialTechYear,
@@ -209,6 +214,10 @@ protected:
     //! Pre-located market which has been cached from the marketplace to get the price
     //! of this ghg and add demands to the market.
     CachedMarket mCachedMarket;
+
+    //! A dense index for the name of this gas shared by all gases of the same
+    //! name which is assigned during completeInit, or -1 if not yet assigned.
+    int mGasIndex;
    
     /*!
      * \brief XML debug output stream for derived classes
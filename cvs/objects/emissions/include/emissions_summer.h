@@ -44,10 +44,13 @@
 * \author Josh Lurz
 */
 
+#include <vector>
 #include "util/base/include/time_vector.h"
 #include "util/base/include/default_visitor.h"
 #include "util/base/include/value.h"
 
+class LUCEmissionsSummer;
+
 /*! 
 * \ingroup Objects
 * \brief A class which sums emissions for a particular gas.
@@ -63,6 +66,8 @@ public:
                                 const int aPeriod );
 
     // Non-IVisitor interface methods.
+    void addEmissions( const AGHG* aGHG, const int aPeriod );
+
     double getEmissions( const int aPeriod ) const;
     
     double getEmissionsPositive( const int aPeriod ) const;
@@ -98,8 +103,10 @@ private:
  */
 class GroupedEmissionsSummer : public DefaultVisitor {
 public:
-    GroupedEmissionsSummer(): mCurrTech( 0 ) { }
+    GroupedEmissionsSummer(): mCurrTech( 0 ), mLUCEmissionsSummer( 0 ) { }
     void addEmissionsSummer( EmissionsSummer* aEmissionsSummer );
+
+    void setLUCEmissionsSummer( LUCEmissionsSummer* aLUCEmissionsSummer );
     
     // DefaultVisitor methods
     virtual void startVisitGHG( const AGHG* aGHG,
@@ -111,17 +118,20 @@ public:
     virtual void endVisitTechnology( const Technology* aTech,
                                     const int aPeriod );
     
-    /*virtual void startVisitCarbonCalc( const ICarbonCalc* aCarbonCalc,
-                                       const int aPeriod );*/
+    virtual void startVisitCarbonCalc( const ICarbonCalc* aCarbonCalc,
+                                       const int aPeriod );
     
 private:
-    //! A map of emissions summer by GHG name.  The memory for the EmissionsSummer
-    //! is not managed by this class.
-    std::map<std::string, EmissionsSummer*> mEmissionsSummers;
-    
-    typedef std::map<std::string, EmissionsSummer*>::const_iterator CSummerIterator;
+    //! The emissions summers indexed by the gas index, see AGHG::getGasIndex,
+    //! of the GHG they sum or null if there is none for that gas.  The memory
+    //! for the EmissionsSummer is not managed by this class.
+    std::vector<EmissionsSummer*> mEmissionsSummers;
     
     Technology const* mCurrTech;
+
+    //! An optional land use change emissions summer to also update for all
+    //! periods.  The memory is not managed by this class.
+    LUCEmissionsSummer* mLUCEmissionsSummer;
 };
 
 #endif // _EMISSIONS_SUMMER_H_
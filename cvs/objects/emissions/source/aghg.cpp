@@ -41,6 +41,8 @@
 #include "util/base/include/definitions.h"
 
 #include <cassert>
+#include <map>
+#include <mutex>
 
 #include "emissions/include/aghg.h"
 #include "util/base/include/xml_helper.h"
@@ -60,7 +62,8 @@ using namespace std;
 extern Scenario* scenario;
 
 //! Default constructor.
-AGHG::AGHG()
+AGHG::AGHG():
+mGasIndex( -1 )
 {
 }
 
@@ -72,6 +75,7 @@ AGHG::~AGHG(){
 void AGHG::copy( const AGHG& aOther ){
     mName = aOther.mName;
     mEmissionsUnit = aOther.mEmissionsUnit;
+    mGasIndex = aOther.mGasIndex;
 
     // Note results (such as emissions) are never copied.
 }
@@ -110,6 +114,8 @@ const string& AGHG::getName() const {
 void AGHG::completeInit( const string& aRegionName, const string& aSectorName,
                          const IInfo* aTechInfo )
 {
+    mGasIndex = getGasIndex( getName() );
+
     scenario->getMarketplace()->getDependencyFinder()->addDependency( aSectorName,
                                                                       aRegionName,
                                                                       getName(),
@@ -230,6 +236,31 @@ double AGHG::getEmission( const int aPeriod ) const {
     return mEmissions[ aPeriod ];
 }
 
+/*!
+ * \brief Get the dense index of this gas.
+ * \details All gases with the same name share the same index which allows
+ *          aggregations by gas to be stored in an array rather than matching
+ *          gas names.
+ * \return The index of this gas.
+ * \see getGasIndex( const string& )
+ */
+int AGHG::getGasIndex() const {
+    return mGasIndex != -1 ? mGasIndex : getGasIndex( getName() );
+}
+
+/*!
+ * \brief Get the dense index for a gas name.
+ * \details Indices are assigned sequentially the first time a gas name is seen.
+ * \param aGHGName The name of the gas.
+ * \return The index of the gas.
+ */
+int AGHG::getGasIndex( const string& aGHGName ) {
+    static map<string, int> gasIndices;
+    static mutex gasIndicesMutex;
+    lock_guard<mutex> lock( gasIndicesMutex );
+    return gasIndices.insert( make_pair( aGHGName, static_cast<int>( gasIndices.size() ) ) ).first->second;
+}
+
 /*!
  * \brief Update a visitor with information from a GHG for a given period.
  * \param aVisitor The visitor to update.
@@ -43,6 +43,7 @@
 #include <cassert>
 #include "emissions/include/emissions_summer.h"
 #include "emissions/include/aghg.h"
+#include "emissions/include/luc_emissions_summer.h"
 #include "technologies/include/technology.h"
 
 using namespace std;
@@ -60,13 +61,23 @@ mGHGName( aGHGName ){
 */
 void EmissionsSummer::startVisitGHG( const AGHG* aGHG, const int aPeriod ){
     if( aGHG->getName() == mGHGName ){
-        double currEmissions = aGHG->getEmission( aPeriod );
-        if(currEmissions >= 0) {
-            mEmissionsByPeriodPositive[ aPeriod ] += currEmissions;
-        }
-        else {
-            mEmissionsByPeriodNegative[ aPeriod ] += currEmissions;
-        }
+        addEmissions( aGHG, aPeriod );
+    }
+}
+
+/*! \brief Add emissions from a GHG to the stored emissions without checking
+*          the name of the GHG.
+* \details The caller is responsible for ensuring aGHG is the gas being summed.
+* \param aGHG GHG to update emissions from.
+* \param aPeriod Period in which to update.
+*/
+void EmissionsSummer::addEmissions( const AGHG* aGHG, const int aPeriod ){
+    double currEmissions = aGHG->getEmission( aPeriod );
+    if(currEmissions >= 0) {
+        mEmissionsByPeriodPositive[ aPeriod ] += currEmissions;
+    }
+    else {
+        mEmissionsByPeriodNegative[ aPeriod ] += currEmissions;
     }
 }
 
@@ -126,22 +137,48 @@ const string& EmissionsSummer::getGHGName() const {
  * \param A refernce to an EmissionsSummer to update when this group is updated.
  */
 void GroupedEmissionsSummer::addEmissionsSummer( EmissionsSummer* aEmissionsSummer ) {
-    mEmissionsSummers[ aEmissionsSummer->getGHGName() ] = aEmissionsSummer;
+    const int gasIndex = AGHG::getGasIndex( aEmissionsSummer->getGHGName() );
+    if( gasIndex >= mEmissionsSummers.size() ) {
+        mEmissionsSummers.resize( gasIndex + 1, 0 );
+    }
+    mEmissionsSummers[ gasIndex ] = aEmissionsSummer;
+}
+
+/*!
+ * \brief Set a LUCEmissionsSummer to be updated for all model periods as well.
+ * \details This allows both the GHG and land use change emissions to be summed
+ *          with a single visit.  The memory for the given LUCEmissionsSummer will
+ *          not be managed by this object.
+ * \param aLUCEmissionsSummer The LUCEmissionsSummer to update.
+ */
+void GroupedEmissionsSummer::setLUCEmissionsSummer( LUCEmissionsSummer* aLUCEmissionsSummer ) {
+    mLUCEmissionsSummer = aLUCEmissionsSummer;
 }
 
 void GroupedEmissionsSummer::startVisitGHG( const AGHG* aGHG, const int aPeriod ) {
     // We are currently assuming all periods should be updated.
     
-    CSummerIterator it = mEmissionsSummers.find( aGHG->getName() );
-    if( it != mEmissionsSummers.end() ) {
+    const int gasIndex = aGHG->getGasIndex();
+    if( gasIndex < mEmissionsSummers.size() && mEmissionsSummers[ gasIndex ] ) {
         for( int period = 1; period < scenario->getModeltime()->getmaxper(); ++period ) {
             if( !mCurrTech || mCurrTech->isOperating(period) ) {
-                (*it).second->startVisitGHG( aGHG, period );
+                mEmissionsSummers[ gasIndex ]->addEmissions( aGHG, period );
             }
         }
     }
 }
 
+void GroupedEmissionsSummer::startVisitCarbonCalc( const ICarbonCalc* aCarbonCalc,
+                                                   const int aPeriod )
+{
+    // We are currently assuming all periods should be updated.
+    if( mLUCEmissionsSummer ) {
+        for( int period = 1; period < scenario->getModeltime()->getmaxper(); ++period ) {
+            mLUCEmissionsSummer->startVisitCarbonCalc( aCarbonCalc, period );
+        }
+    }
+}
+
 void GroupedEmissionsSummer::startVisitTechnology( const Technology* aTech,
                                   const int aPeriod )
 {
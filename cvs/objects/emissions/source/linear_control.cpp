@@ -166,7 +166,8 @@ void LinearControl::initCalc( const string& aRegionName,
 
     // Make sure start year is not before the first model period for this object.
     int thisModelYear = scenario->getModeltime()->getper_to_yr( aPeriod );
-    if ( aTechInfo->getBoolean( "new-vintage-tech", true ) && mStartYear < thisModelYear ) {
+    static const InfoKey NEW_VINTAGE_KEY( "new-vintage-tech" );
+    if ( aTechInfo->getBoolean( NEW_VINTAGE_KEY, true ) && mStartYear < thisModelYear ) {
 
         // But don't warn if the current object has been disabled via user input
         if ( !mDisableEmControl ) {
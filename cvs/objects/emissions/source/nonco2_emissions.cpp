@@ -219,7 +219,8 @@ void NonCO2Emissions::initCalc( const string& aRegionName, const IInfo* aTechInf
     
     // Recalibrate the emissions coefficient if we have input emissions and this is
     // the initial vintage year of the technology.
-    bool shouldCalibrateEmissCoef = mInputEmissions.isInited() && aTechInfo->getBoolean( "new-vintage-tech", true );
+    static const InfoKey NEW_VINTAGE_KEY( "new-vintage-tech" );
+    bool shouldCalibrateEmissCoef = mInputEmissions.isInited() && aTechInfo->getBoolean( NEW_VINTAGE_KEY, true );
     
     for ( CControlIterator controlIt = mEmissionsControls.begin(); controlIt != mEmissionsControls.end(); ++controlIt ) {
         (*controlIt)->initCalc( aRegionName, aTechInfo, this, aPeriod );
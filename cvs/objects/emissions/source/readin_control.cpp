@@ -136,8 +136,8 @@ void ReadInControl::initCalc( const string& aRegionName,
                               const NonCO2Emissions* aParentGHG,
                               const int aPeriod )
 {
-
-    if ( aTechInfo->getBoolean( "new-vintage-tech", true ) ) {
+    static const InfoKey NEW_VINTAGE_KEY( "new-vintage-tech" );
+    if ( aTechInfo->getBoolean( NEW_VINTAGE_KEY, true ) ) {
         mTechBuildPeriod = aPeriod;
     }
 }
@@ -50,6 +50,7 @@
 #include "functions/include/inested_input.h"
 #include "util/base/include/value.h"
 #include "util/base/include/time_vector.h"
+#include "marketplace/include/cached_market.h"
 
 class IFunction;
 class SatiationDemandFunction;
@@ -434,6 +435,14 @@ protected:
 
     //! Cache the vector of children as IInput* which is needed for the mFunction
     std::vector<IInput*> mChildInputsCache;
+
+    //! The name of the internal gains trial market which is saved to avoid
+    //! rebuilding it during every model evaluation.
+    std::string mInternalGainsTrialMarketName;
+
+    //! The internal gains trial market located during initCalc so that it can
+    //! be accessed during calc without name lookups.
+    CachedMarket mInternalGainsMarket;
                        
     typedef std::vector<INestedInput*>::iterator NestedInputIterator;
     typedef std::vector<INestedInput*>::const_iterator CNestedInputIterator;
@@ -50,6 +50,7 @@
 #include "functions/include/aproduction_function.h"
 
 class IInput;
+class FoodDemandInput;
 
 /*! 
  * \ingroup Objects
@@ -124,6 +125,15 @@ public:
         return 0;
     }
 private:
+    double calcDemandsAtTrialShares( const std::vector<FoodDemandInput*>& aFoodInputs,
+                                     const std::vector<double>& aAdjPrices,
+                                     const double aAdjIncome,
+                                     const std::string& aRegionName,
+                                     const int aPeriod,
+                                     std::vector<double>& aDemands,
+                                     std::vector<double>& aAlphaActual,
+                                     double& aAlphaTotal ) const;
+
     virtual double calcCapitalScaler( const InputSet& input, double aAlphaZero, double sigma,
         double capitalStock, const int aPeriod ) const
     {
@@ -50,6 +50,7 @@
 #include "functions/include/inested_input.h"
 #include "util/base/include/value.h"
 #include "util/base/include/time_vector.h"
+#include "marketplace/include/cached_market.h"
 
 /*!
 * \ingroup Objects
@@ -93,7 +94,12 @@
 *          trial value market for each of the two goods (staple and
 *          nonstaple foods) in the system.  The GCAM solver mechanism
 *          will use these to solve for self-consistent demand
-*          values.
+*          values.  Alternatively, if the configuration flag
+*          solve-food-shares-locally is set, no trial markets are
+*          created and the FoodDemandFunction instead iterates the
+*          budget fractions to a fixed point within each demand
+*          calculation, which removes two markets per region from
+*          the solver.
 *
 *          The \f$\alpha\f$ values can range from 0 to 1; and we ask
 *          the solver keep to values within this range.
@@ -133,6 +139,11 @@ public:
     void setActualShare( double aShare,
                          const std::string& aRegionName,
                          const int aPeriod );
+
+    void setTrialShare( double aShare,
+                        const int aPeriod );
+
+    static bool isLocalShareSolve();
     
     double getRegionalBias( const int aPeriod ) const;
 
@@ -383,6 +394,10 @@ protected:
 
         //! The actual share of the total budget (alpha)
         DEFINE_VARIABLE( ARRAY | STATE | NOT_PARSABLE, "share", mShare, objects::PeriodVector<Value> ),
+
+        //! The trial share of the total budget when the shares are solved
+        //! locally by the FoodDemandFunction instead of with trial markets
+        DEFINE_VARIABLE( ARRAY | STATE | NOT_PARSABLE, "local-trial-share", mLocalTrialShare, objects::PeriodVector<Value> ),
                             
         //! Regional bias correction term
         DEFINE_VARIABLE( ARRAY | STATE, "regional-bias", mRegionalBias, objects::PeriodVector<Value> ),
@@ -396,6 +411,14 @@ protected:
         DEFINE_VARIABLE( SIMPLE | NOT_PARSABLE, "subregional-income-share", mCurrentSubregionalIncomeShare, Value )
 
     )
+
+    //! The name of the trial share market which is saved to avoid rebuilding it
+    //! during every model evaluation.
+    std::string mTrialShareMarketName;
+
+    //! The trial share market located during initCalc so that it can be
+    //! accessed during calc without name lookups.
+    CachedMarket mTrialShareMarket;
                            
     void copy( const FoodDemandInput& aNodeInput );
 };
@@ -43,6 +43,7 @@
  * \brief IDiscreteChoice class declaration file
  * \author Robert Link
  */
+#include <vector>
 #include <boost/core/noncopyable.hpp>
 
 #include "util/base/include/data_definition_util.h"
@@ -127,6 +128,25 @@ public:
     virtual double calcUnnormalizedShare( const double aShareWeight, const double aValue,
                                           const int aPeriod ) const = 0;
 
+    /*!
+     * \brief Compute the unnormalized shares of a set of options at once.
+     * \details Equivalent to calling calcUnnormalizedShare for each option
+     *          however the calculation is done over contiguous arrays so that
+     *          the log and exp terms may be vectorized.  The result is added to
+     *          aLogShares so that callers may include additional terms, such as
+     *          from fuel preference elasticities, which can then be normalized
+     *          with SectorUtils::normalizeLogShares.
+     * \param aShareWeights The weighting term of each option.
+     * \param aValues The value of each option.
+     * \param aLogShares The additional log share term of each option on input
+     *                   and the log of the unnormalized shares on output.
+     * \param aPeriod The current model period.
+     */
+    virtual void calcUnnormalizedShares( const std::vector<double>& aShareWeights,
+                                         const std::vector<double>& aValues,
+                                         std::vector<double>& aLogShares,
+                                         const int aPeriod ) const = 0;
+
     /*!
      * \brief Compute the mean value according the the discrete choice function's
      *        parameterization.
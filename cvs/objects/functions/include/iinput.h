@@ -51,6 +51,7 @@
 #include "util/base/include/ivisitable.h"
 #include "util/base/include/aparsable.h"
 #include "util/base/include/data_definition_util.h"
+#include "util/base/include/object_arena.h"
 
 class Tabs;
 class ICaptureComponent;
@@ -79,7 +80,7 @@ class TrackingNonEnergyInput;
  * \details
  * \author Josh Lurz
  */
-class IInput: public INamed, public IVisitable, public AParsable, private boost::noncopyable {
+class IInput: public INamed, public IVisitable, public AParsable, public ArenaAllocated, private boost::noncopyable {
 public:
     /*!
      * \brief Define different type attributes of inputs. These are not mutually
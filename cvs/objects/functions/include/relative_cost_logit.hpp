@@ -92,6 +92,11 @@ public:
     virtual double calcUnnormalizedShare( const double aShareWeight, const double aValue,
                                           const int aPeriod ) const;
 
+    virtual void calcUnnormalizedShares( const std::vector<double>& aShareWeights,
+                                         const std::vector<double>& aValues,
+                                         std::vector<double>& aLogShares,
+                                         const int aPeriod ) const;
+
     virtual double calcAverageValue( const double aUnnormalizedShareSum,
                                      const double aLogShareFac,
                                      const int aPeriod ) const;
@@ -42,6 +42,8 @@
 #include <math.h>
 #include <cassert>
 #include <string>
+#include <limits>
+#include <Eigen/Core>
 #include <numeric>
 
 #include "functions/include/absolute_cost_logit.hpp"
@@ -127,6 +129,43 @@ double AbsoluteCostLogit::calcUnnormalizedShare( const double aShareWeight, cons
     return logShareWeight + mLogitExponent[ aPeriod ] * aValue / mBaseValue;
 }
 
+/*!
+ * \brief Compute the unnormalized shares of a set of options at once.
+ * \details The logit exponent is looked up once and the log terms are
+ *          calculated over the whole array.
+ * \param aShareWeights The weighting term of each option.
+ * \param aValues The value of each option.
+ * \param aLogShares The additional log share term of each option on input
+ *                   and the log of the unnormalized shares on output.
+ * \param aPeriod The current model period.
+ * \sa calcUnnormalizedShare
+ */
+void AbsoluteCostLogit::calcUnnormalizedShares( const std::vector<double>& aShareWeights,
+                                                const std::vector<double>& aValues,
+                                                std::vector<double>& aLogShares,
+                                                const int aPeriod ) const
+{
+    /*!
+     * \pre A valid base cost has been set.
+     */
+    assert( mBaseValue > 0 );
+
+    /*!
+     * \pre There is one share weight, value, and log share for each option.
+     */
+    assert( aShareWeights.size() == aValues.size() && aLogShares.size() == aValues.size() );
+
+    const Eigen::Index numOptions = aValues.size();
+    Eigen::Map<const Eigen::ArrayXd> shareWeights( aShareWeights.data(), numOptions );
+    Eigen::Map<const Eigen::ArrayXd> values( aValues.data(), numOptions );
+    Eigen::Map<Eigen::ArrayXd> logShares( aLogShares.data(), numOptions );
+
+    // Zero share weight implies no share which is signaled by negative infinity.
+    const double minInf = -std::numeric_limits<double>::infinity();
+    logShares += ( shareWeights > 0.0 ).select( shareWeights.log(), minInf )
+        + mLogitExponent[ aPeriod ] * values / mBaseValue;
+}
+
 double AbsoluteCostLogit::calcAverageValue( const double aUnnormalizedShareSum,
                                            const double aLogShareFac,
                                            const int aPeriod ) const
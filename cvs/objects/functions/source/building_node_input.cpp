@@ -153,6 +153,9 @@ void BuildingNodeInput::initCalc( const string& aRegionName,
                                       aIsTrade, aTechInfo, aPeriod );
         mChildInputsCache.push_back( *nestedInputIter );
     }
+
+    mInternalGainsTrialMarketName = SectorUtils::getTrialMarketName( mInternalGainsMarketname );
+    mInternalGainsMarket = SectorUtils::locateTrialMarket( aRegionName, mInternalGainsMarketname );
 }
 
 void BuildingNodeInput::copyParam( const IInput* aInput,
@@ -317,7 +320,7 @@ Value BuildingNodeInput::getFloorToSurfaceRatio( const int aPeriod ) const {
  * \return Internal gains in the given period.
  */
 double BuildingNodeInput::getInternalGains( const string& aRegionName, const int aPeriod ) const {
-    return SectorUtils::getTrialSupply( aRegionName, mInternalGainsMarketname, aPeriod );
+    return SectorUtils::getTrialSupply( mInternalGainsMarket, aRegionName, mInternalGainsTrialMarketName, aPeriod );
 }
 
 /*!
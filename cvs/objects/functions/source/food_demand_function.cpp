@@ -127,25 +127,44 @@ double FoodDemandFunction::calcDemand( InputSet& aInput, double income, const st
     double adjIncome = foodInputs[ 0 ]->getSubregionalIncome( aRegionName, aPeriod ) / priceMaterials;
 
     // calculate demands
-    double demandMaterials = adjIncome;
-    double alphaTotal = 0.0;
     vector<double> alphaActual( aInput.size() );
     vector<double> demands( aInput.size() );
-    for( size_t i = 0; i < aInput.size(); ++i ) {
-        // calculate the first part of the equation: A * x^h(x) (note calcIncomeTerm will
-        // calculate all of x^h(x) as there is implicitly a scale term included there)
-        double currDemand = foodInputs[i]->getRegionalBias( aPeriod ) + foodInputs[i]->getScaleParam() * foodInputs[i]->calcIncomeTerm( adjIncome );
-        // calculate the price terms of the equations MULT_j(w_j ^ e_ij(x))
-        for( size_t j = 0; j < aInput.size(); ++j ) {
-            currDemand *= pow( adjPricesCapped[j], foodInputs[i]->calcPriceExponent( foodInputs[j], adjIncome, aRegionName, aPeriod ) );
+    double alphaTotal = 0.0;
+    double demandMaterials = calcDemandsAtTrialShares( foodInputs, adjPricesCapped, adjIncome, aRegionName,
+                                                       aPeriod, demands, alphaActual, alphaTotal );
+
+    // When the budget shares are not being solved by trial markets we must
+    // resolve the circular dependence here by iterating on the shares until
+    // the trial values used in the price exponents match the actual shares.
+    // The shares only enter through the price exponents which are typically
+    // scaled by small budget fractions so a simple fixed point iteration
+    // converges quickly.
+    if( FoodDemandInput::isLocalShareSolve() ) {
+        const int MAX_ITERATIONS = 100;
+        const double SHARE_TOLERANCE = 1.0e-10;
+        bool isConverged = false;
+        for( int iter = 0; iter < MAX_ITERATIONS && !isConverged; ++iter ) {
+            double maxChange = 0.0;
+            for( size_t i = 0; i < aInput.size(); ++i ) {
+                maxChange = std::max( maxChange,
+                    fabs( alphaActual[i] - foodInputs[i]->getTrialShare( aRegionName, aPeriod ) ) );
+            }
+            isConverged = maxChange < SHARE_TOLERANCE;
+            if( !isConverged ) {
+                for( size_t i = 0; i < aInput.size(); ++i ) {
+                    foodInputs[i]->setTrialShare( alphaActual[i], aPeriod );
+                }
+                alphaTotal = 0.0;
+                demandMaterials = calcDemandsAtTrialShares( foodInputs, adjPricesCapped, adjIncome, aRegionName,
+                                                            aPeriod, demands, alphaActual, alphaTotal );
+            }
+        }
+        if( !isConverged ) {
+            ILogger& mainLog = ILogger::getLogger( "main_log" );
+            mainLog.setLevel( ILogger::DEBUG );
+            mainLog << "Food demand budget shares did not converge in " << aRegionName
+                    << " in period " << aPeriod << endl;
         }
-        demands[i] = currDemand;
-        // the demand for materials is just the residual of the food demand:
-        // q_m = x - SUM_i(w_i * q_i)
-        demandMaterials -= adjPricesCapped[i] * currDemand;
-        // calculate what the actual shares ended up being too
-        alphaActual[i] = adjPricesCapped[i] * currDemand / adjIncome / foodInputs[i]->getPriceScaler();
-        alphaTotal += alphaActual[i];
     }
     
     // Check budget constraint, if we're spending more than the total income.
@@ -183,3 +202,46 @@ double FoodDemandFunction::calcDemand( InputSet& aInput, double income, const st
     return demandMaterials;
 }
 
+
+/*!
+ * \brief Calculate the food demands given the current trial budget shares.
+ * \details Evaluates the demand equation for each food input, see calcDemand, at
+ *          the trial shares currently available from each FoodDemandInput.
+ * \param aFoodInputs The staple and non-staple food demand inputs.
+ * \param aAdjPrices The adjusted (and capped) prices for each input (w).
+ * \param aAdjIncome The adjusted income (x).
+ * \param aRegionName The name of the containing region.
+ * \param aPeriod The current model period.
+ * \param aDemands Output: the calculated demand for each input.
+ * \param aAlphaActual Output: the resulting actual budget share for each input.
+ * \param aAlphaTotal Output: the accumulated total of the actual budget shares.
+ * \return The "demand" for materials which is the residual from the food demands.
+ */
+double FoodDemandFunction::calcDemandsAtTrialShares( const vector<FoodDemandInput*>& aFoodInputs,
+                                                     const vector<double>& aAdjPrices,
+                                                     const double aAdjIncome,
+                                                     const string& aRegionName,
+                                                     const int aPeriod,
+                                                     vector<double>& aDemands,
+                                                     vector<double>& aAlphaActual,
+                                                     double& aAlphaTotal ) const
+{
+    double demandMaterials = aAdjIncome;
+    for( size_t i = 0; i < aFoodInputs.size(); ++i ) {
+        // calculate the first part of the equation: A * x^h(x) (note calcIncomeTerm will
+        // calculate all of x^h(x) as there is implicitly a scale term included there)
+        double currDemand = aFoodInputs[i]->getRegionalBias( aPeriod ) + aFoodInputs[i]->getScaleParam() * aFoodInputs[i]->calcIncomeTerm( aAdjIncome );
+        // calculate the price terms of the equations MULT_j(w_j ^ e_ij(x))
+        for( size_t j = 0; j < aFoodInputs.size(); ++j ) {
+            currDemand *= pow( aAdjPrices[j], aFoodInputs[i]->calcPriceExponent( aFoodInputs[j], aAdjIncome, aRegionName, aPeriod ) );
+        }
+        aDemands[i] = currDemand;
+        // the demand for materials is just the residual of the food demand:
+        // q_m = x - SUM_i(w_i * q_i)
+        demandMaterials -= aAdjPrices[i] * currDemand;
+        // calculate what the actual shares ended up being too
+        aAlphaActual[i] = aAdjPrices[i] * currDemand / aAdjIncome / aFoodInputs[i]->getPriceScaler();
+        aAlphaTotal += aAlphaActual[i];
+    }
+    return demandMaterials;
+}
@@ -52,6 +52,7 @@
 #include "sectors/include/sector_utils.h"
 #include "functions/include/function_utils.h"
 #include "containers/include/iinfo.h"
+#include "util/base/include/configuration.h"
 
 using namespace std;
 
@@ -78,33 +79,43 @@ void FoodDemandInput::completeInit( const string& aRegionName,
     MarketDependencyFinder* depFinder = scenario->getMarketplace()->getDependencyFinder();
     depFinder->addDependency( aTechName, aRegionName, mName, aRegionName );
     
+    // We set some initial trial share guess to ensure the solver starts in a
+    // reasonable range which helps speed up solution in the historical years.
+    // We could attempt to do better by calculating what the actual shares would
+    // be in the data system and read them in.  However, it turned out to be fairly
+    // involved to do and ultimately didn't help with solution much so we just stuck
+    // with the constant initial guess.
+    const double INITIAL_PRICE_GUESS = 0.1;
+
+    if( isLocalShareSolve() ) {
+        // The shares will be solved for during the demand calculation so there
+        // is no need to set up trial markets, just set the starting guess.
+        for( int period = 0; period < scenario->getModeltime()->getmaxper(); ++period ) {
+            mLocalTrialShare[ period ] = INITIAL_PRICE_GUESS;
+        }
+        return;
+    }
+    
     // Set up trial share markets
-    string trialShareMarketName = SectorUtils::getTrialMarketName( getTrialShareMarketName() );
+    mTrialShareMarketName = SectorUtils::getTrialMarketName( getTrialShareMarketName() );
     bool isNew = SectorUtils::createTrialSupplyMarket( aRegionName, getTrialShareMarketName(),
                                                        "unitless", aRegionName );
     if( !isNew ) {
         ILogger& mainLog = ILogger::getLogger( "main_log" );
         mainLog.setLevel( ILogger::WARNING );
         mainLog << "Created duplicate trial share market in " << aRegionName << " for "
-                << trialShareMarketName << endl;
+                << mTrialShareMarketName << endl;
     }
     
     
     for( int period = 0; period < scenario->getModeltime()->getmaxper(); ++period ) {
-        // We set some initial trial share guess to ensure the solver starts in a
-        // reasonable range which helps speed up solution in the historical years.
-        // We could attempt to do better by calculating what the actual shares would
-        // be in the data system and read them in.  However, it turned out to be fairly
-        // involved to do and ultimately didn't help with solution much so we just stuck
-        // with the constant initial guess.
-        const double INITIAL_PRICE_GUESS = 0.1;
-        scenario->getMarketplace()->setPrice( trialShareMarketName, aRegionName, INITIAL_PRICE_GUESS, period) ;
+        scenario->getMarketplace()->setPrice( mTrialShareMarketName, aRegionName, INITIAL_PRICE_GUESS, period) ;
         // Set meta data to let the solver know the trial share values should be between 0 and 1
         // not that it explicitly respects this but the preconditioner will.
-        SectorUtils::setSupplyBehaviorBounds( trialShareMarketName, aRegionName, 0, 1, period );
+        SectorUtils::setSupplyBehaviorBounds( mTrialShareMarketName, aRegionName, 0, 1, period );
     }
     
-    depFinder->addDependency( aTechName, aRegionName, trialShareMarketName, aRegionName );
+    depFinder->addDependency( aTechName, aRegionName, mTrialShareMarketName, aRegionName );
     
 }
 
@@ -132,6 +143,10 @@ void FoodDemandInput::initCalc( const string& aRegionName,
         // them otherwise.
         SectorUtils::fillMissingPeriodVectorInterpolated( mRegionalBias );
     }
+
+    if( !isLocalShareSolve() ) {
+        mTrialShareMarket = SectorUtils::locateTrialMarket( aRegionName, getTrialShareMarketName() );
+    }
 }
 
 void FoodDemandInput::copyParam( const IInput* aInput,
@@ -309,7 +324,8 @@ std::string FoodDemandInput::getTrialShareMarketName() const {
 
 /*!
  * \brief Get the current trial share for this food demand input.
- * \details Retrieves the current trial share value from the marketplace.
+ * \details Retrieves the current trial share value from the marketplace or
+ *          the locally iterated value if the shares are solved locally.
  * \param aRegionName The region name used to look up the market.
  * \param aPeriod The current model period.
  * \return The trial share.
@@ -318,7 +334,9 @@ double FoodDemandInput::getTrialShare( const string& aRegionName,
                                        const int aPeriod ) const
 {
     // ensure the trial share is between zero and one
-    return std::min(std::max( SectorUtils::getTrialSupply( aRegionName, getTrialShareMarketName(), aPeriod ), 0.0), 1.0);
+    const double trialShare = isLocalShareSolve() ? mLocalTrialShare[ aPeriod ].get() :
+        SectorUtils::getTrialSupply( mTrialShareMarket, aRegionName, mTrialShareMarketName, aPeriod );
+    return std::min(std::max( trialShare, 0.0), 1.0);
 }
 
 /*!
@@ -333,8 +351,40 @@ void FoodDemandInput::setActualShare( double aShare,
 {
     mShare[ aPeriod ] = aShare;
     
-    SectorUtils::addToTrialDemand( aRegionName, getTrialShareMarketName(),
-                                   mShare[ aPeriod ], aPeriod );
+    if( !isLocalShareSolve() ) {
+        SectorUtils::addToTrialDemand( mTrialShareMarket, aRegionName, mTrialShareMarketName,
+                                       mShare[ aPeriod ], aPeriod );
+    }
+}
+
+/*!
+ * \brief Set the trial share to use for this food demand input.
+ * \details Only used when the shares are solved locally by the FoodDemandFunction
+ *          in which case the trial share is the current iterate for the share.
+ * \param aShare The new trial share.
+ * \param aPeriod The current model period.
+ */
+void FoodDemandInput::setTrialShare( double aShare,
+                                     const int aPeriod )
+{
+    /*!
+     * \pre Trial shares can only be set when they are not solved by trial markets.
+     */
+    assert( isLocalShareSolve() );
+    
+    mLocalTrialShare[ aPeriod ] = aShare;
+}
+
+/*!
+ * \brief Check if the food budget shares should be solved locally.
+ * \details When the configuration flag solve-food-shares-locally is set the
+ *          self-consistent budget shares are found by iterating within the
+ *          FoodDemandFunction rather than by the solver via trial markets.
+ * \return True if the shares are solved locally.
+ */
+bool FoodDemandInput::isLocalShareSolve() {
+    const static bool isLocal = Configuration::getInstance()->getBool( "solve-food-shares-locally", false, false );
+    return isLocal;
 }
 
 /*!
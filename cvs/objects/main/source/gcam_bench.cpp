@@ -0,0 +1,550 @@
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+
+/*! 
+ * \file gcam_bench.cpp
+ * \ingroup Objects
+ * \brief Microbenchmarks of the performance critical parts of the model.
+ * \details The benchmarks set up and run a scenario through the configured
+ *          stop period and then time individual model kernels in that period
+ *          starting from the solved state.  Results are written in the JSON
+ *          format used by Google Benchmark so that runs may be compared to a
+ *          baseline with the usual tools.  The benchmarks are:
+ *          - XMLParse: parse a scenario component file into an empty scenario.
+ *          - World::calc/full: a full model evaluation.
+ *          - World::calc/partial: a partial model evaluation for a single
+ *            solved market, cycling through all of the solved markets.
+ *          - fdjac: a finite difference Jacobian of all solved markets.
+ *          - LogBroyden::bsolve: Broyden solution from displaced prices using
+ *            the Jacobian recorded by the fdjac benchmark.
+ *          - LandNode::calcLandShares: land shares of every region.
+ *          - ASimpleCarbonCalc::calc: the carbon calculation of every land leaf.
+ *          - Restart/save and Restart/load: writing and reading a restart file.
+ */
+
+#include "util/base/include/definitions.h"
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <list>
+#include <chrono>
+#include <ctime>
+#include <thread>
+#include <tuple>
+#include <cmath>
+#include <algorithm>
+
+#include "containers/include/gcam_session.h"
+#include "containers/include/scenario.h"
+#include "containers/include/world.h"
+#include "containers/include/region.h"
+#include "marketplace/include/marketplace.h"
+#include "land_allocator/include/land_allocator.h"
+#include "ccarbon_model/include/asimple_carbon_calc.h"
+#include "functions/include/idiscrete_choice.hpp"
+#include "solution/solvers/include/solver_component.h"
+#include "solution/solvers/include/logbroyden.hpp"
+#include "solution/util/include/edfun.hpp"
+#include "solution/util/include/fdjac.hpp"
+#include "solution/util/include/calc_counter.h"
+#include "solution/util/include/solution_info_set.h"
+#include "solution/util/include/solvable_nr_solution_info_filter.h"
+#include "util/base/include/configuration.h"
+#include "util/base/include/manage_state_variables.hpp"
+#include "util/base/include/model_time.h"
+#include "util/base/include/util.h"
+#include "util/base/include/version.h"
+#include "util/base/include/xml_parse_helper.h"
+#include "util/base/include/gcam_fusion.hpp"
+#include "util/base/include/gcam_data_containers.h"
+
+using namespace std;
+
+// Globals normally defined by main.cpp which the model library relies on.
+ofstream outFile;
+Scenario* scenario;
+
+namespace {
+    /*!
+     * \brief Exposes LogBroyden::bsolve so that it may be timed on its own.
+     */
+    class BenchLogBroyden : public LogBroyden {
+    public:
+        BenchLogBroyden( Marketplace* aMarketplace, World* aWorld, CalcCounter* aCalcCounter ):
+        LogBroyden( aMarketplace, aWorld, aCalcCounter ) {}
+
+        using LogBroyden::bsolve;
+    };
+
+    /*!
+     * \brief Finds the land allocators and carbon calculations to benchmark
+     *        using GCAMFusion.
+     */
+    class KernelCollector {
+    public:
+        //! The region name, root land allocator, and its discrete choice function
+        //! for every region with a land allocator.
+        vector<tuple<string, LandAllocator*, IDiscreteChoice*> > mLandAllocators;
+
+        //! Every simple carbon calculation in the land allocators.
+        vector<ASimpleCarbonCalc*> mCarbonCalcs;
+
+        template<typename DataType>
+        void processData( DataType& aData );
+        template<typename DataType>
+        void pushFilterStep( const DataType& aData );
+        template<typename DataType>
+        void popFilterStep( const DataType& aData );
+
+    private:
+        //! The name of the region currently being searched.
+        string mCurrRegionName;
+
+        //! The land allocator currently being searched.
+        LandAllocator* mCurrLandAllocator = 0;
+    };
+
+    template<typename DataType>
+    void KernelCollector::processData( DataType& aData ) {
+        // ignore most types
+    }
+
+    template<>
+    void KernelCollector::processData<IDiscreteChoice*>( IDiscreteChoice*& aData ) {
+        if( mCurrLandAllocator ) {
+            mLandAllocators.push_back( make_tuple( mCurrRegionName, mCurrLandAllocator, aData ) );
+        }
+    }
+
+    template<>
+    void KernelCollector::processData<ICarbonCalc*>( ICarbonCalc*& aData ) {
+        ASimpleCarbonCalc* carbonCalc = dynamic_cast<ASimpleCarbonCalc*>( aData );
+        if( carbonCalc ) {
+            mCarbonCalcs.push_back( carbonCalc );
+        }
+    }
+
+    template<typename DataType>
+    void KernelCollector::pushFilterStep( const DataType& aData ) {
+        // ignore most types
+    }
+
+    template<>
+    void KernelCollector::pushFilterStep<Region*>( Region* const& aData ) {
+        mCurrRegionName = aData->getName();
+    }
+
+    template<>
+    void KernelCollector::pushFilterStep<LandAllocator*>( LandAllocator* const& aData ) {
+        mCurrLandAllocator = aData;
+    }
+
+    template<typename DataType>
+    void KernelCollector::popFilterStep( const DataType& aData ) {
+        // ignore most types
+    }
+
+    template<>
+    void KernelCollector::popFilterStep<LandAllocator*>( LandAllocator* const& aData ) {
+        mCurrLandAllocator = 0;
+    }
+}
+
+/*!
+ * \brief Runs the benchmarks and records their results.
+ * \details This class is a friend of Scenario and ManageStateVariables so that
+ *          it may set up the state of a model period the same way the Scenario
+ *          does when it calculates the period and time the restart file handling.
+ */
+class GCAMBench {
+public:
+    GCAMBench( GCAMSession& aSession, const int aIterations, const string& aFilter );
+
+    bool runAll();
+
+    void printResults( ostream& aOut ) const;
+
+    void writeJSON( ostream& aOut ) const;
+
+private:
+    //! The timing of a single benchmark.
+    struct Result {
+        //! The benchmark name.
+        string mName;
+
+        //! The number of times the benchmark was run.
+        int mIterations;
+
+        //! The mean wall clock time of an iteration in milliseconds.
+        double mRealTime;
+
+        //! The mean CPU time of an iteration in milliseconds.
+        double mCPUTime;
+    };
+
+    //! The session which holds the scenario.
+    GCAMSession& mSession;
+
+    //! The number of times to run each benchmark.
+    const int mIterations;
+
+    //! Only benchmarks whose name contains this string are run.
+    const string mFilter;
+
+    //! The period in which the kernels are benchmarked.
+    int mPeriod;
+
+    //! The results of each benchmark in the order they were run.
+    vector<Result> mResults;
+
+    template<typename Function>
+    void benchmark( const string& aName, const int aIterations, Function aFunction );
+
+    void benchmarkXMLParse();
+
+    void benchmarkPeriod();
+};
+
+/*!
+ * \brief Constructor.
+ * \param aSession An initialized session.
+ * \param aIterations The number of times to run each benchmark.
+ * \param aFilter Only run benchmarks whose names contain this string.
+ */
+GCAMBench::GCAMBench( GCAMSession& aSession, const int aIterations, const string& aFilter ):
+mSession( aSession ),
+mIterations( aIterations ),
+mFilter( aFilter ),
+mPeriod( -1 )
+{
+}
+
+/*!
+ * \brief Run the scenario through the configured stop period and then run all
+ *        benchmarks which pass the filter.
+ * \return Whether the scenario could be run.
+ */
+bool GCAMBench::runAll() {
+    Scenario* benchScenario = mSession.getScenario();
+    if( !benchScenario ) {
+        return false;
+    }
+
+    // Kernels are benchmarked in the stop period which must have markets to solve.
+    const int stopPeriod = util::getConfigRunPeriod( "stop" );
+    mPeriod = stopPeriod < 0 ? benchScenario->getModeltime()->getmaxper() - 1 : stopPeriod;
+    if( mPeriod < 1 ) {
+        cerr << "The benchmark period must be after the first model period." << endl;
+        return false;
+    }
+
+    benchmarkXMLParse();
+
+    if( !mSession.run( 0, mPeriod ) ) {
+        cerr << "Warning: the scenario did not solve in all periods." << endl;
+    }
+    benchmarkPeriod();
+    return true;
+}
+
+/*!
+ * \brief Time a benchmark.
+ * \details The benchmark is skipped if its name does not pass the filter.
+ * \param aName The benchmark name.
+ * \param aIterations The number of times to call aFunction.
+ * \param aFunction The code to time which is passed the iteration number.
+ */
+template<typename Function>
+void GCAMBench::benchmark( const string& aName, const int aIterations, Function aFunction ) {
+    if( aName.find( mFilter ) == string::npos || aIterations <= 0 ) {
+        return;
+    }
+
+    const clock_t cpuStart = clock();
+    const chrono::steady_clock::time_point realStart = chrono::steady_clock::now();
+    for( int iter = 0; iter < aIterations; ++iter ) {
+        aFunction( iter );
+    }
+    const chrono::duration<double, milli> realTime = chrono::steady_clock::now() - realStart;
+    const double cpuTime = 1000.0 * static_cast<double>( clock() - cpuStart ) / CLOCKS_PER_SEC;
+
+    Result result;
+    result.mName = aName;
+    result.mIterations = aIterations;
+    result.mRealTime = realTime.count() / aIterations;
+    result.mCPUTime = cpuTime / aIterations;
+    mResults.push_back( result );
+    cout << aName << ": " << result.mRealTime << " ms" << endl;
+}
+
+/*!
+ * \brief Benchmark parsing the first scenario component into an empty scenario.
+ */
+void GCAMBench::benchmarkXMLParse() {
+    const list<string>& components = Configuration::getInstance()->getScenarioComponents();
+    if( components.empty() ) {
+        return;
+    }
+    const string& componentFile = components.front();
+
+    benchmark( "XMLParse", mIterations, [&componentFile]( int ) {
+        XMLParseHelper::initParser();
+        Scenario parsedScenario;
+        XMLParseHelper::parseXML( componentFile, &parsedScenario );
+        XMLParseHelper::cleanupParser();
+    } );
+}
+
+/*!
+ * \brief Benchmark the model kernels in the benchmark period.
+ * \details The state of the period is set up the same way Scenario::calculatePeriod
+ *          does before solving and is released when all benchmarks are done.
+ */
+void GCAMBench::benchmarkPeriod() {
+    World* world = scenario->getWorld();
+    Marketplace* marketplace = scenario->getMarketplace();
+
+    scenario->mManageStateVars = new ManageStateVariables( mPeriod );
+    marketplace->nullSuppliesAndDemands( mPeriod );
+    world->calc( mPeriod );
+
+    benchmark( "World::calc/full", mIterations, [this, world, marketplace]( int ) {
+        marketplace->nullSuppliesAndDemands( mPeriod );
+#if GCAM_PARALLEL_ENABLED
+        world->calc( mPeriod, world->getGlobalFlowGraph() );
+#else
+        world->calc( mPeriod );
+#endif
+    } );
+
+    // Set up the excess demand function for the solved markets the same way the
+    // LogBroyden solver does.
+    SolutionInfoSet solutionSet( marketplace );
+    solutionSet.init( mPeriod, 0.001, 0.0001, scenario->mSolutionInfoParamParser );
+    SolvableNRSolutionInfoFilter solvableFilter;
+    solutionSet.updateSolvable( &solvableFilter );
+    const vector<SolutionInfo>& solvables = solutionSet.getSolvableSet();
+    const int numSolvable = solvables.size();
+
+    if( numSolvable > 0 ) {
+        LogEDFun F( solutionSet, world, marketplace, mPeriod, true );
+        UBVECTOR x( numSolvable );
+        UBVECTOR fx( numSolvable );
+        list<int> allCols;
+        for( int i = 0; i < numSolvable; ++i ) {
+            x[ i ] = log( max( solvables[ i ].getPrice(), util::getTinyNumber() ) );
+            allCols.push_back( i );
+        }
+        F.scaleInitInputs( x );
+        F( x, fx );
+        const UBVECTOR solvedX( x );
+        const UBVECTOR solvedFX( fx );
+        UBMATRIX J( numSolvable, numSolvable );
+
+        scenario->mManageStateVars->setPartialDeriv( true );
+        auto partialCalc = [&]( int aIter ) {
+            jacol( F, solvedX, solvedFX, aIter % numSolvable, J, true );
+        };
+#if GCAM_PARALLEL_ENABLED
+        scenario->mManageStateVars->mThreadPool.execute( [&]() {
+            benchmark( "World::calc/partial", mIterations * numSolvable, partialCalc );
+        } );
+#else
+        benchmark( "World::calc/partial", mIterations * numSolvable, partialCalc );
+#endif
+        F.partial( -1 );
+
+        // Record the Jacobian at the solution for use by the Broyden benchmark.
+        fdjac( F, solvedX, solvedFX, J, allCols, true );
+        benchmark( "fdjac", mIterations, [&]( int ) {
+            fdjac( F, solvedX, solvedFX, J, allCols, true );
+        } );
+
+        CalcCounter calcCounter;
+        BenchLogBroyden broyden( marketplace, world, &calcCounter );
+        broyden.init();
+        benchmark( "LogBroyden::bsolve", mIterations, [&]( int ) {
+            // Start from displaced prices so that the solver has work to do.
+            for( int i = 0; i < numSolvable; ++i ) {
+                x[ i ] = solvedX[ i ] + 0.01;
+            }
+            F( x, fx );
+            UBMATRIX B( J );
+            int neval = 0;
+            broyden.bsolve( F, x, fx, B, neval, allCols );
+        } );
+
+        // Restore the solved state for the remaining benchmarks.
+        x = solvedX;
+        F( x, fx );
+    }
+
+    KernelCollector collector;
+    vector<FilterStep*> landQuery = parseFilterString( "world/region/land-allocator/discrete-choice-function" );
+    vector<FilterStep*> carbonQuery = parseFilterString( "world/region/land-allocator//carbon-calc" );
+    GCAMFusion<KernelCollector, true, true, true> findLand( collector, landQuery );
+    findLand.startFilter( scenario );
+    GCAMFusion<KernelCollector, true, true, true> findCarbon( collector, carbonQuery );
+    findCarbon.startFilter( scenario );
+    for( FilterStep* step : landQuery ) {
+        delete step;
+    }
+    for( FilterStep* step : carbonQuery ) {
+        delete step;
+    }
+
+    benchmark( "LandNode::calcLandShares", mIterations, [&]( int ) {
+        for( auto& landAllocator : collector.mLandAllocators ) {
+            get<1>( landAllocator )->calcLandShares( get<0>( landAllocator ), get<2>( landAllocator ), mPeriod );
+        }
+    } );
+
+    const int endYear = scenario->getModeltime()->getper_to_yr( mPeriod );
+    benchmark( "ASimpleCarbonCalc::calc", mIterations, [&]( int ) {
+        for( ASimpleCarbonCalc* carbonCalc : collector.mCarbonCalcs ) {
+            carbonCalc->calc( mPeriod, endYear, ICarbonCalc::eReturnTotal );
+        }
+    } );
+
+    benchmark( "Restart/save", mIterations, [this]( int ) {
+        scenario->mManageStateVars->saveRestartFile();
+    } );
+    benchmark( "Restart/load", mIterations, [this]( int ) {
+        scenario->mManageStateVars->loadRestartFile();
+    } );
+
+    delete scenario->mManageStateVars;
+    scenario->mManageStateVars = 0;
+}
+
+/*!
+ * \brief Print a summary table of the results.
+ * \param aOut The stream to write to.
+ */
+void GCAMBench::printResults( ostream& aOut ) const {
+    aOut << "Benchmark period " << mPeriod << endl;
+    aOut << "Benchmark,Iterations,Time (ms),CPU (ms)" << endl;
+    for( const Result& result : mResults ) {
+        aOut << result.mName << ',' << result.mIterations << ','
+             << result.mRealTime << ',' << result.mCPUTime << endl;
+    }
+}
+
+/*!
+ * \brief Write the results in the Google Benchmark JSON format.
+ * \param aOut The stream to write to.
+ */
+void GCAMBench::writeJSON( ostream& aOut ) const {
+    aOut << "{" << endl;
+    aOut << "  \"context\": {" << endl;
+    aOut << "    \"date\": \"" << util::XMLCreateDate( time( 0 ) ) << "\"," << endl;
+    aOut << "    \"gcam_version\": \"" << __ObjECTS_VER__ << "\"," << endl;
+    aOut << "    \"num_cpus\": " << thread::hardware_concurrency() << "," << endl;
+    aOut << "    \"benchmark_period\": " << mPeriod << "," << endl;
+#if defined( NDEBUG )
+    aOut << "    \"library_build_type\": \"release\"" << endl;
+#else
+    aOut << "    \"library_build_type\": \"debug\"" << endl;
+#endif
+    aOut << "  }," << endl;
+    aOut << "  \"benchmarks\": [" << endl;
+    for( size_t i = 0; i < mResults.size(); ++i ) {
+        const Result& result = mResults[ i ];
+        aOut << "    {" << endl;
+        aOut << "      \"name\": \"" << result.mName << "\"," << endl;
+        aOut << "      \"run_name\": \"" << result.mName << "\"," << endl;
+        aOut << "      \"run_type\": \"iteration\"," << endl;
+        aOut << "      \"iterations\": " << result.mIterations << "," << endl;
+        aOut << "      \"real_time\": " << result.mRealTime << "," << endl;
+        aOut << "      \"cpu_time\": " << result.mCPUTime << "," << endl;
+        aOut << "      \"time_unit\": \"ms\"" << endl;
+        aOut << "    }" << ( i + 1 < mResults.size() ? "," : "" ) << endl;
+    }
+    aOut << "  ]" << endl;
+    aOut << "}" << endl;
+}
+
+/*!
+ * \brief Print the command line usage message.
+ * \param aProgramName The name of the program.
+ */
+void printUsageMessage( const char* aProgramName ) {
+    cout << "Usage: " << aProgramName << " [-C configurationFileName] [-L loggerFactoryFileName]"
+         << " [--benchmark_filter=substring] [--benchmark_iterations=N] [--benchmark_out=file.json]" << endl;
+}
+
+//! Main program for the benchmarks.
+int main( int argc, char* argv[] ) {
+    string configurationArg = "configuration_bench.xml";
+    string loggerFactoryArg = "log_conf.xml";
+    string filter;
+    string outFileName = "gcam-bench.json";
+    int iterations = 5;
+    for( int i = 1; i < argc; ++i ) {
+        const string arg( argv[ i ] );
+        if( ( arg == "-C" || arg == "-L" ) && i + 1 < argc ) {
+            ( arg == "-C" ? configurationArg : loggerFactoryArg ) = argv[ ++i ];
+        }
+        else if( arg.compare( 0, 19, "--benchmark_filter=" ) == 0 ) {
+            filter = arg.substr( 19 );
+        }
+        else if( arg.compare( 0, 23, "--benchmark_iterations=" ) == 0 ) {
+            iterations = atoi( arg.substr( 23 ).c_str() );
+        }
+        else if( arg.compare( 0, 16, "--benchmark_out=" ) == 0 ) {
+            outFileName = arg.substr( 16 );
+        }
+        else {
+            cout << "Invalid argument: " << arg << endl;
+            printUsageMessage( argv[ 0 ] );
+            return 1;
+        }
+    }
+
+    GCAMSession session;
+    if( !session.initialize( configurationArg, loggerFactoryArg ) ) {
+        return 1;
+    }
+
+    GCAMBench bench( session, iterations, filter );
+    if( !bench.runAll() ) {
+        return 1;
+    }
+
+    bench.printResults( cout );
+    ofstream jsonFile( outFileName.c_str() );
+    bench.writeJSON( jsonFile );
+    return 0;
+}
@@ -0,0 +1,305 @@
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+
+/*! 
+ * \file gcam_session_server.cpp
+ * \ingroup Objects
+ * \brief A program which exposes a GCAMSession over a local Unix domain socket.
+ * \details The server accepts one client connection at a time.  Each request is
+ *          a single line consisting of a command followed by space separated
+ *          arguments and each response is a single line starting with either
+ *          OK or ERR.  The commands are:
+ *          - APPLY-XML <bytes> followed by exactly that many bytes of add-on XML.
+ *          - APPLY-FILE <file name>
+ *          - SET-POLICY <policy name> <market> <tax in each period>...
+ *          - RUN <from period> <to period>
+ *          - QUERY <GCAMFusion search string>, which responds with the values found.
+ *          - SAVE, which responds with the saved state ID.
+ *          - RESET <saved state ID>
+ *          - CLOSE, to end the connection.
+ *          - SHUTDOWN, to end the connection and stop the server.
+ */
+
+#include "util/base/include/definitions.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "containers/include/gcam_session.h"
+#include "containers/include/scenario.h"
+
+using namespace std;
+
+// Globals normally defined by main.cpp which the model library relies on.
+ofstream outFile;
+Scenario* scenario;
+
+namespace {
+    /*!
+     * \brief Buffered reading and writing on a connected socket.
+     */
+    class Connection {
+    public:
+        explicit Connection( const int aSocket ):mSocket( aSocket ) {}
+
+        ~Connection() {
+            close( mSocket );
+        }
+
+        /*!
+         * \brief Read up to the next newline, which is not included.
+         * \param aLine [out] The line read.
+         * \return False if the connection was closed first.
+         */
+        bool readLine( string& aLine ) {
+            aLine.clear();
+            char curr;
+            while( readBytes( &curr, 1 ) ) {
+                if( curr == '\n' ) {
+                    return true;
+                }
+                aLine.push_back( curr );
+            }
+            return false;
+        }
+
+        /*!
+         * \brief Read exactly the given number of bytes.
+         * \param aData [out] The buffer to read into.
+         * \param aSize The number of bytes to read.
+         * \return False if the connection was closed first.
+         */
+        bool readBytes( char* aData, size_t aSize ) {
+            while( aSize > 0 ) {
+                if( mBufferPos == mBuffer.size() ) {
+                    mBuffer.resize( 4096 );
+                    const ssize_t received = recv( mSocket, &mBuffer[ 0 ], mBuffer.size(), 0 );
+                    if( received <= 0 ) {
+                        mBuffer.clear();
+                        mBufferPos = 0;
+                        return false;
+                    }
+                    mBuffer.resize( received );
+                    mBufferPos = 0;
+                }
+                const size_t count = min( aSize, mBuffer.size() - mBufferPos );
+                copy( mBuffer.begin() + mBufferPos, mBuffer.begin() + mBufferPos + count, aData );
+                mBufferPos += count;
+                aData += count;
+                aSize -= count;
+            }
+            return true;
+        }
+
+        /*!
+         * \brief Write a response line.
+         * \param aLine The line to write without a trailing newline.
+         */
+        void writeLine( const string& aLine ) {
+            const string data = aLine + "\n";
+            size_t sent = 0;
+            while( sent < data.size() ) {
+                const ssize_t count = send( mSocket, data.data() + sent, data.size() - sent, 0 );
+                if( count <= 0 ) {
+                    return;
+                }
+                sent += count;
+            }
+        }
+
+    private:
+        //! The connected socket.
+        const int mSocket;
+
+        //! Data received but not yet read.
+        vector<char> mBuffer;
+
+        //! The position of the next byte to read in mBuffer.
+        size_t mBufferPos = 0;
+    };
+
+    /*!
+     * \brief Handle requests from a client until it disconnects.
+     * \param aSession The session to operate on.
+     * \param aConnection The client connection.
+     * \return Whether the client requested the server shut down.
+     */
+    bool serveClient( GCAMSession& aSession, Connection& aConnection ) {
+        string line;
+        while( aConnection.readLine( line ) ) {
+            istringstream request( line );
+            string command;
+            request >> command;
+
+            if( command == "APPLY-XML" ) {
+                size_t size = 0;
+                request >> size;
+                string content( size, '\0' );
+                if( size > 0 && !aConnection.readBytes( &content[ 0 ], size ) ) {
+                    return false;
+                }
+                aConnection.writeLine( aSession.applyXMLString( content ) ? "OK" : "ERR apply failed" );
+            }
+            else if( command == "APPLY-FILE" ) {
+                string fileName;
+                getline( request >> ws, fileName );
+                aConnection.writeLine( aSession.applyXMLFile( fileName ) ? "OK" : "ERR apply failed" );
+            }
+            else if( command == "SET-POLICY" ) {
+                string policyName;
+                string market;
+                request >> policyName >> market;
+                vector<double> taxes;
+                double tax;
+                while( request >> tax ) {
+                    taxes.push_back( tax );
+                }
+                aConnection.writeLine( aSession.setPolicyValues( policyName, market, taxes ) ?
+                                       "OK" : "ERR set policy failed" );
+            }
+            else if( command == "RUN" ) {
+                int fromPeriod = -1;
+                int toPeriod = -1;
+                request >> fromPeriod >> toPeriod;
+                aConnection.writeLine( aSession.run( fromPeriod, toPeriod ) ? "OK" : "ERR run failed" );
+            }
+            else if( command == "QUERY" ) {
+                string queryPath;
+                getline( request >> ws, queryPath );
+                ostringstream response;
+                response.precision( 17 );
+                response << "OK";
+                const vector<double> values = aSession.query( queryPath );
+                for( vector<double>::const_iterator iter = values.begin(); iter != values.end(); ++iter ) {
+                    response << ' ' << *iter;
+                }
+                aConnection.writeLine( response.str() );
+            }
+            else if( command == "SAVE" ) {
+                aConnection.writeLine( "OK " + to_string( aSession.saveState() ) );
+            }
+            else if( command == "RESET" ) {
+                int stateID = -1;
+                request >> stateID;
+                aConnection.writeLine( aSession.resetState( stateID ) ? "OK" : "ERR reset failed" );
+            }
+            else if( command == "CLOSE" ) {
+                aConnection.writeLine( "OK" );
+                return false;
+            }
+            else if( command == "SHUTDOWN" ) {
+                aConnection.writeLine( "OK" );
+                return true;
+            }
+            else {
+                aConnection.writeLine( "ERR unknown command " + command );
+            }
+        }
+        return false;
+    }
+}
+
+/*!
+ * \brief Print the command line usage message.
+ * \param aProgramName The name of the program.
+ */
+void printUsageMessage( const char* aProgramName ) {
+    cout << "Usage: " << aProgramName << " -S socketPath [-C configurationFileName] [-L loggerFactoryFileName]" << endl;
+}
+
+//! Main program for the session server.
+int main( int argc, char* argv[] ) {
+    string configurationArg = "configuration.xml";
+    string loggerFactoryArg = "log_conf.xml";
+    string socketPath;
+    for( int i = 1; i + 1 < argc; i += 2 ) {
+        const string flag( argv[ i ] );
+        if( flag == "-C" ) {
+            configurationArg = argv[ i + 1 ];
+        }
+        else if( flag == "-L" ) {
+            loggerFactoryArg = argv[ i + 1 ];
+        }
+        else if( flag == "-S" ) {
+            socketPath = argv[ i + 1 ];
+        }
+        else {
+            cout << "Invalid argument: " << flag << endl;
+            printUsageMessage( argv[ 0 ] );
+            return 1;
+        }
+    }
+
+    sockaddr_un address = sockaddr_un();
+    address.sun_family = AF_UNIX;
+    if( socketPath.empty() || socketPath.size() >= sizeof( address.sun_path ) ) {
+        printUsageMessage( argv[ 0 ] );
+        return 1;
+    }
+    socketPath.copy( address.sun_path, socketPath.size() );
+
+    GCAMSession session;
+    if( !session.initialize( configurationArg, loggerFactoryArg ) ) {
+        return 1;
+    }
+
+    const int listenSocket = socket( AF_UNIX, SOCK_STREAM, 0 );
+    unlink( socketPath.c_str() );
+    if( listenSocket < 0
+        || bind( listenSocket, reinterpret_cast<sockaddr*>( &address ), sizeof( address ) ) != 0
+        || listen( listenSocket, 1 ) != 0 )
+    {
+        cerr << "Could not listen on " << socketPath << endl;
+        return 1;
+    }
+
+    bool isShutdown = false;
+    while( !isShutdown ) {
+        const int clientSocket = accept( listenSocket, 0, 0 );
+        if( clientSocket < 0 ) {
+            continue;
+        }
+        Connection connection( clientSocket );
+        isShutdown = serveClient( session, connection );
+    }
+
+    close( listenSocket );
+    unlink( socketPath.c_str() );
+    return 0;
+}
@@ -147,6 +147,9 @@ public:
     double getRawSupply() const;
     virtual double getSupply() const;
     virtual void addToSupply( const double supplyIn );
+#if GCAM_PARALLEL_ENABLED
+    virtual void reduceContributions();
+#endif
     
     const std::string& getName() const;
     const std::string& getRegionName() const;
@@ -233,6 +236,16 @@ protected:
     
     //! A fast lock to protect concurrent adds to supply.
     mutable Mutex mSupplyMutex;
+    
+    //! Demand added during a parallel World.calc in deterministic mode which has
+    //! not yet been summed into mDemand, paired with the calculation order of the
+    //! activity which added it.
+    std::vector<std::pair<int, double> > mDemandContributions;
+    
+    //! Supply added during a parallel World.calc in deterministic mode which has
+    //! not yet been summed into mSupply, paired with the calculation order of the
+    //! activity which added it.
+    std::vector<std::pair<int, double> > mSupplyContributions;
 #endif
     
     //! Object containing information related to the market.
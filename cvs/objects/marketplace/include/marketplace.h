@@ -50,10 +50,15 @@
 #include <memory>
 #include <boost/core/noncopyable.hpp>
 
+#include "util/base/include/definitions.h"
 #include "marketplace/include/imarket_type.h"
 #include "util/base/include/ivisitable.h"
 #include "util/base/include/data_definition_util.h"
 
+#if GCAM_PARALLEL_ENABLED
+#include "tbb/spin_mutex.h"
+#endif
+
 class Tabs;
 class Market;
 class MarketContainer;
@@ -62,6 +67,7 @@ class IVisitor;
 class IInfo;
 class CachedMarket;
 class MarketDependencyFinder;
+class WarmStartStore;
 class Value;
 namespace objects {
     template<typename T>
@@ -192,11 +198,29 @@ public:
     //! The price to return if no market exists.
     const static double NO_MARKET_PRICE;
     
+    //! Flag indicating whether parallel calculations should give results which
+    //! are bitwise identical regardless of the number of threads, as set by the
+    //! deterministic-parallel configuration flag.
+    static bool mIsDeterministicCalc;
+    
+    //! The position in the global ordering of the activity this thread is
+    //! calculating during a deterministic parallel World.calc, otherwise -1.
+    //! Markets defer supplies and demands added while it is set so that they
+    //! can be summed in this order.
+    static thread_local int sCalcOrder;
+    
+#if GCAM_PARALLEL_ENABLED
+    void reduceContributions( const int aPeriod );
+#endif
+    
     void store_prices_for_cost_calculation();
     void restore_prices_for_cost_calculation();
     
     MarketDependencyFinder* getDependencyFinder() const;
 
+    const WarmStartStore* getWarmStartStore() const;
+    void storeWarmStart( const std::string& aScenarioName, const int aPeriod );
+
     // The methods from here down are diagnostics
     std::vector<double> fullstate( int period ) const; //!< Return all supplies and demands in all markets in a single vector
     bool checkstate(int period, const std::vector<double>&, std::ostream *log=0, unsigned tol=0) const;
@@ -221,9 +245,22 @@ protected:
     //! sorted global ordering or get an inorder list of model activities that are
     //! affected by changing the price of a single market.
     std::unique_ptr<MarketDependencyFinder> mDependencyFinder;
+
+    //! Solved prices from prior runs used to seed initial prices, null unless
+    //! the warmStartFileName has been flagged to be written.
+    std::unique_ptr<WarmStartStore> mWarmStartStore;
     
     //! Flag indicating whether the next call to world->calc() will be part of a partial derivative calculation 
     static bool mIsDerivativeCalc;
+
+    std::vector<Market*> getMarketsInPeriod( const int aPeriod ) const;
+    
+#if GCAM_PARALLEL_ENABLED
+    //! Mutex serializing changes to market prices and solve flags made outside
+    //! of partial derivative calculations, such as when regions are initialized
+    //! in parallel and may share a market.
+    tbb::spin_mutex mMarketWriteMutex;
+#endif
 };
 
 #endif
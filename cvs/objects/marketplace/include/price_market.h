@@ -78,6 +78,9 @@ public:
     virtual double getSupply() const;
     virtual double getSolverSupply() const;
     virtual void addToSupply( const double supplyIn );
+#if GCAM_PARALLEL_ENABLED
+    virtual void reduceContributions();
+#endif
     
     virtual bool meetsSpecialSolutionCriteria() const;
     virtual bool shouldSolve() const;
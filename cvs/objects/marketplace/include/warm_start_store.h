@@ -0,0 +1,135 @@
+#ifndef _WARM_START_STORE_H_
+#define _WARM_START_STORE_H_
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+
+
+/*! 
+* \file warm_start_store.h
+* \ingroup Objects
+* \brief The WarmStartStore class header file.
+*/
+
+#include <vector>
+#include <map>
+#include <string>
+
+class Market;
+
+/*!
+* \ingroup Objects
+* \brief An on disk store of solved market prices which is used to give the
+*        solver a better starting point in closely related scenarios.
+* \details Each time a period solves the prices of the markets solved in that
+*          period are appended to the warmStartFileName file as a record keyed
+*          by the scenario name and the model period.  Each record also holds a
+*          set of features which describe the conditions the period was solved
+*          under: the exogenous policy prices (unsolved TAX and RES markets) in
+*          the period and the prices of the solved markets in the previous
+*          period.
+*
+*          Before a period is solved the record from the same period whose
+*          features are closest to the current ones is selected and its prices
+*          are used as the initial guesses in place of the forecasted prices.
+*          The spread of prices amongst the nearest few records is used to set
+*          the bracket interval for each market so that the first bracketing
+*          step reaches the edge of the range historically solved to.
+*
+*          Records written by runs earlier in the same process are visible to
+*          later runs since the file is re-read each time a store is created.
+* \sa Marketplace::init_to_last
+*/
+class WarmStartStore
+{
+public:
+    WarmStartStore();
+
+    static bool isEnabled();
+
+    void seedPrices( const std::vector<Market*>& aMarkets,
+                     const std::vector<Market*>& aPrevMarkets,
+                     const int aPeriod );
+
+    double getBracketInterval( const std::string& aMarketName, const int aPeriod ) const;
+
+    void addRecord( const std::string& aScenarioName,
+                    const std::vector<Market*>& aMarkets,
+                    const std::vector<Market*>& aPrevMarkets,
+                    const int aPeriod );
+
+private:
+    //! A mapping of market name to a value such as a price.
+    typedef std::map<std::string, double> MarketValueMap;
+
+    /*!
+     * \brief A solution to a single period of a prior run.
+     */
+    struct Record {
+        //! The name of the scenario which produced this record.
+        std::string mScenarioName;
+
+        //! The model period solved.
+        int mPeriod;
+
+        //! Values which describe the conditions the period was solved under.
+        MarketValueMap mFeatures;
+
+        //! The solved prices by market name.
+        MarketValueMap mPrices;
+    };
+
+    //! All records which have been loaded or added.
+    std::vector<Record> mRecords;
+
+    //! The period for which bracket intervals were last calculated.
+    int mSeededPeriod;
+
+    //! Bracket intervals by market name calculated when seeding prices.
+    MarketValueMap mBracketIntervals;
+
+    //! The number of nearest records to use to estimate the bracket intervals.
+    static const unsigned int NUM_NEIGHBORS = 3;
+
+    void load();
+
+    static MarketValueMap calcFeatures( const std::vector<Market*>& aMarkets,
+                                        const std::vector<Market*>& aPrevMarkets );
+
+    static double calcDistance( const MarketValueMap& aLeft, const MarketValueMap& aRight );
+};
+
+#endif // _WARM_START_STORE_H_
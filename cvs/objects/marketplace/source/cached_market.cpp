@@ -283,7 +283,14 @@ double CachedMarket::getSupply( const string& aGoodName, const string& aRegionNa
     assert( aPeriod == mPeriod );
     
     if ( mCachedMarket ) {
-        return mCachedMarket->getMarket( aPeriod )->getSupply();
+        Market* market = mCachedMarket->getMarket( aPeriod );
+#if GCAM_PARALLEL_ENABLED
+        if( Marketplace::sCalcOrder != -1 ) {
+            // Include the contributions made so far in this deterministic calc.
+            market->reduceContributions();
+        }
+#endif
+        return market->getSupply();
     }
     
     ILogger& mainLog = ILogger::getLogger( "main_log" );
@@ -319,7 +326,14 @@ double CachedMarket::getDemand(  const string& aGoodName, const string& aRegionN
     assert( aPeriod == mPeriod );
     
     if ( mCachedMarket ) {
-        return mCachedMarket->getMarket( aPeriod )->getDemand();
+        Market* market = mCachedMarket->getMarket( aPeriod );
+#if GCAM_PARALLEL_ENABLED
+        if( Marketplace::sCalcOrder != -1 ) {
+            // Include the contributions made so far in this deterministic calc.
+            market->reduceContributions();
+        }
+#endif
+        return market->getDemand();
     }
     
     ILogger& mainLog = ILogger::getLogger( "main_log" );
@@ -87,6 +87,34 @@ inline void kahanSum(Value& aSum, Value& aCorrection, const double aValueIn) {
     aSum = t;
 }
 
+#if GCAM_PARALLEL_ENABLED
+/*!
+ * \brief Sum contributions which were deferred during a deterministic parallel
+ *        World.calc in the order of the activities which made them.
+ * \details The sort is stable so that multiple contributions from the same
+ *          activity are summed in the order it made them.  The resulting sum
+ *          then no longer depends on the order in which threads happened to
+ *          finish.
+ * \param aContributions The deferred contributions paired with the calculation
+ *                       order of the activity which made each, cleared on return.
+ * \param aSum The running sum Value to update.
+ * \param aCorrection The error correction term for aSum.
+ */
+inline void reduceInOrder( std::vector<std::pair<int, double> >& aContributions, Value& aSum, Value& aCorrection ) {
+    if( aContributions.empty() ) {
+        return;
+    }
+    std::stable_sort( aContributions.begin(), aContributions.end(),
+                 []( const std::pair<int, double>& aLHS, const std::pair<int, double>& aRHS ) {
+                     return aLHS.first < aRHS.first;
+                 } );
+    for( const std::pair<int, double>& contribution : aContributions ) {
+        kahanSum( aSum, aCorrection, contribution.second );
+    }
+    aContributions.clear();
+}
+#endif
+
 using namespace std;
 using namespace objects;
 
@@ -354,7 +382,13 @@ void Market::addToDemand( const double demandIn ) {
 #if GCAM_PARALLEL_ENABLED
     if( !Marketplace::mIsDerivativeCalc ) {
         Mutex::scoped_lock writeLock( mDemandMutex );
-        kahanSum(mDemand, mDemandCorrection, demandIn);
+        if( Marketplace::sCalcOrder != -1 ) {
+            // deterministic mode, defer the sum until reduceContributions
+            mDemandContributions.push_back( make_pair( Marketplace::sCalcOrder, demandIn ) );
+        }
+        else {
+            kahanSum(mDemand, mDemandCorrection, demandIn);
+        }
     }
     else {
         kahanSum(mDemand, mDemandCorrection, demandIn);
@@ -443,7 +477,13 @@ void Market::addToSupply( const double supplyIn ) {
 #if GCAM_PARALLEL_ENABLED
     if( !Marketplace::mIsDerivativeCalc ) {
         Mutex::scoped_lock writeLock( mSupplyMutex );
-        kahanSum(mSupply, mSupplyCorrection, supplyIn);
+        if( Marketplace::sCalcOrder != -1 ) {
+            // deterministic mode, defer the sum until reduceContributions
+            mSupplyContributions.push_back( make_pair( Marketplace::sCalcOrder, supplyIn ) );
+        }
+        else {
+            kahanSum(mSupply, mSupplyCorrection, supplyIn);
+        }
     }
     else {
         kahanSum(mSupply, mSupplyCorrection, supplyIn);
@@ -453,6 +493,25 @@ void Market::addToSupply( const double supplyIn ) {
 #endif
 }
 
+#if GCAM_PARALLEL_ENABLED
+/*!
+ * \brief Sum any supply and demand deferred during a deterministic parallel
+ *        World.calc into the market.
+ * \details Contributions are summed in the order of the activities which made
+ *          them rather than the order in which they arrived.  This must be
+ *          called before supply or demand is read for the sums to be complete.
+ * \sa Marketplace::reduceContributions
+ */
+void Market::reduceContributions() {
+    {
+        Mutex::scoped_lock writeLock( mDemandMutex );
+        reduceInOrder( mDemandContributions, mDemand, mDemandCorrection );
+    }
+    Mutex::scoped_lock writeLock( mSupplyMutex );
+    reduceInOrder( mSupplyContributions, mSupply, mSupplyCorrection );
+}
+#endif
+
 /*! \brief Return the market name.
  * \details This function returns the name of the market, as defined by region
  *          name plus good name.
@@ -58,7 +58,9 @@
 #include "util/base/include/fltcmp.hpp"
 #include "util/base/include/time_vector.h"
 #include "util/logger/include/ilogger.h"
+#include "util/base/include/debug_filter.h"
 #include "marketplace/include/market_locator.h"
+#include "marketplace/include/warm_start_store.h"
 #include "util/base/include/ivisitor.h"
 #include "containers/include/iinfo.h"
 #include "marketplace/include/cached_market.h"
@@ -70,6 +72,8 @@ using namespace std;
 extern Scenario* scenario;
 const double Marketplace::NO_MARKET_PRICE = util::getLargeNumber();
 bool Marketplace::mIsDerivativeCalc = false;
+bool Marketplace::mIsDeterministicCalc = false;
+thread_local int Marketplace::sCalcOrder = -1;
 
 /*! \brief Default constructor 
 *
@@ -80,7 +84,8 @@ bool Marketplace::mIsDerivativeCalc = false;
 */
 Marketplace::Marketplace():
 mMarketLocator( new MarketLocator() ),
-mDependencyFinder( new MarketDependencyFinder( this ) )
+mDependencyFinder( new MarketDependencyFinder( this ) ),
+mWarmStartStore( WarmStartStore::isEnabled() ? new WarmStartStore() : 0 )
 {
 }
 
@@ -127,13 +132,10 @@ void Marketplace::toDebugXML( const int period, ostream& out, Tabs* tabs ) const
     XMLWriteElement( static_cast<int>( mMarkets.size() ), "numberOfMarkets", out, tabs );
 
     // Write out the individual markets
-    const static string debugRegion =
-        Configuration::getInstance()->getString( "debug-region", "USA" );
-
     for( unsigned int i = 0; i < mMarkets.size(); i++ ){
         // TODO: This isn't quite right. This should search the contained
         // region list.
-        if( mMarkets[ i ]->getMarket( period )->getRegionName() == debugRegion ||
+        if( DebugFilter::isDebugRegion( mMarkets[ i ]->getMarket( period )->getRegionName() ) ||
             mMarkets[ i ]->getMarket( period )->getRegionName() == "global" )
         {
             mMarkets[ i ]->getMarket( period )->toDebugXML( period, out, tabs );
@@ -378,6 +380,9 @@ void Marketplace::setMarketToSolve ( const string& goodName, const string& regio
 
     // If the market exists.
     if ( marketNumber != MarketLocator::MARKET_NOT_FOUND ) {
+#if GCAM_PARALLEL_ENABLED
+        tbb::spin_mutex::scoped_lock writeLock( mMarketWriteMutex );
+#endif
         mMarkets[ marketNumber ]->getMarket( per )->setSolveMarket( true );
     }
     else {
@@ -406,6 +411,9 @@ void Marketplace::unsetMarketToSolve ( const string& goodName, const string& reg
 
     // If the market exists.
     if ( marketNumber != MarketLocator::MARKET_NOT_FOUND ) {
+#if GCAM_PARALLEL_ENABLED
+        tbb::spin_mutex::scoped_lock writeLock( mMarketWriteMutex );
+#endif
         mMarkets[ marketNumber ]->getMarket( per )->setSolveMarket( false );
         mMarkets[ marketNumber ]->getMarket( per )->nullSupply();
         mMarkets[ marketNumber ]->getMarket( per )->nullDemand();
@@ -502,7 +510,18 @@ void Marketplace::setPrice( const string& goodName, const string& regionName, co
 
     const int marketNumber = mMarketLocator->getMarketNumber( regionName, goodName );
     if ( marketNumber != MarketLocator::MARKET_NOT_FOUND ) {
+#if GCAM_PARALLEL_ENABLED
+        // Partial derivatives only change the scratch state of the calling thread.
+        if( !mIsDerivativeCalc ) {
+            tbb::spin_mutex::scoped_lock writeLock( mMarketWriteMutex );
+            mMarkets[ marketNumber ]->getMarket( per )->setPrice( value );
+        }
+        else {
+            mMarkets[ marketNumber ]->getMarket( per )->setPrice( value );
+        }
+#else
         mMarkets[ marketNumber ]->getMarket( per )->setPrice( value );
+#endif
     }
     else if( aMustExist ){
         ILogger& mainLog = ILogger::getLogger( "main_log" );
@@ -587,6 +606,22 @@ void Marketplace::addToDemand( const string& goodName, const string& regionName,
     }
 }
 
+#if GCAM_PARALLEL_ENABLED
+/*!
+ * \brief Sum the supplies and demands deferred by every market during a
+ *        deterministic parallel World.calc.
+ * \details Called once the calculation has finished so that the solver and
+ *          any reporting see the complete sums.
+ * \param aPeriod The period which was calculated.
+ * \sa Market::reduceContributions
+ */
+void Marketplace::reduceContributions( const int aPeriod ) {
+    for( auto marketContainer : mMarkets ) {
+        marketContainer->getMarket( aPeriod )->reduceContributions();
+    }
+}
+#endif
+
 /*! \brief Return the market price. 
 *
 * This function uses a market type dependent function to find the price for a market determined by
@@ -632,7 +667,14 @@ double Marketplace::getSupply( const string& goodName, const string& regionName,
     const int marketNumber = mMarketLocator->getMarketNumber( regionName, goodName );
 
     if ( marketNumber != MarketLocator::MARKET_NOT_FOUND ) {
-        return mMarkets[ marketNumber ]->getMarket( per )->getSupply();
+        Market* market = mMarkets[ marketNumber ]->getMarket( per );
+#if GCAM_PARALLEL_ENABLED
+        if( Marketplace::sCalcOrder != -1 ) {
+            // Include the contributions made so far in this deterministic calc.
+            market->reduceContributions();
+        }
+#endif
+        return market->getSupply();
     }
 
     ILogger& mainLog = ILogger::getLogger( "main_log" );
@@ -656,7 +698,14 @@ double Marketplace::getDemand(  const string& goodName, const string& regionName
     const int marketNumber = mMarketLocator->getMarketNumber( regionName, goodName );
 
     if ( marketNumber != MarketLocator::MARKET_NOT_FOUND ) {
-        return mMarkets[ marketNumber ]->getMarket( per )->getDemand();
+        Market* market = mMarkets[ marketNumber ]->getMarket( per );
+#if GCAM_PARALLEL_ENABLED
+        if( Marketplace::sCalcOrder != -1 ) {
+            // Include the contributions made so far in this deterministic calc.
+            market->reduceContributions();
+        }
+#endif
+        return market->getDemand();
     }
 
     ILogger& mainLog = ILogger::getLogger( "main_log" );
@@ -724,6 +773,12 @@ void Marketplace::init_to_last( const int period ) {
             // We don't need to do anything further with it here.
             mMarkets[ i ]->forecastDemand( period );
         }
+
+        // Replace the forecasted prices with those from a similar prior run
+        // when one is available.
+        if( mWarmStartStore.get() ) {
+            mWarmStartStore->seedPrices( getMarketsInPeriod( period ), getMarketsInPeriod( period - 1 ), period );
+        }
     }
 }
 
@@ -897,6 +952,41 @@ MarketDependencyFinder* Marketplace::getDependencyFinder() const {
     return mDependencyFinder.get();
 }
 
+/*!
+ * \brief Get the store of solved prices from prior runs.
+ * \return The warm start store or null if it is not enabled.
+ */
+const WarmStartStore* Marketplace::getWarmStartStore() const {
+    return mWarmStartStore.get();
+}
+
+/*!
+ * \brief Add the solved prices of the given period to the warm start store.
+ * \details Does nothing if the warm start store is not enabled.
+ * \param aScenarioName The name of the scenario which was solved.
+ * \param aPeriod The model period which was solved.
+ */
+void Marketplace::storeWarmStart( const string& aScenarioName, const int aPeriod ) {
+    if( mWarmStartStore.get() ) {
+        mWarmStartStore->addRecord( aScenarioName, getMarketsInPeriod( aPeriod ),
+                                    aPeriod > 0 ? getMarketsInPeriod( aPeriod - 1 ) : vector<Market*>(),
+                                    aPeriod );
+    }
+}
+
+/*!
+ * \brief Get all markets in the given period indexed by market number.
+ * \param aPeriod The model period.
+ * \return The markets in the period.
+ */
+vector<Market*> Marketplace::getMarketsInPeriod( const int aPeriod ) const {
+    vector<Market*> markets( mMarkets.size() );
+    for( unsigned int i = 0; i < mMarkets.size(); ++i ) {
+        markets[ i ] = mMarkets[ i ]->getMarket( aPeriod );
+    }
+    return markets;
+}
+
 /*!
  * \brief Get the full state of the marketplace.
  * \param period The model period.
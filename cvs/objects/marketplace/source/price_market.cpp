@@ -129,6 +129,13 @@ void PriceMarket::addToSupply( const double supplyIn ) {
     mDemandMarketPointer->addToSupply( supplyIn );
 }
 
+#if GCAM_PARALLEL_ENABLED
+void PriceMarket::reduceContributions() {
+    // Supply and demand are all added to the companion DemandMarket.
+    mDemandMarketPointer->reduceContributions();
+}
+#endif
+
 bool PriceMarket::meetsSpecialSolutionCriteria() const {
     return Market::meetsSpecialSolutionCriteria();
 }
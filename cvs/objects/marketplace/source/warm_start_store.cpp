@@ -0,0 +1,367 @@
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+
+/*! 
+* \file warm_start_store.cpp
+* \ingroup Objects
+* \brief WarmStartStore class source file.
+*/
+
+#include "util/base/include/definitions.h"
+#include <fstream>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+#include "marketplace/include/warm_start_store.h"
+#include "marketplace/include/market.h"
+#include "util/base/include/configuration.h"
+#include "util/base/include/util.h"
+#include "util/logger/include/ilogger.h"
+
+using namespace std;
+
+const unsigned int WarmStartStore::NUM_NEIGHBORS;
+
+/*! \brief Constructor
+* \details Loads all records previously written to the warmStartFileName.
+*/
+WarmStartStore::WarmStartStore():
+mSeededPeriod( -1 )
+{
+    load();
+}
+
+/*!
+ * \brief Check the configuration to see if the warm start store was requested.
+ * \details Unlike most output files this one must be explicitly turned on.
+ * \return True if the warmStartFileName has been flagged to be written.
+ */
+bool WarmStartStore::isEnabled() {
+    return Configuration::getInstance()->shouldWriteFile( "warmStartFileName", false );
+}
+
+/*!
+ * \brief Set the initial prices of the solved markets from the nearest record.
+ * \details The record for the same period whose features are closest to the
+ *          current ones is selected.  If it is within warm-start-max-distance
+ *          the prices of the markets it contains which are solved in this period
+ *          are set as their initial prices.  Bracket intervals are calculated
+ *          from the spread of prices in the nearest few records and may then be
+ *          retrieved with getBracketInterval.
+ * \param aMarkets The markets in the period to seed, indexed by market number.
+ * \param aPrevMarkets The markets in the previous period, indexed by market number.
+ * \param aPeriod The model period to seed.
+ */
+void WarmStartStore::seedPrices( const vector<Market*>& aMarkets,
+                                 const vector<Market*>& aPrevMarkets,
+                                 const int aPeriod )
+{
+    mSeededPeriod = aPeriod;
+    mBracketIntervals.clear();
+
+    const MarketValueMap features = calcFeatures( aMarkets, aPrevMarkets );
+    vector<pair<double, const Record*> > candidates;
+    for( const Record& record : mRecords ) {
+        if( record.mPeriod == aPeriod ) {
+            candidates.push_back( make_pair( calcDistance( features, record.mFeatures ), &record ) );
+        }
+    }
+
+    ILogger& solverLog = ILogger::getLogger( "solver_log" );
+    solverLog.setLevel( ILogger::NOTICE );
+    const double maxDistance = Configuration::getInstance()->getDouble( "warm-start-max-distance", 0.1, false );
+    if( candidates.empty() ) {
+        solverLog << "No warm start records found for period " << aPeriod << "." << endl;
+        return;
+    }
+    const unsigned int numNeighbors = min( static_cast<unsigned int>( candidates.size() ), NUM_NEIGHBORS );
+    partial_sort( candidates.begin(), candidates.begin() + numNeighbors, candidates.end(),
+                  []( const pair<double, const Record*>& aLeft, const pair<double, const Record*>& aRight ) {
+                      return aLeft.first < aRight.first;
+                  } );
+    if( candidates.front().first > maxDistance ) {
+        solverLog << "Nearest warm start record for period " << aPeriod << " from scenario "
+                  << candidates.front().second->mScenarioName << " is too distant to use: "
+                  << candidates.front().first << "." << endl;
+        return;
+    }
+
+    const Record& nearest = *candidates.front().second;
+    unsigned int numSeeded = 0;
+    for( Market* market : aMarkets ) {
+        if( !market->isSolvable() ) {
+            continue;
+        }
+        MarketValueMap::const_iterator priceIter = nearest.mPrices.find( market->getName() );
+        if( priceIter == nearest.mPrices.end() ) {
+            continue;
+        }
+        const double price = priceIter->second;
+        market->set_price_to_last( price );
+        ++numSeeded;
+
+        // The bracket interval is a relative step so only calculate one when
+        // the prices from the neighbors are strictly positive.
+        double lowPrice = price;
+        double highPrice = price;
+        for( unsigned int i = 1; i < numNeighbors; ++i ) {
+            MarketValueMap::const_iterator neighborIter = candidates[ i ].second->mPrices.find( market->getName() );
+            if( neighborIter != candidates[ i ].second->mPrices.end() ) {
+                lowPrice = min( lowPrice, neighborIter->second );
+                highPrice = max( highPrice, neighborIter->second );
+            }
+        }
+        if( lowPrice > util::getSmallNumber() ) {
+            const double interval = max( highPrice / price, price / lowPrice ) - 1.0;
+            if( interval > util::getSmallNumber() ) {
+                mBracketIntervals[ market->getName() ] = interval;
+            }
+        }
+    }
+    solverLog << "Seeded " << numSeeded << " prices for period " << aPeriod
+              << " from the warm start record of scenario " << nearest.mScenarioName
+              << " at distance " << candidates.front().first << "." << endl;
+}
+
+/*!
+ * \brief Get the bracket interval calculated for a market when seeding prices.
+ * \param aMarketName The name of the market.
+ * \param aPeriod The model period.
+ * \return The bracket interval or zero if none was calculated for the market
+ *         in the given period.
+ */
+double WarmStartStore::getBracketInterval( const string& aMarketName, const int aPeriod ) const {
+    if( aPeriod != mSeededPeriod ) {
+        return 0;
+    }
+    MarketValueMap::const_iterator iter = mBracketIntervals.find( aMarketName );
+    return iter != mBracketIntervals.end() ? iter->second : 0;
+}
+
+/*!
+ * \brief Add a record of the solved prices for a period and append it to the
+ *        warmStartFileName.
+ * \details Any record already held for the same scenario and period is
+ *          replaced.
+ * \param aScenarioName The name of the scenario which was solved.
+ * \param aMarkets The markets in the solved period, indexed by market number.
+ * \param aPrevMarkets The markets in the previous period, indexed by market number.
+ * \param aPeriod The model period which was solved.
+ */
+void WarmStartStore::addRecord( const string& aScenarioName,
+                                const vector<Market*>& aMarkets,
+                                const vector<Market*>& aPrevMarkets,
+                                const int aPeriod )
+{
+    Record record;
+    record.mScenarioName = aScenarioName;
+    record.mPeriod = aPeriod;
+    record.mFeatures = calcFeatures( aMarkets, aPrevMarkets );
+    for( const Market* market : aMarkets ) {
+        if( market->isSolvable() ) {
+            record.mPrices[ market->getName() ] = market->getPrice();
+        }
+    }
+
+    const string& fileName = Configuration::getInstance()->getFile( "warmStartFileName", "warm-start.csv" );
+    ofstream file( fileName.c_str(), ios::app );
+    if( !file ) {
+        ILogger& mainLog = ILogger::getLogger( "main_log" );
+        mainLog.setLevel( ILogger::WARNING );
+        mainLog << "Could not open warm start file " << fileName << " for writing." << endl;
+    }
+    else {
+        file.precision( numeric_limits<double>::max_digits10 );
+        const string prefix = aScenarioName + "," + util::toString( aPeriod ) + ",";
+        file << prefix << "record,," << 0 << '\n';
+        for( const auto& feature : record.mFeatures ) {
+            file << prefix << "feature," << feature.first << "," << feature.second << '\n';
+        }
+        for( const auto& price : record.mPrices ) {
+            file << prefix << "price," << price.first << "," << price.second << '\n';
+        }
+    }
+
+    auto sameRecord = [&record]( const Record& aOther ) {
+        return aOther.mPeriod == record.mPeriod && aOther.mScenarioName == record.mScenarioName;
+    };
+    vector<Record>::iterator existing = find_if( mRecords.begin(), mRecords.end(), sameRecord );
+    if( existing != mRecords.end() ) {
+        *existing = record;
+    }
+    else {
+        mRecords.push_back( record );
+    }
+}
+
+/*!
+ * \brief Read all records from the warmStartFileName.
+ * \details Each line has the form scenario,period,type,market,value where type
+ *          is one of record, feature, or price.  A record line starts a new
+ *          record for the scenario and period replacing any read previously so
+ *          that the latest solution of a scenario is used.  A missing file is
+ *          not an error since it will be created once the first period solves.
+ */
+void WarmStartStore::load() {
+    const string& fileName = Configuration::getInstance()->getFile( "warmStartFileName", "warm-start.csv" );
+    ifstream file( fileName.c_str() );
+    if( !file ) {
+        return;
+    }
+
+    map<pair<string, int>, unsigned int> recordIndex;
+    string line;
+    unsigned int numBadLines = 0;
+    while( getline( file, line ) ) {
+        if( line.empty() || line[ 0 ] == '#' ) {
+            continue;
+        }
+        // The market name may not contain a comma however to be safe the value
+        // is always taken to be after the last one.
+        const size_t first = line.find( ',' );
+        const size_t second = first == string::npos ? string::npos : line.find( ',', first + 1 );
+        const size_t third = second == string::npos ? string::npos : line.find( ',', second + 1 );
+        const size_t last = line.rfind( ',' );
+        if( third == string::npos || last <= third ) {
+            ++numBadLines;
+            continue;
+        }
+        const pair<string, int> key( line.substr( 0, first ),
+                                     atoi( line.substr( first + 1, second - first - 1 ).c_str() ) );
+        const string type = line.substr( second + 1, third - second - 1 );
+        const string marketName = line.substr( third + 1, last - third - 1 );
+        const double value = atof( line.substr( last + 1 ).c_str() );
+
+        map<pair<string, int>, unsigned int>::iterator indexIter = recordIndex.find( key );
+        if( type == "record" ) {
+            Record record;
+            record.mScenarioName = key.first;
+            record.mPeriod = key.second;
+            if( indexIter != recordIndex.end() ) {
+                mRecords[ indexIter->second ] = record;
+            }
+            else {
+                recordIndex[ key ] = mRecords.size();
+                mRecords.push_back( record );
+            }
+        }
+        else if( indexIter == recordIndex.end() ) {
+            ++numBadLines;
+        }
+        else if( type == "feature" ) {
+            mRecords[ indexIter->second ].mFeatures[ marketName ] = value;
+        }
+        else if( type == "price" ) {
+            mRecords[ indexIter->second ].mPrices[ marketName ] = value;
+        }
+        else {
+            ++numBadLines;
+        }
+    }
+
+    ILogger& mainLog = ILogger::getLogger( "main_log" );
+    mainLog.setLevel( numBadLines == 0 ? ILogger::NOTICE : ILogger::WARNING );
+    mainLog << "Read " << mRecords.size() << " warm start records from " << fileName;
+    if( numBadLines > 0 ) {
+        mainLog << " skipping " << numBadLines << " malformed lines";
+    }
+    mainLog << "." << endl;
+}
+
+/*!
+ * \brief Calculate the features which describe the conditions a period is
+ *        solved under.
+ * \details The features are the prices of the policy markets which are not
+ *          solved, such as fixed carbon taxes, and the previous period prices
+ *          of the markets which are solved.  All of these are known before the
+ *          period is solved.
+ * \param aMarkets The markets in the period, indexed by market number.
+ * \param aPrevMarkets The markets in the previous period, indexed by market
+ *                     number, or empty if there is no previous period.
+ * \return The features by name.
+ */
+WarmStartStore::MarketValueMap WarmStartStore::calcFeatures( const vector<Market*>& aMarkets,
+                                                             const vector<Market*>& aPrevMarkets )
+{
+    MarketValueMap features;
+    for( unsigned int i = 0; i < aMarkets.size(); ++i ) {
+        const Market* market = aMarkets[ i ];
+        if( market->isSolvable() ) {
+            if( i < aPrevMarkets.size() ) {
+                features[ market->getName() ] = aPrevMarkets[ i ]->getPrice();
+            }
+        }
+        else if( market->getType() == IMarketType::TAX || market->getType() == IMarketType::RES ) {
+            features[ "policy " + market->getName() ] = market->getPrice();
+        }
+    }
+    return features;
+}
+
+/*!
+ * \brief Calculate the distance between two sets of features.
+ * \details The distance is the mean squared relative difference over all
+ *          features in either set.  A feature which is missing from one of the
+ *          sets contributes the maximum difference of one.
+ * \param aLeft The first set of features.
+ * \param aRight The second set of features.
+ * \return The distance between the features.
+ */
+double WarmStartStore::calcDistance( const MarketValueMap& aLeft, const MarketValueMap& aRight ) {
+    double sumSquares = 0;
+    unsigned int count = 0;
+    MarketValueMap::const_iterator leftIter = aLeft.begin();
+    MarketValueMap::const_iterator rightIter = aRight.begin();
+    // Both maps are sorted by name so walk them together to find the union.
+    while( leftIter != aLeft.end() || rightIter != aRight.end() ) {
+        ++count;
+        if( rightIter == aRight.end() || ( leftIter != aLeft.end() && leftIter->first < rightIter->first ) ) {
+            sumSquares += 1.0;
+            ++leftIter;
+        }
+        else if( leftIter == aLeft.end() || rightIter->first < leftIter->first ) {
+            sumSquares += 1.0;
+            ++rightIter;
+        }
+        else {
+            const double scale = max( max( fabs( leftIter->second ), fabs( rightIter->second ) ),
+                                      util::getSmallNumber() );
+            const double relDiff = min( fabs( leftIter->second - rightIter->second ) / scale, 1.0 );
+            sumSquares += relDiff * relDiff;
+            ++leftIter;
+            ++rightIter;
+        }
+    }
+    return count == 0 ? 0 : sumSquares / count;
+}
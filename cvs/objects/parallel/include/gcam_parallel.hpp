@@ -47,6 +47,7 @@
 // Forward declare when possible
 class IActivity;
 class MarketDependencyFinder;
+class NumaRegionScheduler;
 
 /*!
  * \brief Class to package all of the information we need to carry around to use the flow graph
@@ -77,6 +78,10 @@ public:
     ~GcamFlowGraph();
     //! The model period which will be calculated when called.
     static int mPeriod;
+    
+    //! When set the calculations of activities will be run in the task arena
+    //! of the NUMA node their region has been assigned to, null otherwise.
+    static NumaRegionScheduler* mRegionScheduler;
 };
 
 class GcamParallel {
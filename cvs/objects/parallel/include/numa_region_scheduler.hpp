@@ -0,0 +1,160 @@
+#ifndef _NUMA_REGION_SCHEDULER_HPP_
+#define _NUMA_REGION_SCHEDULER_HPP_
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+
+/*!
+ * \file numa_region_scheduler.hpp
+ * \ingroup Objects
+ * \brief The NumaRegionScheduler class header file.
+ */
+
+#include "util/base/include/definitions.h"
+
+#if GCAM_PARALLEL_ENABLED
+#include <vector>
+#include <map>
+#include <string>
+#include <memory>
+#include <atomic>
+#include <cstdint>
+#include <boost/noncopyable.hpp>
+
+/* TBB headers */
+#include <tbb/task_arena.h>
+#include <tbb/tick_count.h>
+
+class ILogger;
+
+/*!
+ * \ingroup Objects
+ * \brief Partitions regions across the NUMA nodes of the machine and runs the
+ *        calculations of each region in a task arena bound to its home node.
+ * \details One tbb::task_arena is created per NUMA node reported by TBB and
+ *          each region is assigned a home node in a round robin fashion in the
+ *          order the regions were read in.  The flow graph nodes for activities
+ *          located in a region are then executed in the home arena of that region
+ *          so that the region's objects stay in the caches and memory of a single
+ *          socket.  TBB moves idle worker threads between arenas as demand
+ *          requires so work is only stolen across nodes when a node runs out of
+ *          work of its own.  Region completeInit is also run in the home arena
+ *          so that the memory first touched while initializing a region is
+ *          placed on its home node.
+ *
+ *          The time spent calculating in each arena is accumulated so that the
+ *          utilization of each node may be reported.
+ *
+ *          This mode is opt-in through the numa-region-scheduling configuration
+ *          flag.  When TBB can not detect the NUMA topology a single unconstrained
+ *          arena is used which is equivalent to the default scheduling.
+ */
+class NumaRegionScheduler : private boost::noncopyable {
+public:
+    NumaRegionScheduler();
+    ~NumaRegionScheduler();
+
+    static bool isEnabled();
+
+    void addRegion( const std::string& aRegionName );
+
+    int getHomeNode( const std::string& aRegionName ) const;
+
+    template<typename FunctorType>
+    void execute( const int aNode, const FunctorType& aFunctor );
+
+    void addWallTime( const double aSeconds );
+
+    void printUtilization( ILogger& aLog, const int aPeriod );
+
+private:
+    /*!
+     * \brief The arena and bookkeeping for a single NUMA node.
+     */
+    struct NodeArena {
+        //! The NUMA node id as reported by TBB, -1 if unknown.
+        int mNumaID;
+
+        //! The task arena whose threads are bound to this node.
+        tbb::task_arena mArena;
+
+        //! The names of the regions whose home is this node.
+        std::vector<std::string> mRegions;
+
+        //! The total time in nanoseconds spent calculating in this arena since
+        //! the last utilization report.
+        std::atomic<uint64_t> mBusyNanoseconds;
+
+        //! The number of activities calculated in this arena since the last
+        //! utilization report.
+        std::atomic<uint64_t> mNumCalculated;
+
+        NodeArena( const int aNumaID );
+    };
+
+    //! One arena per NUMA node.
+    std::vector<std::unique_ptr<NodeArena> > mNodes;
+
+    //! A lookup from region name to the index of its home node in mNodes.
+    std::map<std::string, int> mRegionToNode;
+
+    //! The total wall clock time in seconds spent in World.calc since the last
+    //! utilization report.
+    double mWallSeconds;
+};
+
+/*!
+ * \brief Run the given functor in the arena of the given node.
+ * \details The calling thread will block until the functor has completed.  If
+ *          the caller is already running in that arena the functor is simply
+ *          called directly.
+ * \param aNode The index of the node as returned by getHomeNode.
+ * \param aFunctor The functor to call which takes no arguments.
+ */
+template<typename FunctorType>
+void NumaRegionScheduler::execute( const int aNode, const FunctorType& aFunctor ) {
+    NodeArena& node = *mNodes[ aNode ];
+    node.mArena.execute( [&node, &aFunctor]() {
+        const tbb::tick_count start = tbb::tick_count::now();
+        aFunctor();
+        node.mBusyNanoseconds += static_cast<uint64_t>( ( tbb::tick_count::now() - start ).seconds() * 1e9 );
+        ++node.mNumCalculated;
+    } );
+}
+
+#endif // GCAM_PARALLEL_ENABLED
+
+#endif // _NUMA_REGION_SCHEDULER_HPP_
@@ -36,13 +36,16 @@
 #include <cassert>
 #include <vector>
 #include <list>
+#include <unordered_map>
 #include <Eigen/SparseCore>
 /* gcam headers */
 #include "parallel/include/gcam_parallel.hpp"
+#include "parallel/include/numa_region_scheduler.hpp"
 #include "util/base/include/configuration.h"
 #include "containers/include/world.h"
 #include "containers/include/iactivity.h"
 #include "containers/include/market_dependency_finder.h"
+#include "marketplace/include/marketplace.h"
 #include "util/logger/include/ilogger.h"
 #include "util/base/include/timer.h"
 #include "util/base/include/auto_file.h"
@@ -55,8 +58,28 @@
 using namespace std;
 
 int GcamFlowGraph::mPeriod = 0;
+NumaRegionScheduler* GcamFlowGraph::mRegionScheduler = 0;
 tbb::global_control* GcamFlowGraph::mParallelismConfig = 0;
 
+/*!
+ * \brief Calculate an activity from the flow graph.
+ * \details When in deterministic mode the supplies and demands the activity adds
+ *          are tagged with its position in the global ordering so that markets
+ *          sum them in that order regardless of which thread finished first.
+ *          The previous tag is restored afterwards as the thread may have
+ *          picked up this activity while waiting within another one.
+ * \param aActivity The activity to calculate.
+ * \param aCalcOrder The position of the activity in the global ordering.
+ */
+inline void calcActivity( IActivity* aActivity, const int aCalcOrder ) {
+    const int prevCalcOrder = Marketplace::sCalcOrder;
+    if( Marketplace::mIsDeterministicCalc ) {
+        Marketplace::sCalcOrder = aCalcOrder;
+    }
+    aActivity->calc( GcamFlowGraph::mPeriod );
+    Marketplace::sCalcOrder = prevCalcOrder;
+}
+
 /*
  * \brief Default constructor.
  * \details We lookup the "max-parallelism", aka number of cores to use, from the
@@ -158,11 +181,31 @@ void GcamParallel::makeTBBFlowGraph( const MarketDependencyFinder& aDependencyFi
     // apparently can not be copied so we hang on to them with a pointer
     vector<continue_node<continue_msg>*>& tbbVert = aTBBGraph.mTBBVertices;
     tbbVert.reserve( calcVertexList.size() );
+    NumaRegionScheduler* scheduler = GcamFlowGraph::mRegionScheduler;
+    // the position of each activity in the global ordering which fixes the order
+    // market contributions are summed in deterministic mode
+    unordered_map<const IActivity*, int> calcOrder;
+    for( size_t i = 0; i < globalOrdering.size(); ++i ) {
+        calcOrder[ globalOrdering[ i ] ] = static_cast<int>( i );
+    }
     for( MarketDependencyFinder::CalcVertex* vert : calcVertexList ) {
         IActivity* activity = vert->mCalcItem;
-        tbbVert.push_back(new continue_node<continue_msg>(tbbFlowGraph, [activity](continue_msg) {
-            activity->calc(GcamFlowGraph::mPeriod);
-        }));
+        const int order = calcOrder[ activity ];
+        const int homeNode = scheduler ? scheduler->getHomeNode( vert->mDepItem->mLocatedInRegion ) : -1;
+        if( homeNode != -1 ) {
+            // route the calculation to the arena of the NUMA node which holds
+            // the region's objects
+            tbbVert.push_back(new continue_node<continue_msg>(tbbFlowGraph, [activity, order, scheduler, homeNode](continue_msg) {
+                scheduler->execute( homeNode, [activity, order]() {
+                    calcActivity( activity, order );
+                } );
+            }));
+        }
+        else {
+            tbbVert.push_back(new continue_node<continue_msg>(tbbFlowGraph, [activity, order](continue_msg) {
+                calcActivity( activity, order );
+            }));
+        }
     }
     // now create the edges
     for (int k=0; k<adjMatrix.outerSize(); ++k) {
@@ -0,0 +1,152 @@
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+
+/*!
+ * \file numa_region_scheduler.cpp
+ * \ingroup Objects
+ * \brief NumaRegionScheduler class source file.
+ */
+
+#include "util/base/include/definitions.h"
+
+#if GCAM_PARALLEL_ENABLED
+#include <tbb/info.h>
+
+#include "parallel/include/numa_region_scheduler.hpp"
+#include "util/base/include/configuration.h"
+#include "util/logger/include/ilogger.h"
+
+using namespace std;
+
+/*!
+ * \brief Constructor which creates an arena constrained to the given NUMA node.
+ * \param aNumaID The NUMA node id as reported by TBB.
+ */
+NumaRegionScheduler::NodeArena::NodeArena( const int aNumaID ):
+mNumaID( aNumaID ),
+mArena( tbb::task_arena::constraints( aNumaID ) ),
+mBusyNanoseconds( 0 ),
+mNumCalculated( 0 )
+{
+}
+
+/*!
+ * \brief Constructor which creates one task arena for each NUMA node.
+ */
+NumaRegionScheduler::NumaRegionScheduler():
+mWallSeconds( 0 )
+{
+    for( tbb::numa_node_id numaID : tbb::info::numa_nodes() ) {
+        mNodes.push_back( unique_ptr<NodeArena>( new NodeArena( numaID ) ) );
+    }
+
+    ILogger& mainLog = ILogger::getLogger( "main_log" );
+    mainLog.setLevel( ILogger::NOTICE );
+    mainLog << "Scheduling region calculations across " << mNodes.size() << " NUMA node(s)." << endl;
+}
+
+//! Destructor
+NumaRegionScheduler::~NumaRegionScheduler() {
+}
+
+/*!
+ * \brief Check if NUMA aware region scheduling has been requested.
+ * \return True if the numa-region-scheduling configuration flag is set.
+ */
+bool NumaRegionScheduler::isEnabled() {
+    return Configuration::getInstance()->getBool( "numa-region-scheduling", false );
+}
+
+/*!
+ * \brief Assign a home node to the given region.
+ * \details Nodes are assigned in a round robin fashion so this should be called
+ *          in the same order as the regions are stored in the World to get a
+ *          consistent partitioning.
+ * \param aRegionName The name of the region to add.
+ */
+void NumaRegionScheduler::addRegion( const string& aRegionName ) {
+    const int node = mRegionToNode.size() % mNodes.size();
+    if( mRegionToNode.insert( make_pair( aRegionName, node ) ).second ) {
+        mNodes[ node ]->mRegions.push_back( aRegionName );
+    }
+}
+
+/*!
+ * \brief Get the home node of the given region.
+ * \param aRegionName The name of the region.
+ * \return The index of the home node to pass to execute or -1 if the region
+ *         has not been added in which case the caller should not change arena.
+ */
+int NumaRegionScheduler::getHomeNode( const string& aRegionName ) const {
+    map<string, int>::const_iterator iter = mRegionToNode.find( aRegionName );
+    return iter != mRegionToNode.end() ? ( *iter ).second : -1;
+}
+
+/*!
+ * \brief Add to the total wall clock time spent calculating the model.
+ * \details This is used as the denominator of the utilization report.
+ * \param aSeconds The wall clock time of a single World.calc.
+ */
+void NumaRegionScheduler::addWallTime( const double aSeconds ) {
+    mWallSeconds += aSeconds;
+}
+
+/*!
+ * \brief Write the utilization of each node since the last report and reset
+ *        the counters.
+ * \details Utilization is the time spent calculating in the arena of a node
+ *          relative to the wall clock time spent in World.calc multiplied by the
+ *          number of threads the arena may use.
+ * \param aLog The logger to write to.
+ * \param aPeriod The model period which was just calculated.
+ */
+void NumaRegionScheduler::printUtilization( ILogger& aLog, const int aPeriod ) {
+    aLog.setLevel( ILogger::NOTICE );
+    aLog << "NUMA node utilization for period " << aPeriod << " over " << mWallSeconds
+         << " seconds of World.calc:" << endl;
+    for( size_t nodeInd = 0; nodeInd < mNodes.size(); ++nodeInd ) {
+        NodeArena& node = *mNodes[ nodeInd ];
+        const double busySeconds = static_cast<double>( node.mBusyNanoseconds ) / 1e9;
+        const int concurrency = node.mArena.max_concurrency();
+        const double utilization = mWallSeconds > 0 ? busySeconds / ( mWallSeconds * concurrency ) : 0;
+        aLog << "    node " << nodeInd << " (numa id " << node.mNumaID << "): "
+             << node.mRegions.size() << " regions, " << concurrency << " threads, "
+             << node.mNumCalculated << " activities, " << busySeconds << " busy seconds, "
+             << ( utilization * 100 ) << "% utilized" << endl;
+        node.mBusyNanoseconds = 0;
+        node.mNumCalculated = 0;
+    }
+    mWallSeconds = 0;
+}
+
+#endif // GCAM_PARALLEL_ENABLED
@@ -119,6 +119,7 @@ public:
     virtual void completeInit( const std::string& aRegionName );
     virtual bool isApplicable( const std::string& aRegion ) const;
     virtual void setConstraint( const std::vector<double>& aConstraint );
+    virtual void hashPeriodInputs( const int aPeriod, std::size_t& aSeed ) const;
 protected:
     
     // Define data such that introspection utilities can process the data from this
@@ -79,6 +79,7 @@ public:
     virtual void completeInit( const std::string& aRegionName );
     virtual bool isApplicable( const std::string& aRegion ) const;
     virtual void setConstraint( const std::vector<double>& aConstraint );
+    virtual void hashPeriodInputs( const int aPeriod, std::size_t& aSeed ) const;
 protected:
     
     DEFINE_DATA(
@@ -101,6 +102,8 @@ protected:
     )
     
     void copy( const GHGPolicy& aOther );
+
+    static void hashValue( const Value& aValue, std::size_t& aSeed );
 };
 
 #endif // _POLICY_GHG_H_
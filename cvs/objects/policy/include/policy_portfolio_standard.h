@@ -61,6 +61,7 @@ public:
     static const std::string& getXMLNameStatic();
     virtual void toDebugXML( const int period, std::ostream& out, Tabs* tabs ) const;
     virtual void completeInit( const std::string& aRegionName );
+    virtual void hashPeriodInputs( const int aPeriod, std::size_t& aSeed ) const;
 protected:
 
     DEFINE_DATA_WITH_PARENT(
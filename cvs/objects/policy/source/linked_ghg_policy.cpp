@@ -41,6 +41,7 @@
 
 #include "util/base/include/definitions.h"
 #include <cassert>
+#include <boost/functional/hash.hpp>
 
 #include "policy/include/linked_ghg_policy.h"
 #include "util/base/include/xml_helper.h"
@@ -224,3 +225,18 @@ bool LinkedGHGPolicy::isApplicable( const string& aRegion ) const {
 void LinkedGHGPolicy::setConstraint( const vector<double>& aConstraint ){
     assert( false );
 }
+
+/*!
+ * \brief Combine the policy inputs which affect the given period into a hash.
+ * \details Includes the link and the price and demand adjustments in addition
+ *          to the inputs hashed by the GHGPolicy.
+ * \param aPeriod The model period for which to hash inputs.
+ * \param aSeed The hash value to combine the inputs into.
+ */
+void LinkedGHGPolicy::hashPeriodInputs( const int aPeriod, size_t& aSeed ) const {
+    GHGPolicy::hashPeriodInputs( aPeriod, aSeed );
+    boost::hash_combine( aSeed, mLinkedPolicyName );
+    boost::hash_combine( aSeed, mStartYear );
+    hashValue( mPriceAdjust[ aPeriod ], aSeed );
+    hashValue( mDemandAdjust[ aPeriod ], aSeed );
+}
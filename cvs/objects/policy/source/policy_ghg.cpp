@@ -45,6 +45,7 @@
 #include <iostream>
 #include <string>
 #include <algorithm>
+#include <boost/functional/hash.hpp>
 
 #include "util/base/include/xml_helper.h"
 #include "containers/include/scenario.h"
@@ -243,3 +244,30 @@ bool GHGPolicy::isApplicable( const string& aRegion ) const {
 void GHGPolicy::setConstraint( const vector<double>& aConstraint ){
     std::copy( aConstraint.begin(), aConstraint.end(), mConstraint.begin() );
 }
+
+/*!
+* \brief Combine the policy inputs which affect the given period into a hash.
+* \details The hash is used by the Scenario to detect if a previously calculated
+*          period would see the same policy in a subsequent run and therefore
+*          does not need to be recalculated.
+* \param aPeriod The model period for which to hash inputs.
+* \param aSeed The hash value to combine the inputs into.
+*/
+void GHGPolicy::hashPeriodInputs( const int aPeriod, size_t& aSeed ) const {
+    boost::hash_combine( aSeed, mName );
+    boost::hash_combine( aSeed, mMarket );
+    hashValue( mConstraint[ aPeriod ], aSeed );
+    hashValue( mFixedTax[ aPeriod ], aSeed );
+}
+
+/*!
+* \brief Combine a Value, which may not have been set, into a hash.
+* \param aValue The value to hash.
+* \param aSeed The hash value to combine the value into.
+*/
+void GHGPolicy::hashValue( const Value& aValue, size_t& aSeed ) {
+    boost::hash_combine( aSeed, aValue.isInited() );
+    if( aValue.isInited() ) {
+        boost::hash_combine( aSeed, aValue.get() );
+    }
+}
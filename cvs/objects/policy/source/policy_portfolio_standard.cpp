@@ -44,6 +44,7 @@
 #include <cassert>
 #include <iostream>
 #include <string>
+#include <boost/functional/hash.hpp>
 
 #include "util/base/include/xml_helper.h"
 #include "containers/include/scenario.h"
@@ -223,3 +224,19 @@ void PolicyPortfolioStandard::completeInit( const string& aRegionName ) {
     }
 }
 
+
+/*!
+* \brief Combine the policy inputs which affect the given period into a hash.
+* \details Includes the share of sector output and price bounds in addition
+*          to the inputs hashed by the GHGPolicy.
+* \param aPeriod The model period for which to hash inputs.
+* \param aSeed The hash value to combine the inputs into.
+*/
+void PolicyPortfolioStandard::hashPeriodInputs( const int aPeriod, size_t& aSeed ) const {
+    GHGPolicy::hashPeriodInputs( aPeriod, aSeed );
+    boost::hash_combine( aSeed, mPolicyType );
+    boost::hash_combine( aSeed, mIsShareBased );
+    hashValue( mShareOfSectorOutput[ aPeriod ], aSeed );
+    boost::hash_combine( aSeed, mMinPrice[ aPeriod ] );
+    boost::hash_combine( aSeed, mMaxPrice[ aPeriod ] );
+}
@@ -0,0 +1,121 @@
+#ifndef _MEMORY_REPORT_H_
+#define _MEMORY_REPORT_H_
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+
+
+/*! 
+* \file memory_report.h
+* \ingroup Objects
+* \brief MemoryReport class header file.
+*/
+
+#include <string>
+#include <vector>
+#include <map>
+
+class Scenario;
+
+/*! 
+* \ingroup Objects
+* \brief Tallies the memory held by the model's ARRAY data by subsystem.
+* \details The bulk of the memory in a large scenario is held by the year and
+*          period arrays stored in the various containers rather than by the
+*          containers themselves.  This class uses GCAM Fusion to search the
+*          entire Scenario for Data tagged as ARRAY and attributes the bytes
+*          each one holds to the innermost enclosing subsystem, such as land,
+*          carbon, technologies, or the marketplace.  A count of the containers
+*          stepped through in each subsystem is kept as well.
+*
+*          The byte counts are estimates: they include the array elements and
+*          the array object itself but not, for instance, the heap held by
+*          strings or the node overhead of maps beyond a fixed guess.
+*
+*          The report is written to the main log when the memory-report flag is
+*          set in the Bools section of the configuration.
+*/
+class MemoryReport {
+public:
+    MemoryReport();
+
+    static bool isEnabled();
+
+    void collect( Scenario* aScenario );
+
+    void print( const std::string& aLabel ) const;
+
+    /*!
+     * \brief The totals for a single subsystem.
+     */
+    struct SubsystemTotal {
+        //! The number of containers stepped through
+        size_t mNumContainers = 0;
+
+        //! The number of ARRAY Data found
+        size_t mNumArrays = 0;
+
+        //! The estimated bytes held by the ARRAY Data
+        size_t mArrayBytes = 0;
+    };
+
+    /*!
+     * \brief The GCAM Fusion callback which does the actual tallying.
+     * \details The push/pop filter steps are used to maintain the stack of
+     *          subsystems that enclose the Data currently being processed.
+     */
+    struct DoTally {
+        //! A reference to the containing class where totals are kept.
+        MemoryReport* mParentClass;
+
+        //! The stack of enclosing subsystem names, the innermost is at the back.
+        std::vector<const char*> mSubsystemStack;
+
+        // Templated callbacks for GCAMFusion
+        template<typename DataType>
+        void processData( DataType& aData );
+        template<typename DataType>
+        void pushFilterStep( const DataType& aData );
+        template<typename DataType>
+        void popFilterStep( const DataType& aData );
+    };
+
+private:
+    //! Totals by subsystem name
+    std::map<std::string, SubsystemTotal> mTotals;
+};
+
+#endif // _MEMORY_REPORT_H_
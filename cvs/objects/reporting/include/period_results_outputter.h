@@ -0,0 +1,149 @@
+#ifndef _PERIOD_RESULTS_OUTPUTTER_H_
+#define _PERIOD_RESULTS_OUTPUTTER_H_
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+
+
+/*! 
+* \file period_results_outputter.h
+* \ingroup Objects
+* \brief PeriodResultsOutputter class header file.
+*/
+
+#include <string>
+#include <map>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <sstream>
+#include "util/base/include/default_visitor.h"
+#include "util/base/include/auto_file.h"
+
+class Scenario;
+
+/*! 
+* \ingroup Objects
+* \brief A visitor which streams the results of each model period to a CSV
+*        file as soon as that period has been calculated.
+* \details The regular XML database output is generated by visiting the entire
+*          Scenario once all periods have finished.  For long runs it is often
+*          desirable to see results as the model progresses.  This class will
+*          be called by the Scenario right after a model period is calculated
+*          at which point it collects the period's market prices, supplies and
+*          demands as well as regional emissions by gas into an in memory
+*          buffer.  The buffer is then handed off to a background thread which
+*          does the actual writing so that the file I/O overlaps with solving
+*          the next model period.
+*
+*          Results are written in a "long" format with the columns:
+*          scenario, year, type, region, name, variable, value
+*
+*          This outputter is enabled by setting the write-output flag on the
+*          periodResultsFileName in the Files section of the configuration.
+*/
+class PeriodResultsOutputter : public DefaultVisitor {
+public:
+    PeriodResultsOutputter();
+
+    ~PeriodResultsOutputter();
+
+    static bool isEnabled();
+
+    void writePeriod( const Scenario* aScenario, const int aPeriod );
+
+    virtual void finish() const;
+
+    //! IVisitor methods
+    virtual void startVisitScenario( const Scenario* aScenario, const int aPeriod );
+
+    virtual void startVisitRegion( const Region* aRegion, const int aPeriod );
+    virtual void endVisitRegion( const Region* aRegion, const int aPeriod );
+
+    virtual void startVisitMarket( const Market* aMarket, const int aPeriod );
+
+    virtual void startVisitTechnology( const Technology* aTechnology, const int aPeriod );
+    virtual void endVisitTechnology( const Technology* aTechnology, const int aPeriod );
+
+    virtual void startVisitGHG( const AGHG* aGHG, const int aPeriod );
+
+private:
+    //! The file to write results to, only the writer thread may access it
+    AutoOutputFile mFile;
+
+    //! The buffer for the period currently being collected
+    std::unique_ptr<std::stringstream> mCurrBuffer;
+
+    //! The name of the scenario being written
+    std::string mScenarioName;
+
+    //! The year of the period currently being collected
+    int mCurrYear;
+
+    //! The name of the region currently being visited
+    std::string mCurrRegionName;
+
+    //! The technology currently being visited if any
+    const Technology* mCurrTech;
+
+    //! Emissions by gas summed for the region currently being visited
+    std::map<std::string, double> mRegionEmissions;
+
+    //! Completed period buffers waiting to be written by the writer thread
+    mutable std::queue<std::unique_ptr<std::stringstream> > mPendingBuffers;
+
+    //! Mutex guarding mPendingBuffers and mIsFinished
+    mutable std::mutex mQueueMutex;
+
+    //! Signals the writer thread when buffers are added or we are finishing
+    mutable std::condition_variable mQueueCondition;
+
+    //! Flag to let the writer thread know no more buffers will be added
+    mutable bool mIsFinished;
+
+    //! The background thread which writes completed buffers to mFile
+    mutable std::thread mWriterThread;
+
+    void writerLoop();
+
+    void writeRow( const std::string& aType, const std::string& aRegion,
+                   const std::string& aName, const std::string& aVariable,
+                   const double aValue );
+};
+
+#endif // _PERIOD_RESULTS_OUTPUTTER_H_
@@ -0,0 +1,236 @@
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+
+/*! 
+* \file memory_report.cpp
+* \ingroup Objects
+* \brief The MemoryReport class source file for estimating the memory held by
+*        ARRAY data in each subsystem of the model.
+*/
+
+#include "util/base/include/definitions.h"
+
+#include <iomanip>
+
+#include "reporting/include/memory_report.h"
+#include "containers/include/scenario.h"
+#include "util/base/include/configuration.h"
+#include "util/base/include/time_vector.h"
+#include "util/logger/include/ilogger.h"
+#include "util/base/include/gcam_fusion.hpp"
+#include "util/base/include/gcam_data_containers.h"
+
+using namespace std;
+using namespace objects;
+
+namespace {
+    //! A guess at the per node overhead of a std::map in addition to the
+    //! key / value pair it holds.
+    const size_t MAP_NODE_OVERHEAD = 4 * sizeof( void* );
+
+    /*!
+     * \brief The subsystem name to attribute Data to when stepping into a container
+     *        of the given type.
+     * \details Containers which are not specialized below do not start a new
+     *          subsystem and so their Data is attributed to the enclosing one.
+     */
+    template<typename ContainerType>
+    struct SubsystemName {
+        static const char* value() {
+            return 0;
+        }
+    };
+
+#define DEFINE_SUBSYSTEM_NAME( aContainerType, aName ) \
+    template<> \
+    struct SubsystemName<aContainerType*> { \
+        static const char* value() { \
+            return aName; \
+        } \
+    }
+
+    DEFINE_SUBSYSTEM_NAME( Marketplace, "marketplace" );
+    DEFINE_SUBSYSTEM_NAME( Region, "region" );
+    DEFINE_SUBSYSTEM_NAME( Demographic, "demographics" );
+    DEFINE_SUBSYSTEM_NAME( AResource, "resources" );
+    DEFINE_SUBSYSTEM_NAME( Sector, "sectors" );
+    DEFINE_SUBSYSTEM_NAME( AFinalDemand, "final-demands" );
+    DEFINE_SUBSYSTEM_NAME( Consumer, "consumers" );
+    DEFINE_SUBSYSTEM_NAME( Subsector, "subsectors" );
+    DEFINE_SUBSYSTEM_NAME( ITechnologyContainer, "technologies" );
+    DEFINE_SUBSYSTEM_NAME( GlobalTechnologyDatabase, "technologies" );
+    DEFINE_SUBSYSTEM_NAME( IInput, "technology-inputs" );
+    DEFINE_SUBSYSTEM_NAME( IOutput, "technology-outputs" );
+    DEFINE_SUBSYSTEM_NAME( AGHG, "emissions" );
+    DEFINE_SUBSYSTEM_NAME( LandAllocator, "land" );
+    DEFINE_SUBSYSTEM_NAME( ICarbonCalc, "carbon" );
+    DEFINE_SUBSYSTEM_NAME( NodeCarbonCalc, "carbon" );
+    DEFINE_SUBSYSTEM_NAME( GHGPolicy, "policy" );
+    DEFINE_SUBSYSTEM_NAME( IClimateModel, "climate" );
+
+#undef DEFINE_SUBSYSTEM_NAME
+
+    // Estimates of the bytes held by the various ARRAY types.  Any type not
+    // listed is assumed to hold no memory beyond its own size.
+    template<typename T>
+    size_t getArrayBytes( const T& aData ) {
+        return sizeof( T );
+    }
+
+    template<typename T>
+    size_t getArrayBytes( const vector<T>& aData ) {
+        size_t bytes = sizeof( aData ) + ( aData.capacity() - aData.size() ) * sizeof( T );
+        for( const T& elem : aData ) {
+            bytes += getArrayBytes( elem );
+        }
+        return bytes;
+    }
+
+    template<typename T>
+    size_t getTimeVectorBytes( const T& aData ) {
+        size_t bytes = sizeof( aData );
+        for( auto iter = aData.begin(); iter != aData.end(); ++iter ) {
+            bytes += getArrayBytes( *iter );
+        }
+        return bytes;
+    }
+
+    template<typename T>
+    size_t getArrayBytes( const PeriodVector<T>& aData ) {
+        return getTimeVectorBytes( aData );
+    }
+
+    template<typename T>
+    size_t getArrayBytes( const YearVector<T>& aData ) {
+        return getTimeVectorBytes( aData );
+    }
+
+    template<typename T>
+    size_t getArrayBytes( const TechVintageVector<T>& aData ) {
+        return getTimeVectorBytes( aData );
+    }
+
+    template<typename K, typename V, typename C, typename A>
+    size_t getArrayBytes( const map<K, V, C, A>& aData ) {
+        size_t bytes = sizeof( aData );
+        for( const auto& pair : aData ) {
+            bytes += MAP_NODE_OVERHEAD + getArrayBytes( pair.first ) + getArrayBytes( pair.second );
+        }
+        return bytes;
+    }
+
+    template<typename T>
+    size_t getArrayBytes( const shared_ptr<T>& aData ) {
+        return sizeof( aData ) + ( aData ? getArrayBytes( *aData ) : 0 );
+    }
+}
+
+//! Constructor
+MemoryReport::MemoryReport()
+{
+}
+
+/*!
+ * \brief Check the configuration to see if the memory report was requested.
+ * \return True if the report should be generated.
+ */
+bool MemoryReport::isEnabled() {
+    return Configuration::getInstance()->getBool( "memory-report", false, false );
+}
+
+/*!
+ * \brief Search the given Scenario for all ARRAY Data and add the bytes they
+ *        hold to the totals of their enclosing subsystem.
+ * \param aScenario The Scenario to search.
+ */
+void MemoryReport::collect( Scenario* aScenario ) {
+    DoTally doTallyProc;
+    doTallyProc.mParentClass = this;
+    doTallyProc.mSubsystemStack.push_back( "scenario" );
+    // As in ManageStateVariables the first step, with neither a name nor a flag
+    // set, is a descendant step allowing the search to find ARRAY Data at any depth.
+    vector<FilterStep*> tallySteps( 2, 0 );
+    tallySteps[ 0 ] = new FilterStep( "" );
+    tallySteps[ 1 ] = new FilterStep( "", DataFlags::ARRAY );
+    GCAMFusion<DoTally, true, true, true> tally( doTallyProc, tallySteps );
+    tally.startFilter( aScenario );
+
+    for( FilterStep* step : tallySteps ) {
+        delete step;
+    }
+}
+
+/*!
+ * \brief Write the collected totals to the main log.
+ * \param aLabel A label to identify at what point in the run the totals were collected.
+ */
+void MemoryReport::print( const string& aLabel ) const {
+    ILogger& mainLog = ILogger::getLogger( "main_log" );
+    mainLog.setLevel( ILogger::NOTICE );
+    mainLog << "Memory report " << aLabel << ":" << endl;
+    mainLog << setw( 20 ) << left << "subsystem" << right << setw( 12 ) << "containers"
+            << setw( 12 ) << "arrays" << setw( 14 ) << "array-MB" << endl;
+
+    SubsystemTotal total;
+    for( const auto& subsystem : mTotals ) {
+        const SubsystemTotal& currTotal = subsystem.second;
+        mainLog << setw( 20 ) << left << subsystem.first << right << setw( 12 ) << currTotal.mNumContainers
+                << setw( 12 ) << currTotal.mNumArrays << setw( 14 ) << fixed << setprecision( 2 )
+                << currTotal.mArrayBytes / ( 1024.0 * 1024.0 ) << endl;
+        total.mNumContainers += currTotal.mNumContainers;
+        total.mNumArrays += currTotal.mNumArrays;
+        total.mArrayBytes += currTotal.mArrayBytes;
+    }
+    mainLog << setw( 20 ) << left << "total" << right << setw( 12 ) << total.mNumContainers
+            << setw( 12 ) << total.mNumArrays << setw( 14 ) << fixed << setprecision( 2 )
+            << total.mArrayBytes / ( 1024.0 * 1024.0 ) << endl;
+}
+
+template<typename DataType>
+void MemoryReport::DoTally::processData( DataType& aData ) {
+    SubsystemTotal& currTotal = mParentClass->mTotals[ mSubsystemStack.back() ];
+    ++currTotal.mNumArrays;
+    currTotal.mArrayBytes += getArrayBytes( aData );
+}
+
+template<typename DataType>
+void MemoryReport::DoTally::pushFilterStep( const DataType& aData ) {
+    const char* subsystemName = SubsystemName<DataType>::value();
+    mSubsystemStack.push_back( subsystemName ? subsystemName : mSubsystemStack.back() );
+    ++mParentClass->mTotals[ mSubsystemStack.back() ].mNumContainers;
+}
+
+template<typename DataType>
+void MemoryReport::DoTally::popFilterStep( const DataType& aData ) {
+    mSubsystemStack.pop_back();
+}
@@ -0,0 +1,207 @@
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+
+
+/*!
+* \file period_results_outputter.cpp
+* \ingroup Objects
+* \brief The PeriodResultsOutputter class source file for streaming the results
+*        of each model period to a csv file.
+* \details Results are collected by the visitor on the calling thread and then
+*          written to the file specified by the configuration parameter
+*          periodResultsFileName by a background thread.
+*/
+
+#include "util/base/include/definitions.h"
+
+#include <limits>
+
+#include "util/base/include/configuration.h"
+#include "util/base/include/model_time.h"
+#include "containers/include/scenario.h"
+#include "containers/include/region.h"
+#include "marketplace/include/market.h"
+#include "technologies/include/technology.h"
+#include "emissions/include/aghg.h"
+
+#include "reporting/include/period_results_outputter.h"
+
+using namespace std;
+
+/*! \brief Constructor
+* \details Opens the output file, writes the column headers, and starts the
+*          background writer thread.
+*/
+PeriodResultsOutputter::PeriodResultsOutputter():
+mFile( "periodResultsFileName", "period-results.csv" ),
+mCurrYear( -1 ),
+mCurrTech( 0 ),
+mIsFinished( false )
+{
+    mFile << "scenario,year,type,region,name,variable,value" << endl;
+    mWriterThread = thread( &PeriodResultsOutputter::writerLoop, this );
+}
+
+/*!
+ * \brief Destructor
+ * \details Ensures all pending results have been written and the writer thread
+ *          has been stopped.
+ */
+PeriodResultsOutputter::~PeriodResultsOutputter(){
+    finish();
+}
+
+/*!
+ * \brief Check the configuration to see if period results streaming was requested.
+ * \details Unlike most output files this one must be explicitly turned on.
+ * \return True if the periodResultsFileName has been flagged to be written.
+ */
+bool PeriodResultsOutputter::isEnabled() {
+    return Configuration::getInstance()->shouldWriteFile( "periodResultsFileName", false );
+}
+
+/*!
+ * \brief Collect the results of the given period and queue them to be written.
+ * \details The results are gathered by visiting the scenario for just the given
+ *          period which must happen on the calling thread while the model is not
+ *          calculating.  The actual file I/O is deferred to the writer thread so
+ *          this method returns as soon as the results have been collected.
+ * \param aScenario The scenario to write results for.
+ * \param aPeriod The model period which has just been calculated.
+ */
+void PeriodResultsOutputter::writePeriod( const Scenario* aScenario, const int aPeriod ) {
+    mCurrBuffer.reset( new stringstream() );
+    mCurrBuffer->precision( numeric_limits<double>::digits10 );
+    mCurrYear = aScenario->getModeltime()->getper_to_yr( aPeriod );
+
+    aScenario->accept( this, aPeriod );
+
+    {
+        lock_guard<mutex> lock( mQueueMutex );
+        mPendingBuffers.push( move( mCurrBuffer ) );
+    }
+    mQueueCondition.notify_one();
+}
+
+/*!
+ * \brief Wait for all queued results to be written and stop the writer thread.
+ * \details It is safe to call this method multiple times.
+ */
+void PeriodResultsOutputter::finish() const {
+    {
+        lock_guard<mutex> lock( mQueueMutex );
+        mIsFinished = true;
+    }
+    mQueueCondition.notify_one();
+    if( mWriterThread.joinable() ) {
+        mWriterThread.join();
+    }
+}
+
+/*!
+ * \brief The body of the writer thread.
+ * \details Waits for buffers to be queued and writes them to the file in the
+ *          order they were received.  The thread will exit once finish has been
+ *          called and all pending buffers have been written.
+ */
+void PeriodResultsOutputter::writerLoop() {
+    while( true ) {
+        unique_ptr<stringstream> buffer;
+        {
+            unique_lock<mutex> lock( mQueueMutex );
+            mQueueCondition.wait( lock, [this] { return mIsFinished || !mPendingBuffers.empty(); } );
+            if( mPendingBuffers.empty() ) {
+                // finished and no more data to write
+                return;
+            }
+            buffer = move( mPendingBuffers.front() );
+            mPendingBuffers.pop();
+        }
+        *mFile << buffer->rdbuf();
+        (*mFile).flush();
+    }
+}
+
+/*!
+ * \brief Write a single row of results to the current period buffer.
+ * \param aType The type of result such as market or emissions.
+ * \param aRegion The region name.
+ * \param aName The name of the object the result is for.
+ * \param aVariable The name of the variable being reported.
+ * \param aValue The value to write.
+ */
+void PeriodResultsOutputter::writeRow( const string& aType, const string& aRegion,
+                                       const string& aName, const string& aVariable,
+                                       const double aValue )
+{
+    *mCurrBuffer << mScenarioName << ',' << mCurrYear << ',' << aType << ','
+                 << aRegion << ',' << aName << ',' << aVariable << ',' << aValue << '\n';
+}
+
+void PeriodResultsOutputter::startVisitScenario( const Scenario* aScenario, const int aPeriod ) {
+    mScenarioName = aScenario->getName();
+}
+
+void PeriodResultsOutputter::startVisitRegion( const Region* aRegion, const int aPeriod ) {
+    mCurrRegionName = aRegion->getName();
+    mRegionEmissions.clear();
+}
+
+void PeriodResultsOutputter::endVisitRegion( const Region* aRegion, const int aPeriod ) {
+    for( auto gasEmissions : mRegionEmissions ) {
+        writeRow( "emissions", mCurrRegionName, gasEmissions.first, "emissions", gasEmissions.second );
+    }
+    mRegionEmissions.clear();
+    mCurrRegionName.clear();
+}
+
+void PeriodResultsOutputter::startVisitMarket( const Market* aMarket, const int aPeriod ) {
+    writeRow( "market", aMarket->getRegionName(), aMarket->getGoodName(), "price", aMarket->getPrice() );
+    writeRow( "market", aMarket->getRegionName(), aMarket->getGoodName(), "supply", aMarket->getRawSupply() );
+    writeRow( "market", aMarket->getRegionName(), aMarket->getGoodName(), "demand", aMarket->getRawDemand() );
+}
+
+void PeriodResultsOutputter::startVisitTechnology( const Technology* aTechnology, const int aPeriod ) {
+    mCurrTech = aTechnology;
+}
+
+void PeriodResultsOutputter::endVisitTechnology( const Technology* aTechnology, const int aPeriod ) {
+    mCurrTech = 0;
+}
+
+void PeriodResultsOutputter::startVisitGHG( const AGHG* aGHG, const int aPeriod ) {
+    // Only vintages which are operating in this period will have emissions.
+    if( !mCurrTech || mCurrTech->isOperating( aPeriod ) ) {
+        mRegionEmissions[ aGHG->getName() ] += aGHG->getEmission( aPeriod );
+    }
+}
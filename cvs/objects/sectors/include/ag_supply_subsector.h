@@ -62,6 +62,8 @@ public:
     virtual const std::string& getXMLName() const;
 
     virtual double calcShare( const IDiscreteChoice* aChoiceFun, const int aPeriod ) const;
+    virtual bool getDiscreteChoiceTerms( const int aPeriod, double& aShareWeight, double& aPrice,
+                                         double& aLogShareAdjust ) const;
     
     virtual void interpolateShareWeights( const int aPeriod );
 protected:
@@ -52,6 +52,7 @@
 #include "util/base/include/time_vector.h"
 
 class IInfo;
+class CachedMarket;
 
 /*! 
  * \ingroup Objects
@@ -87,6 +88,20 @@ public:
                                   const std::string& aSectorName,
                                   const int aPeriod );
 
+    static CachedMarket locateTrialMarket( const std::string& aRegionName,
+                                           const std::string& aSectorName );
+
+    static void addToTrialDemand( CachedMarket& aTrialMarket,
+                                  const std::string& aRegionName,
+                                  const std::string& aTrialMarketName,
+                                  const Value& aSupply,
+                                  const int aPeriod );
+
+    static double getTrialSupply( const CachedMarket& aTrialMarket,
+                                  const std::string& aRegionName,
+                                  const std::string& aTrialMarketName,
+                                  const int aPeriod );
+
     static double calcFixedOutputScaleFactor( const double aMarketDemand,
                                               const double aFixedOutput );
 
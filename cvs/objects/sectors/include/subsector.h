@@ -172,6 +172,8 @@ public:
     virtual void calcCost( const int aPeriod );
 
     virtual double calcShare( const IDiscreteChoice* aChoiceFn, const int aPeriod) const;
+    virtual bool getDiscreteChoiceTerms( const int aPeriod, double& aShareWeight, double& aPrice,
+                                         double& aLogShareAdjust ) const;
     virtual double getShareWeight( const int period ) const;
 
     virtual void setOutput( const double aVariableDemand,
@@ -85,6 +85,13 @@ double AgSupplySubsector::calcShare( const IDiscreteChoice* aChoiceFn,
     return 1;
 }
 
+bool AgSupplySubsector::getDiscreteChoiceTerms( const int aPeriod, double& aShareWeight, double& aPrice,
+                                                double& aLogShareAdjust ) const
+{
+    // ag subsectors are not shared with the discrete choice function
+    return false;
+}
+
 void AgSupplySubsector::interpolateShareWeights( const int aPeriod ) {
     // ag sectors do not require share-weigts so do nothing
 }
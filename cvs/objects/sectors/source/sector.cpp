@@ -277,10 +277,34 @@ void Sector::calcCosts( const int aPeriod ){
 * \return A vector of normalized shares, one per subsector, ordered by subsector.
 */
 const vector<double> Sector::calcSubsectorShares( const int aPeriod ) const {
-    // Calculate unnormalized shares.
-    vector<double> subsecShares( mSubsectors.size() );
-    for( unsigned int i = 0; i < mSubsectors.size(); ++i ){
-        subsecShares[ i ] = mSubsectors[ i ]->calcShare( mDiscreteChoiceModel, aPeriod );
+    // Calculate unnormalized shares for all subsectors at once.
+    const size_t numSubsectors = mSubsectors.size();
+    vector<double> shareWeights( numSubsectors );
+    vector<double> prices( numSubsectors );
+    vector<double> subsecShares( numSubsectors );
+    vector<size_t> nonChoiceSubsectors;
+    for( size_t i = 0; i < numSubsectors; ++i ){
+        if( !mSubsectors[ i ]->getDiscreteChoiceTerms( aPeriod, shareWeights[ i ], prices[ i ], subsecShares[ i ] ) ) {
+            // This subsector calculates its own share which will be filled in
+            // below, use a placeholder in the meantime.
+            shareWeights[ i ] = 0.0;
+            prices[ i ] = 0.0;
+            subsecShares[ i ] = 0.0;
+            nonChoiceSubsectors.push_back( i );
+        }
+    }
+    mDiscreteChoiceModel->calcUnnormalizedShares( shareWeights, prices, subsecShares, aPeriod );
+    for( size_t subsecIndex : nonChoiceSubsectors ) {
+        subsecShares[ subsecIndex ] = mSubsectors[ subsecIndex ]->calcShare( mDiscreteChoiceModel, aPeriod );
+    }
+    for( size_t i = 0; i < numSubsectors; ++i ) {
+        // Check for invalid shares.
+        if( !( util::isValidNumber( subsecShares[ i ] ) || subsecShares[ i ] == -numeric_limits<double>::infinity() ) ) {
+            ILogger& mainLog = ILogger::getLogger( "main_log" );
+            mainLog.setLevel( ILogger::ERROR );
+            mainLog << "Invalid share for " << mSubsectors[ i ]->getName() << " in " << mRegionName
+                    << " log(share) =  " << subsecShares[ i ] << endl;
+        }
     }
 
     // Normalize the shares.  After normalization they will be true shares, not log(shares).
@@ -44,10 +44,13 @@
 #include <algorithm>
 #include <numeric>
 #include <cfloat>
+#include <limits>
+#include <Eigen/Core>
 
 #include "sectors/include/sector_utils.h"
 #include "containers/include/scenario.h"
 #include "marketplace/include/marketplace.h"
+#include "marketplace/include/cached_market.h"
 #include "containers/include/market_dependency_finder.h"
 #include "util/base/include/model_time.h"
 #include "containers/include/iinfo.h"
@@ -256,6 +259,74 @@ double SectorUtils::getTrialSupply( const string& aRegionName,
     return trialPrice;
 }
 
+/*!
+ * \brief Locate the trial market for a given sector.
+ * \details Allows objects which access a trial market during every model
+ *          evaluation to pay the cost of building the trial market name and
+ *          looking up the market once, typically during initCalc, rather than
+ *          on every call.  The result should be used with the versions of
+ *          addToTrialDemand and getTrialSupply which take a located market.
+ * \param aRegionName Region of the market.
+ * \param aSectorName Name of the sector.
+ * \return The located trial market which will not have located a market if the
+ *         trial market does not exist.
+ */
+CachedMarket SectorUtils::locateTrialMarket( const string& aRegionName,
+                                             const string& aSectorName )
+{
+    return scenario->getMarketplace()->locateMarket( getTrialMarketName( aSectorName ), aRegionName );
+}
+
+/*!
+ * \brief Set the trial value of supply in a trial market which has already been
+ *        located.
+ * \details Behaves the same as the version which looks up the market by sector
+ *          name but without any name lookups.
+ * \param aTrialMarket The trial market as returned by locateTrialMarket.
+ * \param aRegionName Region of the market.
+ * \param aTrialMarketName Name of the trial market, see getTrialMarketName.
+ * \param aSupply Known value of supply for the iteration.
+ * \param aPeriod Model period.
+ */
+void SectorUtils::addToTrialDemand( CachedMarket& aTrialMarket,
+                                    const string& aRegionName,
+                                    const string& aTrialMarketName,
+                                    const Value& aSupply,
+                                    const int aPeriod )
+{
+    // Market is not created until period 1.
+    if( aPeriod == 0 ){
+        return;
+    }
+
+    aTrialMarket.addToDemand( aTrialMarketName, aRegionName, aSupply, aPeriod, true );
+}
+
+/*!
+ * \brief Get the trial value of supply from a trial market which has already
+ *        been located.
+ * \details Behaves the same as the version which looks up the market by sector
+ *          name but without any name lookups.
+ * \param aTrialMarket The trial market as returned by locateTrialMarket.
+ * \param aRegionName Region of the market.
+ * \param aTrialMarketName Name of the trial market, see getTrialMarketName.
+ * \param aPeriod Model period.
+ * \return Trial value of supply, -1 if the market does not exist.
+ */
+double SectorUtils::getTrialSupply( const CachedMarket& aTrialMarket,
+                                    const string& aRegionName,
+                                    const string& aTrialMarketName,
+                                    const int aPeriod )
+{
+    // Market is not created yet in period 0.
+    if( aPeriod == 0 ){
+        return -1;
+    }
+
+    const double trialPrice = aTrialMarket.getPrice( aTrialMarketName, aRegionName, aPeriod, false );
+    return trialPrice == Marketplace::NO_MARKET_PRICE ? -1 : trialPrice;
+}
+
 /*!
  * \brief Calculate the scale factor used to reduce fixed output.
  * \details Calculates the scaling factor applied to fixed output in the sector
@@ -298,40 +369,31 @@ double SectorUtils::calcFixedOutputScaleFactor( const double aMarketDemand,
  *         calculations using these values in a numerically stable way.
  */
 pair<double, double> SectorUtils::normalizeLogShares( vector<double>& alogShares ){
+    Eigen::Map<Eigen::ArrayXd> logShares( alogShares.data(), alogShares.size() );
+
     // find the log of the largest unnormalized share
-    double lfac = *max_element(alogShares.begin(), alogShares.end());
-    double sum = 0.0;
+    double lfac = logShares.size() > 0 ? logShares.maxCoeff() : -numeric_limits<double>::infinity();
     
     // check for all zero prices
     if( lfac == -numeric_limits<double>::infinity() ) {
         // In this case, set all shares to zero and return.
         // This is arguably wrong, but the rest of the code seems to expect it.
-        for( size_t i = 0; i < alogShares.size(); ++i ) {
-            alogShares[ i ] = 0.0;
-        }
+        logShares.setZero();
         return make_pair( 0.0, 0.0 );
     }
 
     // in theory we could check for lfac == +Inf here, but in light of how the log
     // shares are calculated, it would seem like that can't happen.
 
-    // rescale and get normalization sum
-    for( size_t i = 0; i < alogShares.size(); ++i ) {
-        alogShares[ i ] -= lfac;
-        sum += exp( alogShares[ i ] );
-    }
-    double unnormAdjustedSum = sum;
-    double norm = log( sum );
-    sum = 0.0;                               // double check the normalization
-    for( size_t i = 0; i < alogShares.size(); ++i ) {
-        alogShares[ i ] = exp( alogShares[ i ] - norm );   // divide by norm constant and unlog
-        sum += alogShares[ i ];                      // accumulate sum of normalized shares 
-                                                     //   (should be 1.0 when we're done.)
-    }
+    // rescale, unlog, and get the normalization sum in a single vectorized pass
+    // which is the numerically stable log-sum-exp
+    logShares = ( logShares - lfac ).exp();
+    double unnormAdjustedSum = logShares.sum();
+    logShares /= unnormAdjustedSum;
     
     // In actuality, this rescaling scheme should eliminate the problem of
     // failed normalizations, but we'll allow for the possibility anyhow.
-    assert( sum < numeric_limits<double>::min() || util::isEqual( sum, 1.0 ) );
+    assert( logShares.sum() < numeric_limits<double>::min() || util::isEqual( logShares.sum(), 1.0 ) );
 
     return make_pair( unnormAdjustedSum, lfac );
 }
@@ -538,7 +600,8 @@ bool SectorUtils::isFinalEnergySector( const string& aRegionName,
     assert( sectorInfo );
 
     // Check the final energy flag.
-    return sectorInfo->getBoolean( "is-final-energy", false );
+    static const InfoKey IS_FINAL_ENERGY_KEY( "is-final-energy" );
+    return sectorInfo->getBoolean( IS_FINAL_ENERGY_KEY, false );
 }
 
 /*!
@@ -580,8 +643,8 @@ void SectorUtils::setSupplyBehaviorBounds( const string& aGoodName, const string
                                            const double aLowerPriceBound, const double aUpperPriceBound,
                                            const int aPeriod )
 {
-    const string LOWER_BOUND_KEY = "lower-bound-supply-price";
-    const string UPPER_BOUND_KEY = "upper-bound-supply-price";
+    static const InfoKey LOWER_BOUND_KEY( "lower-bound-supply-price" );
+    static const InfoKey UPPER_BOUND_KEY( "upper-bound-supply-price" );
 
     IInfo* sectorInfo = scenario->getMarketplace()->getMarketInfo( aGoodName, aRegionName, aPeriod, true );
 
@@ -595,7 +658,7 @@ void SectorUtils::setSupplyBehaviorBounds( const string& aGoodName, const string
         util::getLargeNumber();
     if( util::isValidNumber( aLowerPriceBound ) ) {
         lowerPriceBound = min( lowerPriceBound, aLowerPriceBound );
-        sectorInfo->setDouble( LOWER_BOUND_KEY, lowerPriceBound );
+        sectorInfo->setDouble( LOWER_BOUND_KEY.getName(), lowerPriceBound );
     }
 
     // Set the upper price bound.
@@ -603,7 +666,7 @@ void SectorUtils::setSupplyBehaviorBounds( const string& aGoodName, const string
         -util::getLargeNumber();
     if( util::isValidNumber( aUpperPriceBound ) ) {
         upperPriceBound = max( upperPriceBound, aUpperPriceBound );
-        sectorInfo->setDouble( UPPER_BOUND_KEY, upperPriceBound );
+        sectorInfo->setDouble( UPPER_BOUND_KEY.getName(), upperPriceBound );
     }
 }
 
@@ -382,17 +382,36 @@ double Subsector::getAverageFuelPrice( const int aPeriod ) const {
 * \return A vector of technology shares.
 */
 const vector<double> Subsector::calcTechShares( const int aPeriod ) const {
-    vector<double> logTechShares ( mTechContainers.size() ); 
+    const size_t numTechs = mTechContainers.size();
+    vector<double> shareWeights( numTechs );
+    vector<double> costs( numTechs );
+    vector<double> logTechShares( numTechs );
+    vector<size_t> nonChoiceTechs;
+    for( size_t i = 0; i < numTechs; ++i ){
+        if( !mTechContainers[ i ]->getNewVintageTechnology( aPeriod )->getDiscreteChoiceTerms(
+                mRegionName, aPeriod, shareWeights[ i ], costs[ i ], logTechShares[ i ] ) )
+        {
+            // This technology calculates its own share which will be filled in
+            // below, use a placeholder in the meantime.
+            shareWeights[ i ] = 0.0;
+            costs[ i ] = 0.0;
+            logTechShares[ i ] = 0.0;
+            nonChoiceTechs.push_back( i );
+        }
+    }
 
-    for( unsigned int i = 0; i < mTechContainers.size(); ++i ){
-        // determine shares based on Technology costs
-        double lts = mTechContainers[ i ]->getNewVintageTechnology( aPeriod )->
+    // determine shares based on Technology costs for all technologies at once
+    mDiscreteChoiceModel->calcUnnormalizedShares( shareWeights, costs, logTechShares, aPeriod );
+    for( size_t techIndex : nonChoiceTechs ) {
+        logTechShares[ techIndex ] = mTechContainers[ techIndex ]->getNewVintageTechnology( aPeriod )->
             calcShare( mRegionName, mDiscreteChoiceModel, aPeriod );
-
-        // Check that Technology shares are valid.
-        assert( util::isValidNumber( lts ) || lts == -numeric_limits<double>::infinity() );
-        logTechShares[ i ] = lts;
     }
+
+    // Check that Technology shares are valid.
+    assert( all_of( logTechShares.begin(), logTechShares.end(), []( const double aLogShare ) {
+        return util::isValidNumber( aLogShare ) || aLogShare == -numeric_limits<double>::infinity();
+    } ) );
+
     // Normalize technology shares.  After normalization they will be
     // shares, not log(shares).
     SectorUtils::normalizeLogShares( logTechShares );
@@ -432,20 +451,12 @@ void Subsector::calcCost( const int aPeriod ){
  * \sa Technology::calcShare()
 */
 double Subsector::calcShare( const IDiscreteChoice* aChoiceFn, const int aPeriod ) const {
-    double subsectorPrice = getPrice( aPeriod );
+    double shareWeight;
+    double subsectorPrice;
+    double fuelPrefTerm;
+    getDiscreteChoiceTerms( aPeriod, shareWeight, subsectorPrice, fuelPrefTerm );
 
-    if( std::isnan( subsectorPrice ) ) {
-        // Check for a NaN sentinel value.  If we find it, set the
-        // subsector's share to zero.
-        return -numeric_limits<double>::infinity();
-    }
-    
-    double fuelPrefTerm = mFuelPrefElasticity[ aPeriod ]  != 0.0 ?
-        mFuelPrefElasticity[ aPeriod ] * log( SectorUtils::getGDPPerCapScaled( mRegionName, aPeriod ) ) :
-        0.0;
-    assert( scaledGdpPerCapita > 0.0 );
-
-    double logshare = aChoiceFn->calcUnnormalizedShare( mShareWeights[ aPeriod ], subsectorPrice, aPeriod )
+    double logshare = aChoiceFn->calcUnnormalizedShare( shareWeight, subsectorPrice, aPeriod )
         + fuelPrefTerm;
     
     /*! \post logshare is finite or minus-infinity. */
@@ -460,6 +471,43 @@ double Subsector::calcShare( const IDiscreteChoice* aChoiceFn, const int aPeriod
     return logshare;
 }
 
+/*!
+ * \brief Get the terms used to calculate the share of this subsector with the
+ *        discrete choice function of the sector.
+ * \details A subsector whose price is the NaN sentinel is given a share weight
+ *          and price of zero which results in a zero share.  This allows the
+ *          sector to calculate the shares of all of its subsectors at once with
+ *          IDiscreteChoice::calcUnnormalizedShares.
+ * \param aPeriod Model period.
+ * \param aShareWeight The share weight to use.
+ * \param aPrice The price to share on.
+ * \param aLogShareAdjust The fuel preference elasticity term to add to the log
+ *                        of the share.
+ * \return Whether the share is calculated from these terms, if false calcShare
+ *         must be used instead.
+ * \sa Subsector::calcShare
+ */
+bool Subsector::getDiscreteChoiceTerms( const int aPeriod, double& aShareWeight, double& aPrice,
+                                        double& aLogShareAdjust ) const
+{
+    aShareWeight = 0.0;
+    aPrice = getPrice( aPeriod );
+    aLogShareAdjust = 0.0;
+
+    if( std::isnan( aPrice ) ) {
+        // Check for a NaN sentinel value.  If we find it, set the
+        // subsector's share to zero.
+        aPrice = 0.0;
+        return true;
+    }
+
+    aShareWeight = mShareWeights[ aPeriod ];
+    if( mFuelPrefElasticity[ aPeriod ] != 0.0 ) {
+        aLogShareAdjust = mFuelPrefElasticity[ aPeriod ] * log( SectorUtils::getGDPPerCapScaled( mRegionName, aPeriod ) );
+    }
+    return true;
+}
+
 
 /*! \brief Return the total fixed Technology output for this subsector.
 * \details Fixed output may come from vintaged production or exogenously 
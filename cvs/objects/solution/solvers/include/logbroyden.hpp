@@ -77,10 +77,12 @@ public:
   LogBroyden(Marketplace *mktplc, World *world, CalcCounter *ccounter, int itmax=250,
              double ftol=1.0e-4) :
       SolverComponent(mktplc,world,ccounter), mMaxIter( itmax ), mFTOL( ftol ),
-      mLogPricep( true ), mMaxJacobainReuse( 100 ), mSolutionInfoFilter(0) {}
+      mLogPricep( true ), mMaxJacobainReuse( 100 ), mLineSearchLadderSize( 0 ),
+      mLineSearchLadderRatio( 0.5 ), mSolutionInfoFilter(0) {}
     LogBroyden() :
         SolverComponent(), mMaxIter( 250 ), mFTOL( 1.0e-4 ),
-        mLogPricep( true ), mMaxJacobainReuse( 100 ), mSolutionInfoFilter(0) {}
+        mLogPricep( true ), mMaxJacobainReuse( 100 ), mLineSearchLadderSize( 0 ),
+      mLineSearchLadderRatio( 0.5 ), mSolutionInfoFilter(0) {}
   virtual ~LogBroyden() {
       delete mSolutionInfoFilter;
   }
@@ -121,6 +123,13 @@ protected:
         //! Control the number of times we can re-use the Jacobian using Broyden's method
         //! which if set to zero implies this algorithm just collapse to a regular NR algorithm
         DEFINE_VARIABLE( SIMPLE, "max-jacobian-reuse", mMaxJacobainReuse, int ),
+
+        //! The number of step lengths the line search evaluates at once, a value of
+        //! one or less uses the serial backtracking line search
+        DEFINE_VARIABLE( SIMPLE, "line-search-ladder-size", mLineSearchLadderSize, int ),
+
+        //! The ratio between successive step lengths evaluated by the speculative line search
+        DEFINE_VARIABLE( SIMPLE, "line-search-ladder-ratio", mLineSearchLadderRatio, double ),
         
         //! A filter which will be used to determine which SolutionInfos with solver component
         //! will work on.
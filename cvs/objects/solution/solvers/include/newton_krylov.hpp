@@ -0,0 +1,161 @@
+#ifndef NEWTON_KRYLOV_HPP_
+#define NEWTON_KRYLOV_HPP_
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+
+/*!
+ * \file newton_krylov.hpp
+ * \ingroup objects
+ * \brief Header file for the Jacobian-free Newton-Krylov solver component
+ */
+
+#include <string>
+#include <map>
+#include "solution/solvers/include/solver_component.h"
+#include "solution/util/include/ublas-helpers.hpp"
+
+class CalcCounter;
+class Marketplace;
+class World;
+class SolutionInfoSet;
+class ISolutionInfoFilter;
+class LogEDFun;
+
+/*!
+ * \ingroup Objects
+ * \brief SolverComponent based on a Jacobian-free Newton-Krylov method.
+ *
+ * \details Each Newton step J . dx = -F is solved approximately with
+ *          GMRES.  GMRES only needs the product of the Jacobian with a
+ *          vector which is approximated with a finite-difference directional
+ *          derivative:  J . v ~= ( F( x + h v ) - F( x ) ) / h.  Each such
+ *          product costs a single (full) model evaluation so that, unlike
+ *          LogBroyden or LogNewtonRaphson, neither the N partial derivative
+ *          evaluations nor the N x N storage of a dense Jacobian are required.
+ *          The number of evaluations per Newton step is instead bounded by
+ *          the dimension of the Krylov subspace.
+ *
+ *          GMRES is right preconditioned with the diagonal of the Jacobian.
+ *          The diagonal is calculated with partial derivatives the first time
+ *          a market is solved by this component and is then cached by market
+ *          name, so that subsequent periods only need to calculate it for
+ *          markets that are new to the solution set.  The cache is refreshed
+ *          when a step fails to make progress.
+ *
+ *          The resulting step is globalized with the same line search that
+ *          is used by LogBroyden.
+ *
+ *          <b>XML specification for NewtonKrylov</b>
+ *          - XML name: \c newton-krylov-solver-component
+ *          - Contained by: user-configurable-solver
+ *          - Elements:
+ *              - \c max-iterations The maximum number of Newton iterations.
+ *              - \c ftol The convergence tolerance on the scaled excess demands.
+ *              - \c krylov-dimension The maximum dimension of the Krylov
+ *                   subspace, i.e. the maximum number of GMRES iterations and
+ *                   so model evaluations per Newton step.
+ *              - \c krylov-tolerance The relative residual at which GMRES stops.
+ *              - \c preconditioner Either \c diagonal (the default) or \c none.
+ *              - \c linear-price / \c log-price Whether to work in price or
+ *                   log-price.
+ *              - \c solution-info-filter The markets to solve.
+ */
+class NewtonKrylov: public SolverComponent {
+public:
+    NewtonKrylov( Marketplace* aMarketplace, World* aWorld, CalcCounter* aCalcCounter );
+    NewtonKrylov();
+    virtual ~NewtonKrylov();
+    static const std::string& getXMLNameStatic();
+
+    // SolverComponent methods
+    virtual void init();
+    virtual ReturnCode solve( SolutionInfoSet& aSolutionSet, const int aPeriod );
+    virtual const std::string& getXMLName() const;
+
+    // AParsable methods
+    virtual bool XMLParse( rapidxml::xml_node<char>* & aNode );
+
+protected:
+    // Define data such that introspection utilities can process the data from this
+    // subclass together with the data members of the parent classes.
+    DEFINE_DATA_WITH_PARENT(
+        SolverComponent,
+
+        //! Maximum number of Newton iterations
+        DEFINE_VARIABLE( SIMPLE, "max-iterations", mMaxIter, unsigned int ),
+
+        //! Tolerance for the convergence test on the scaled excess demands
+        DEFINE_VARIABLE( SIMPLE, "ftol", mFTOL, double ),
+
+        //! Maximum dimension of the Krylov subspace built for each Newton step
+        DEFINE_VARIABLE( SIMPLE, "krylov-dimension", mKrylovDim, unsigned int ),
+
+        //! Relative residual at which the GMRES iterations stop
+        DEFINE_VARIABLE( SIMPLE, "krylov-tolerance", mKrylovTol, double ),
+
+        //! The type of preconditioner to use: diagonal or none
+        DEFINE_VARIABLE( SIMPLE, "preconditioner", mPreconditionerType, std::string ),
+
+        //! flag indicating whether we should work in price or log-price
+        DEFINE_VARIABLE( SIMPLE, "is-log-price", mLogPricep, bool ),
+
+        //! The number of step lengths the line search evaluates at once, a value of
+        //! one or less uses the serial backtracking line search
+        DEFINE_VARIABLE( SIMPLE, "line-search-ladder-size", mLineSearchLadderSize, int ),
+
+        //! The ratio between successive step lengths evaluated by the speculative line search
+        DEFINE_VARIABLE( SIMPLE, "line-search-ladder-ratio", mLineSearchLadderRatio, double ),
+
+        //! A filter which will be used to determine which SolutionInfos with solver component
+        //! will work on.
+        DEFINE_VARIABLE( SIMPLE | NOT_PARSABLE, "solution-info-filter", mSolutionInfoFilter, ISolutionInfoFilter* )
+    )
+
+    //! The cached diagonal of the Jacobian by market name.
+    std::map<std::string, double> mCachedDiagonal;
+
+    int nksolve( LogEDFun& F, UBVECTOR& x, UBVECTOR& fx, const SolutionInfoSet& aSolutionSet,
+                 int& neval );
+
+    void calcDiagonal( LogEDFun& F, const UBVECTOR& x, const UBVECTOR& fx,
+                       const SolutionInfoSet& aSolutionSet, UBVECTOR& diag, int& neval );
+
+    int gmres( LogEDFun& F, const UBVECTOR& x, const UBVECTOR& fx, const UBVECTOR& diag,
+               UBVECTOR& dx, UBVECTOR& Jdx, int& neval );
+};
+
+#endif // NEWTON_KRYLOV_HPP_
@@ -61,6 +61,7 @@ class World;
 class BisectAll;
 class LogBroyden;
 class Preconditioner;
+class NewtonKrylov;
 
 /*! \brief An abstract class defining an interface to an independent component
 *          of a Solver.
@@ -102,7 +103,7 @@ protected:
         /* Declare all subclasses of SolverComponent to allow automatic traversal of the
          * hierarchy under introspection.
          */
-        DEFINE_SUBCLASS_FAMILY( SolverComponent, BisectAll, LogBroyden, Preconditioner )
+        DEFINE_SUBCLASS_FAMILY( SolverComponent, BisectAll, LogBroyden, Preconditioner, NewtonKrylov )
     )
     
    Marketplace* marketplace; //<! The marketplace to solve. 
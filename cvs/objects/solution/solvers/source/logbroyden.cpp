@@ -201,7 +201,7 @@ SolverComponent::ReturnCode LogBroyden::solve(SolutionInfoSet &solnset, int peri
     std::list<int> allCols;
     
     solverLog << "Initial market state:\nmkt    \tprice   \tsupply  \tdemand\n";
-    std::vector<SolutionInfo> solvables = solnset.getSolvableSet();
+    const std::vector<SolutionInfo>& solvables = solnset.getSolvableSet();
     bool isAllSolved = true;
     for(size_t i=0; i<solvables.size(); ++i) {
         allCols.push_back(i);
@@ -225,7 +225,7 @@ SolverComponent::ReturnCode LogBroyden::solve(SolutionInfoSet &solnset, int peri
     int neval = 0;
 
     // set our initial x from the solutionInfoSet
-    std::vector<SolutionInfo> smkts(solnset.getSolvableSet());
+    const std::vector<SolutionInfo>& smkts = solnset.getSolvableSet();
     if( mLogPricep ) {
       std::transform(smkts.begin(), smkts.end(), x.begin(), SI2lgprice);
     }
@@ -549,7 +549,10 @@ int LogBroyden::bsolve(VecFVec &F, UBVECTOR &x, UBVECTOR &fx,
           past_f_values = std::queue<double>();
       }
       UBVECTOR fxnew(fx.size());
-    int lserr = linesearch(F,x,f0,gx,dx, xnew,fnew, fxnew, fxIncr, neval, &solverLog);
+    int lserr = mLineSearchLadderSize > 1 ?
+        speculativeLinesearch(F,x,f0,gx,dx, xnew,fnew, fxnew, fxIncr,
+                              mLineSearchLadderSize, mLineSearchLadderRatio, neval, &solverLog) :
+        linesearch(F,x,f0,gx,dx, xnew,fnew, fxnew, fxIncr, neval, &solverLog);
 
     if(lserr != 0) {
       // line search failed.  There are a couple of things that could
@@ -794,37 +797,20 @@ void LogBroyden::reportPSD(UBVECTOR &arptvec, const std::vector<int> &amktids, c
         return;
     }
 
-    std::vector<SolutionInfo> solvable = cSolInfo->getSolvableSet();
-    std::vector<SolutionInfo> unsolvable = cSolInfo->getUnsolvableSet();
+    // Gather prices, supplies, and demands for all markets in a single pass.
+    SolutionInfoSet::MarketState state;
+    cSolInfo->getMarketState( state, false );
 
-    unsigned int i;
-    unsigned int j;
     // log prices
-    for(i=0; i<solvable.size(); ++i) {
-        arptvec[i] = solvable[i].getPrice();
-    }
-    for(i=0,j=solvable.size(); i<unsolvable.size(); ++i,++j) {
-        arptvec[j] = unsolvable[i].getPrice();
-    }
-        
+    arptvec = Eigen::Map<const UBVECTOR>( state.mPrice.data(), state.mPrice.size() );
     reportVec("price", arptvec, amktids, aissolvable);
 
     // log supply
-    for(i=0; i<solvable.size(); ++i) {
-        arptvec[i] = solvable[i].getSupply();
-    }
-    for(i=0,j=solvable.size(); i<unsolvable.size(); ++i,++j) {
-        arptvec[j] = unsolvable[i].getSupply();
-    }
+    arptvec = Eigen::Map<const UBVECTOR>( state.mSupply.data(), state.mSupply.size() );
     reportVec("supply", arptvec, amktids, aissolvable);
 
     // log demand
-    for(i=0; i<solvable.size(); ++i) {
-        arptvec[i] = solvable[i].getDemand();
-    }
-    for(i=0,j=solvable.size(); i<unsolvable.size(); ++i,++j) {
-        arptvec[j] = unsolvable[i].getDemand();
-    }
+    arptvec = Eigen::Map<const UBVECTOR>( state.mDemand.data(), state.mDemand.size() );
     reportVec("demand", arptvec, amktids, aissolvable);
 
 }
@@ -0,0 +1,512 @@
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+
+/*!
+ * \file newton_krylov.cpp
+ * \ingroup objects
+ * \brief NewtonKrylov SolverComponent class source file.
+ */
+
+#include "util/base/include/definitions.h"
+#include <string>
+#include <list>
+#include <algorithm>
+#include <iomanip>
+#include <math.h>
+
+#include "solution/solvers/include/solver_component.h"
+#include "solution/solvers/include/newton_krylov.hpp"
+#include "solution/util/include/calc_counter.h"
+#include "marketplace/include/marketplace.h"
+#include "containers/include/world.h"
+#include "containers/include/scenario.h"
+#include "solution/util/include/solution_info_set.h"
+#include "solution/util/include/solution_info.h"
+#include "util/base/include/util.h"
+#include "util/base/include/manage_state_variables.hpp"
+#include "util/logger/include/ilogger.h"
+#include "util/base/include/xml_helper.h"
+#include "util/base/include/xml_parse_helper.h"
+#include "solution/util/include/solution_info_filter_factory.h"
+#include "solution/util/include/solvable_nr_solution_info_filter.h"
+
+#include "solution/util/include/linesearch.hpp"
+#include "solution/util/include/edfun.hpp"
+
+#include "util/base/include/timer.h"
+
+using namespace std;
+
+extern Scenario* scenario;
+
+//! Constructor
+NewtonKrylov::NewtonKrylov( Marketplace* aMarketplace, World* aWorld, CalcCounter* aCalcCounter ):
+SolverComponent( aMarketplace, aWorld, aCalcCounter ),
+mMaxIter( 50 ),
+mFTOL( 1.0e-4 ),
+mKrylovDim( 30 ),
+mKrylovTol( 0.1 ),
+mPreconditionerType( "diagonal" ),
+mLogPricep( true ),
+mLineSearchLadderSize( 0 ),
+mLineSearchLadderRatio( 0.5 ),
+mSolutionInfoFilter( 0 )
+{
+}
+
+//! Default constructor
+NewtonKrylov::NewtonKrylov():
+mMaxIter( 50 ),
+mFTOL( 1.0e-4 ),
+mKrylovDim( 30 ),
+mKrylovTol( 0.1 ),
+mPreconditionerType( "diagonal" ),
+mLogPricep( true ),
+mLineSearchLadderSize( 0 ),
+mLineSearchLadderRatio( 0.5 ),
+mSolutionInfoFilter( 0 )
+{
+}
+
+//! Destructor
+NewtonKrylov::~NewtonKrylov() {
+    delete mSolutionInfoFilter;
+}
+
+//! Get the name of the SolverComponent
+const string& NewtonKrylov::getXMLNameStatic() {
+    const static string SOLVER_NAME = "newton-krylov-solver-component";
+    return SOLVER_NAME;
+}
+
+//! Get the name of the SolverComponent
+const string& NewtonKrylov::getXMLName() const {
+    return getXMLNameStatic();
+}
+
+//! Init method.
+void NewtonKrylov::init() {
+    if( !mSolutionInfoFilter ) {
+        mSolutionInfoFilter = new SolvableNRSolutionInfoFilter();
+    }
+}
+
+bool NewtonKrylov::XMLParse( rapidxml::xml_node<char>* & aNode ) {
+    string nodeName = XMLParseHelper::getNodeName( aNode );
+    if( nodeName == "solution-info-filter" ) {
+        delete mSolutionInfoFilter;
+        mSolutionInfoFilter =
+            SolutionInfoFilterFactory::createSolutionInfoFilterFromString( XMLParseHelper::getValue<string>( aNode ) );
+    }
+    else if( nodeName == "linear-price" ) {
+        mLogPricep = false;
+    }
+    else if( nodeName == "log-price" ) {
+        mLogPricep = true;
+    }
+    else {
+        return false;
+    }
+    return true;
+}
+
+/*!
+ * \brief Jacobian-free Newton-Krylov solver.
+ * \details Attempts to solve the selected markets using Newton's method where
+ *          each Newton step is found with GMRES using directional derivatives
+ *          in place of a Jacobian matrix.  See nksolve for details.
+ * \param aSolutionSet An initial set of SolutionInfo objects representing all
+ *                     of the markets we will attempt to solve
+ * \param aPeriod Model time period
+ * \return Status code indicating whether the algorithm was successful or not.
+ */
+SolverComponent::ReturnCode NewtonKrylov::solve( SolutionInfoSet& aSolutionSet, const int aPeriod ) {
+    // If all markets are solved, then return with success code.
+    if( aSolutionSet.isAllSolved() ) {
+        return SUCCESS;
+    }
+
+    startMethod();
+
+    // Update the solution vector for the correct markets to solve.
+    aSolutionSet.updateSolvable( mSolutionInfoFilter );
+
+    ILogger& solverLog = ILogger::getLogger( "solver_log" );
+    solverLog.setLevel( ILogger::NOTICE );
+    solverLog << "Beginning Newton-Krylov solution for period " << aPeriod
+              << ".  Solving " << aSolutionSet.getNumSolvable() << " markets." << endl;
+
+    ILogger& worstMarketLog = ILogger::getLogger( "worst_market_log" );
+    worstMarketLog.setLevel( ILogger::DEBUG );
+    ILogger& singleLog = ILogger::getLogger( "single_market_log" );
+    singleLog.setLevel( ILogger::DEBUG );
+
+    const size_t nsolv = aSolutionSet.getNumSolvable();
+    if( nsolv == 0 ) {
+        solverLog << "No markets were assigned to this solver.  Exiting." << endl;
+        return SUCCESS;
+    }
+
+    const vector<SolutionInfo>& smkts = aSolutionSet.getSolvableSet();
+    bool isAllSolved = true;
+    for( size_t i = 0; i < smkts.size(); ++i ) {
+        isAllSolved &= smkts[ i ].isSolved();
+    }
+    if( isAllSolved ) {
+        solverLog << "All solvable markets are already solved.  Exiting." << endl;
+        return SUCCESS;
+    }
+
+    Timer& solverTimer = TimerRegistry::getInstance().getTimer( TimerRegistry::SOLVER );
+    solverTimer.start();
+
+    // set our initial x from the solutionInfoSet
+    UBVECTOR x( nsolv ), fx( nsolv );
+    for( size_t i = 0; i < nsolv; ++i ) {
+        x[ i ] = mLogPricep ? log( max( smkts[ i ].getPrice(), util::getTinyNumber() ) )
+                           : smkts[ i ].getPrice();
+    }
+
+    // This is the closure that will evaluate the ED function
+    LogEDFun F( aSolutionSet, world, marketplace, aPeriod, mLogPricep );
+    F.scaleInitInputs( x );
+    F( x, fx );
+    int neval = 1;
+    aSolutionSet.printMarketInfo( "Newton-Krylov-initial", calcCounter->getPeriodCount(), singleLog );
+
+    int status = nksolve( F, x, fx, aSolutionSet, neval );
+
+    solverTimer.stop();
+
+    ReturnCode code;
+    solverLog.setLevel( ILogger::NOTICE );
+    solverLog << "Newton-Krylov solver:  neval= " << neval << "\nResult:  ";
+    if( status == 0 ) {
+        code = SUCCESS;
+        solverLog << "Newton-Krylov solution success." << endl;
+    }
+    else if( status == -1 ) {
+        code = FAILURE_ITER_MAX_REACHED;
+        solverLog << "Newton-Krylov solution failed:  Iteration max reached." << endl;
+    }
+    else if( status == -3 ) {
+        code = FAILURE_ZERO_GRADIENT;
+        solverLog << "Newton-Krylov solution failed:  GMRES did not find a descent direction." << endl;
+    }
+    else if( status == -4 ) {
+        code = FAILURE_POOR_PROGRESS;
+        solverLog << "Newton-Krylov solution failed:  repeated poor progress." << endl;
+    }
+    else {
+        code = FAILURE_UNKNOWN;
+        solverLog << "Newton-Krylov solution failed for unknown reason." << endl;
+    }
+    if( !aSolutionSet.isAllSolved() ) {
+        solverLog << "The following markets were not solved:\n";
+        aSolutionSet.printUnsolved( solverLog );
+    }
+
+    const SolutionInfo* maxred = aSolutionSet.getWorstSolutionInfo();
+    addIteration( maxred->getName(), maxred->getRelativeED() );
+    worstMarketLog << "###Newton-Krylov-end:  " << *maxred << endl;
+    aSolutionSet.printMarketInfo( "Newton-Krylov-end ", calcCounter->getPeriodCount(), singleLog );
+
+    return code;
+}
+
+/*!
+ * \brief Perform the Newton iterations.
+ * \param F The excess demand function.
+ * \param x The initial guess on input, the final point on output.
+ * \param fx F( x ) which must have been the most recent evaluation of F.
+ * \param aSolutionSet The solution set being solved used for logging.
+ * \param neval The running count of model evaluations.
+ * \return 0 for success, -1 if the iteration limit was reached, -3 if no
+ *         descent direction could be found, -4 if the line search failed.
+ */
+int NewtonKrylov::nksolve( LogEDFun& F, UBVECTOR& x, UBVECTOR& fx, const SolutionInfoSet& aSolutionSet,
+                           int& neval )
+{
+    ILogger& solverLog = ILogger::getLogger( "solver_log" );
+    solverLog.setLevel( ILogger::DEBUG );
+    ILogger& worstMarketLog = ILogger::getLogger( "worst_market_log" );
+    ILogger& singleLog = ILogger::getLogger( "single_market_log" );
+
+    const double FTINY = mFTOL * mFTOL;
+    const bool usePreconditioner = mPreconditionerType == "diagonal";
+    const int n = x.size();
+    UBVECTOR diag( UBVECTOR::Ones( n ) );
+    UBVECTOR dx( n ), Jdx( n ), gx( n ), xnew( n ), fxnew( n );
+    double f0 = fx.dot( fx );
+    if( f0 < FTINY ) {
+        return 0;
+    }
+
+    bool refreshedDiagonal = false;
+    for( unsigned int iter = 0; iter < mMaxIter; ++iter ) {
+        solverLog << "Newton-Krylov iter= " << iter << "\tneval= " << neval << "\n";
+        aSolutionSet.printMarketInfo( "Newton-Krylov ", calcCounter->getPeriodCount(), singleLog );
+
+        if( usePreconditioner ) {
+            calcDiagonal( F, x, fx, aSolutionSet, diag, neval );
+            F.setSlope( diag );
+        }
+
+        int kdim = gmres( F, x, fx, diag, dx, Jdx, neval );
+        solverLog << "GMRES used " << kdim << " directional derivatives, dxmag= "
+                  << sqrt( dx.dot( dx ) ) << "\n";
+
+        // The line search only needs the rate of change of F*F along dx
+        // which, up to a constant factor, is fx . J . dx.
+        double fJdx = fx.dot( Jdx );
+        double dxmag2 = dx.dot( dx );
+        int lserr = 1;
+        double fnew = f0;
+        if( fJdx < 0 && dxmag2 > 0 ) {
+            gx = ( fJdx / dxmag2 ) * dx;
+            if( mLineSearchLadderSize > 1 ) {
+                lserr = speculativeLinesearch( F, x, f0, gx, dx, xnew, fnew, fxnew, 0.0,
+                                               mLineSearchLadderSize, mLineSearchLadderRatio,
+                                               neval, &solverLog );
+            }
+            else {
+                lserr = linesearch( F, x, f0, gx, dx, xnew, fnew, fxnew, 0.0, neval, &solverLog );
+            }
+        }
+
+        if( lserr != 0 ) {
+            // Relaxed convergence test, as in LogBroyden
+            if( f0 / n < mFTOL ) {
+                solverLog << "Relaxed success" << endl;
+                F( x, fx );
+                return 0;
+            }
+            F( x, fx );
+            ++neval;
+            if( usePreconditioner && !refreshedDiagonal ) {
+                // The cached diagonal may be stale, recalculate it and try again.
+                solverLog << "Refreshing the cached Jacobian diagonal after a failed step." << endl;
+                for( const SolutionInfo& currMkt : aSolutionSet.getSolvableSet() ) {
+                    mCachedDiagonal.erase( currMkt.getName() );
+                }
+                refreshedDiagonal = true;
+                continue;
+            }
+            solverLog << "linesearch failure" << endl;
+            return fJdx < 0 ? -4 : -3;
+        }
+        refreshedDiagonal = false;
+
+        x = xnew;
+        fx = fxnew;
+        f0 = fnew;
+
+        const SolutionInfo* maxred = aSolutionSet.getWorstSolutionInfo();
+        addIteration( maxred->getName(), maxred->getRelativeED() );
+        worstMarketLog << "Newton-Krylov:  " << *maxred << "\n";
+
+        // test for convergence
+        double maxval = fx.cwiseAbs().maxCoeff();
+        solverLog << "Convergence test maxval: " << maxval << "\n";
+        if( maxval <= mFTOL ) {
+            solverLog << "Solution successful -- max." << endl;
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+/*!
+ * \brief Fill in the diagonal of the Jacobian to use as a preconditioner.
+ * \details Entries for markets found in mCachedDiagonal are reused, the rest
+ *          are calculated with a partial derivative and added to the cache.
+ *          Since partial derivatives snap back to the "base" state F must have
+ *          been most recently evaluated at x.
+ * \param F The excess demand function.
+ * \param x The current point.
+ * \param fx F( x ).
+ * \param aSolutionSet The solution set being solved.
+ * \param diag The diagonal of the Jacobian, output.
+ * \param neval The running count of model evaluations.
+ */
+void NewtonKrylov::calcDiagonal( LogEDFun& F, const UBVECTOR& x, const UBVECTOR& fx,
+                                 const SolutionInfoSet& aSolutionSet, UBVECTOR& diag, int& neval )
+{
+    const double heps = 1.0e-6;
+    const double TINY = 1.0e-6;
+    const double LARGE_DIAG_THRESHOLD = 1000000.0;
+    const vector<SolutionInfo>& smkts = aSolutionSet.getSolvableSet();
+
+    list<int> cols;
+    for( int j = 0; j < x.size(); ++j ) {
+        map<string, double>::const_iterator iter = mCachedDiagonal.find( smkts[ j ].getName() );
+        if( iter != mCachedDiagonal.end() ) {
+            diag[ j ] = ( *iter ).second;
+        }
+        else {
+            cols.push_back( j );
+        }
+    }
+
+    if( !cols.empty() ) {
+        Timer& jacTimer = TimerRegistry::getInstance().getTimer( TimerRegistry::JACOBIAN );
+        jacTimer.start();
+        scenario->getManageStateVariables()->setPartialDeriv( true );
+        UBVECTOR xx( x );
+        UBVECTOR fxx( fx.size() );
+        for( int j : cols ) {
+            double t = xx[ j ];
+            double h = heps * ( fabs( t ) + TINY );
+            xx[ j ] = t + h;
+            h = xx[ j ] - t;
+            F.partial( j );
+            F( xx, fxx, j );
+            xx[ j ] = t;
+
+            double currDiag = ( fxx[ j ] - fx[ j ] ) / h;
+            // avoid very large / small diagonal values which are almost always
+            // due to discontinous behavior in the underlying market
+            if( currDiag == 0 || !util::isValidNumber( currDiag ) ) {
+                currDiag = 1.0;
+            }
+            else if( fabs( currDiag ) > LARGE_DIAG_THRESHOLD ) {
+                currDiag *= LARGE_DIAG_THRESHOLD / fabs( currDiag );
+            }
+            else if( fabs( currDiag ) < 1.0 / LARGE_DIAG_THRESHOLD ) {
+                currDiag /= fabs( currDiag ) * LARGE_DIAG_THRESHOLD;
+            }
+            diag[ j ] = currDiag;
+            mCachedDiagonal[ smkts[ j ].getName() ] = currDiag;
+        }
+        F.partial( -1 );
+        jacTimer.stop();
+        neval += cols.size();
+    }
+}
+
+/*!
+ * \brief Approximately solve J . dx = -fx with right preconditioned GMRES.
+ * \details The products of the Jacobian with each Krylov basis vector are
+ *          calculated with a finite-difference directional derivative, i.e.
+ *          a single full model evaluation each.  The iterations stop when the
+ *          relative residual falls below mKrylovTol or after mKrylovDim
+ *          iterations.  Note no restarts are done since a truncated step is
+ *          still useful to the line search.
+ * \param F The excess demand function.
+ * \param x The current point.
+ * \param fx F( x ).
+ * \param diag The diagonal preconditioner.
+ * \param dx The Newton step, output.
+ * \param Jdx The approximation of J . dx from the Arnoldi relation, output.
+ * \param neval The running count of model evaluations.
+ * \return The number of GMRES iterations performed.
+ */
+int NewtonKrylov::gmres( LogEDFun& F, const UBVECTOR& x, const UBVECTOR& fx, const UBVECTOR& diag,
+                         UBVECTOR& dx, UBVECTOR& Jdx, int& neval )
+{
+    const double heps = 1.0e-6;
+    const int n = x.size();
+    const int m = min<int>( mKrylovDim, n );
+
+    UBMATRIX V( n, m + 1 );
+    UBMATRIX H( UBMATRIX::Zero( m + 1, m ) );
+    UBVECTOR cs( m ), sn( m ), g( UBVECTOR::Zero( m + 1 ) );
+
+    const double beta = fx.norm();
+    V.col( 0 ) = -fx / beta;
+    g[ 0 ] = beta;
+
+    // the Hessenberg matrix before the Givens rotations are applied which is
+    // needed to recover J . dx
+    UBMATRIX Horig( UBMATRIX::Zero( m + 1, m ) );
+    UBVECTOR xx( n ), fxx( n ), w( n );
+    const double xnorm = x.norm();
+    int k = 0;
+    while( k < m ) {
+        // w = J . M^-1 . v_k
+        UBVECTOR z = V.col( k ).cwiseQuotient( diag );
+        const double h = heps * ( 1.0 + xnorm ) / z.norm();
+        xx = x + h * z;
+        F( xx, fxx );
+        ++neval;
+        w = ( fxx - fx ) / h;
+
+        // Arnoldi with modified Gram-Schmidt
+        for( int i = 0; i <= k; ++i ) {
+            H( i, k ) = w.dot( V.col( i ) );
+            w -= H( i, k ) * V.col( i );
+        }
+        H( k + 1, k ) = w.norm();
+        Horig.col( k ) = H.col( k );
+        if( H( k + 1, k ) > 0 ) {
+            V.col( k + 1 ) = w / H( k + 1, k );
+        }
+
+        // apply the previous Givens rotations to the new column
+        for( int i = 0; i < k; ++i ) {
+            const double tmp = cs[ i ] * H( i, k ) + sn[ i ] * H( i + 1, k );
+            H( i + 1, k ) = -sn[ i ] * H( i, k ) + cs[ i ] * H( i + 1, k );
+            H( i, k ) = tmp;
+        }
+        // and compute a new one to eliminate H( k + 1, k )
+        const double r = hypot( H( k, k ), H( k + 1, k ) );
+        cs[ k ] = r > 0 ? H( k, k ) / r : 1.0;
+        sn[ k ] = r > 0 ? H( k + 1, k ) / r : 0.0;
+        H( k, k ) = r;
+        H( k + 1, k ) = 0.0;
+        g[ k + 1 ] = -sn[ k ] * g[ k ];
+        g[ k ] = cs[ k ] * g[ k ];
+
+        const bool isBreakdown = Horig( k + 1, k ) == 0;
+        ++k;
+        if( fabs( g[ k ] ) <= mKrylovTol * beta || isBreakdown ) {
+            break;
+        }
+    }
+
+    // solve the upper triangular system H . y = g
+    UBVECTOR y( k );
+    for( int i = k - 1; i >= 0; --i ) {
+        double sum = g[ i ];
+        for( int j = i + 1; j < k; ++j ) {
+            sum -= H( i, j ) * y[ j ];
+        }
+        y[ i ] = H( i, i ) != 0 ? sum / H( i, i ) : 0.0;
+    }
+
+    // dx = M^-1 . V_k . y and J . dx = V_k+1 . Horig . y
+    dx = ( V.leftCols( k ) * y ).cwiseQuotient( diag );
+    Jdx = V.leftCols( k + 1 ) * ( Horig.topLeftCorner( k + 1, k ) * y );
+    return k;
+}
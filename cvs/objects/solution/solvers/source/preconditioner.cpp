@@ -177,7 +177,7 @@ SolverComponent::ReturnCode Preconditioner::solve( SolutionInfoSet& aSolutionSet
     
     // set up some scratch data
     int nmkt = aSolutionSet.getNumSolvable();
-    std::vector<SolutionInfo> solvable = aSolutionSet.getSolvableSet();
+    std::vector<SolutionInfo>& solvable = aSolutionSet.getSolvableSet();
     bool isCalibrationPeriod = aPeriod <= scenario->getModeltime()->getFinalCalibrationPeriod();
 
     solverLog << "Preconditioning " << nmkt << " markets.\n";
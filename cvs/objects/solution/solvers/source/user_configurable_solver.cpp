@@ -217,16 +217,7 @@ bool UserConfigurableSolver::solve( const int aPeriod, const SolutionInfoParamPa
     // Print unsolved markets.
     solution_set.printUnsolved( mainLog );
     
-    if( conf->shouldWriteFile( "supplyDemandOutputFileName" ) ) {
-        string logName = conf->getFile( "supplyDemandOutputFileName", "supply_demand_curves" );
-        if( conf->shouldAppendScnToFile( "supplyDemandOutputFileName" ) ) {
-            logName = util::appendScenarioToFileName( logName );
-        }
-        ILogger& sdLog = ILogger::getLogger( logName );
-        sdLog.setLevel( ILogger::WARNING );
-        sdLog << "Supply and demand curves for markets that did not solve in period: " << aPeriod << endl;
-        solution_set.findAndPrintSD( world, marketplace, aPeriod, sdLog );
-    }
+    solution_set.writeSDCurves( world, marketplace, aPeriod );
 
     // log price forecast performance
     if( conf->getBool( "debugChecking" ) && aPeriod > 0 ) {
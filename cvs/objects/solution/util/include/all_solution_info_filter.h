@@ -69,6 +69,8 @@ public:
     
     // ISolutionInfoFilter methods
     virtual bool acceptSolutionInfo( const SolutionInfo& aSolutionInfo ) const;    
+
+    virtual bool isStatic() const;
 };
 
 #endif // _ALL_SOLUTION_INFO_FILTER_H_
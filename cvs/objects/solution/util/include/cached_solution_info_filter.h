@@ -0,0 +1,90 @@
+#ifndef _CACHED_SOLUTION_INFO_FILTER_H_
+#define _CACHED_SOLUTION_INFO_FILTER_H_
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+
+
+/*! 
+ * \file cached_solution_info_filter.h  
+ * \ingroup Objects
+ * \brief Header file for the CachedSolutionInfoFilter class.
+ */
+#include <vector>
+
+#include "solution/util/include/isolution_info_filter.h"
+
+class IInfo;
+
+/*!
+ * \ingroup Objects
+ * \brief A solution info filter which remembers the result of a static
+ *        filter for each market so that it only needs to be evaluated once
+ *        per model period.
+ * \details Filters such as market-matches may be relatively expensive to
+ *          evaluate and solver components will update the solvable set with
+ *          them many times per period.  Since the result of a static filter
+ *          can not change during a period, see ISolutionInfoFilter::isStatic,
+ *          this filter stores the results in a bitset indexed by the market
+ *          serial number.  The markets are assigned new serial numbers and
+ *          market info objects each period so we store the market info each
+ *          result was calculated for to know when it must be recalculated.
+ *          This filter is not parsed directly but rather is created by the
+ *          SolutionInfoFilterFactory to wrap the static parts of a filter
+ *          string.
+ */
+class CachedSolutionInfoFilter : public ISolutionInfoFilter {
+public:
+    CachedSolutionInfoFilter( ISolutionInfoFilter* aWrappedFilter );
+    virtual ~CachedSolutionInfoFilter();
+    
+    // ISolutionInfoFilter methods
+    virtual bool acceptSolutionInfo( const SolutionInfo& aSolutionInfo ) const;
+
+    virtual bool isStatic() const;
+    
+private:
+    //! The static filter for which results are cached
+    ISolutionInfoFilter* mWrappedFilter;
+
+    //! The market info of the market each cached result is for, by serial number
+    mutable std::vector<const IInfo*> mCachedMarket;
+
+    //! The cached result of the wrapped filter, by serial number
+    mutable std::vector<bool> mIsAccepted;
+};
+
+#endif // _CACHED_SOLUTION_INFO_FILTER_H_
@@ -78,8 +78,10 @@ class LogEDFun : public VecFVec
   
   //! \details This need not (and generally will not) include all of
   //! the markets in the model.  Markets not included in the list will
-  //! have their prices held constant.
-  std::vector<SolutionInfo> mkts;
+  //! have their prices held constant.  This is a reference to the
+  //! solvable set in solnset rather than a copy so the solvable set
+  //! must not be updated while this object is in use.
+  std::vector<SolutionInfo> &mkts;
 
   SolutionInfoSet &solnset;         //!< All SolutionInfo objects,
                                     //!including ones not being
@@ -103,6 +105,7 @@ public:
   virtual void operator()(const UBVECTOR &x, UBVECTOR &fx, const int partj=-1);
   virtual void partial(int ip);
   virtual double partialSize(int ip) const;
+  virtual void evaluateBatch(const std::vector<UBVECTOR> &axs, std::vector<UBVECTOR> &fxs);
   void scaleInitInputs(UBVECTOR &ax);
   void setSlope(UBVECTOR &adx);
 
@@ -118,6 +121,9 @@ protected:
   UBVECTOR mfxscl;
   // supply correction slope to use for prices below the "lower bound"
   UBVECTOR slope;
+
+  void setPrices(const UBVECTOR &x);
+  void calcOutputs(const UBVECTOR &x, UBVECTOR &fx);
     
 };  
 
@@ -45,6 +45,7 @@
  */
 
 #include <iostream>
+#include <vector>
 #include "solution/util/include/ublas-helpers.hpp"
 
 /*!
@@ -107,6 +108,23 @@ public:
    * derivative.
    */
   virtual double partialSize(int ip) const {return 1.0;}
+  /*!
+   * Evaluates the function at several points.
+   *
+   * Subclasses which are able to may evaluate the points concurrently.
+   * The default implementation simply evaluates each in turn.  Callers
+   * should make no assumption about which point, if any, the function's
+   * internal state corresponds to afterward.
+   * @param[in] args: The argument vectors to evaluate.
+   * @param[out] rvals: The return value vectors, one per argument.
+   */
+  virtual void evaluateBatch(const std::vector<UBVECTOR> &args, std::vector<UBVECTOR> &rvals) {
+    rvals.resize(args.size());
+    for(size_t i=0; i<args.size(); ++i) {
+      rvals[i].resize(nr);
+      (*this)(args[i], rvals[i]);
+    }
+  }
   /*!
    * Turns on implementation-defined diagnostics (default is no-op)
    */
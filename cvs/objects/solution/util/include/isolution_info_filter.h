@@ -44,7 +44,9 @@
  * \author Pralit Patel
  */
 
-class SolutionInfo;
+#include <vector>
+
+#include "solution/util/include/solution_info.h"
 
 /*!
  * \ingroup Objects
@@ -66,9 +68,47 @@ public:
      * \return True if the SolutionInfo should be included, false otherwise.
      */
     virtual bool acceptSolutionInfo( const SolutionInfo& aSolutionInfo ) const = 0;
+
+    inline virtual void acceptSolutionInfos( const std::vector<SolutionInfo>& aSolutionInfos,
+                                             std::vector<bool>& aIsAccepted ) const;
+
+    inline virtual bool isStatic() const;
 };
 
 // Inline function definitions.
 ISolutionInfoFilter::~ISolutionInfoFilter(){
 }
+
+/*!
+ * \brief Determine which of the given SolutionInfos should be included in the
+ *        solution set.
+ * \details Filters which combine other filters may override this method to
+ *          operate on the results of the contained filters for the entire set
+ *          at once.
+ * \param aSolutionInfos The SolutionInfos to test.
+ * \param aIsAccepted Output: for each SolutionInfo, by position, whether it
+ *                    should be included.
+ */
+void ISolutionInfoFilter::acceptSolutionInfos( const std::vector<SolutionInfo>& aSolutionInfos,
+                                               std::vector<bool>& aIsAccepted ) const
+{
+    aIsAccepted.resize( aSolutionInfos.size() );
+    for( size_t i = 0; i < aSolutionInfos.size(); ++i ) {
+        aIsAccepted[ i ] = acceptSolutionInfo( aSolutionInfos[ i ] );
+    }
+}
+
+/*!
+ * \brief Whether the result of this filter only depends on properties of a
+ *        market which do not change within a model period such as the name,
+ *        type, or market info flags.
+ * \details The result of a static filter for each market can be computed once
+ *          per period and reused, see CachedSolutionInfoFilter.  Filters which
+ *          depend on the state of the solution, such as prices or whether a
+ *          market is solved, are not static.
+ * \return True if the filter is static, false otherwise.
+ */
+bool ISolutionInfoFilter::isStatic() const {
+    return false;
+}
 #endif // _ISOLUTION_INFO_FILTER_H_
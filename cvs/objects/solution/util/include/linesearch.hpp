@@ -48,6 +48,7 @@
 #include "solution/util/include/ublas-helpers.hpp"
 #include <algorithm>
 #include <iostream>
+#include <vector>
 
 
 /*!
@@ -70,7 +71,7 @@
  * \return : 0= success, anything else= fail
  *
  */
-int linesearch(VecFVec &f, const UBVECTOR &x0,
+inline int linesearch(VecFVec &f, const UBVECTOR &x0,
                double f0, const UBVECTOR &g0,
                const UBVECTOR &dx, UBVECTOR &x,
                double &fx, UBVECTOR& fxVec, const double fxIncr, int &neval, std::ostream *solverlog = 0)
@@ -151,4 +152,106 @@ int linesearch(VecFVec &f, const UBVECTOR &x0,
   return 1;              
 }
 
+/*!
+ * Perform a speculative line search which evaluates a ladder of step lengths at once.
+ * \details The same sufficient decrease condition as linesearch() is used however rather
+ *          than backtracking one step length at a time a geometric ladder of step lengths
+ *          lambda, lambda*r, lambda*r^2, ... is evaluated with a single call to
+ *          VecFVec::evaluateBatch, which may evaluate them concurrently.  Of the steps that
+ *          satisfy the condition the one with the smallest f(x) is taken.  If none do the
+ *          next ladder continues from the smallest step length tried.  Once a step has been
+ *          chosen it is evaluated once more with the normal operator() so that the function's
+ *          state corresponds to the accepted point.
+ * \param[in]  f: A function adaptor for computing f(x) = F*F (for vector-valued F)
+ * \param[in] x0: Starting point for the step
+ * \param[in] f0: Value of f(x0)
+ * \param[in] g0: Value of grad-f(x0)
+ * \param[in] dx: Proposed step from the root finder
+ * \param[out] x: Final step determined by the search
+ * \param[out] fx: Value of f(x)
+ * \param[in] fxVec: The value of F(x)
+ * \param[in] fxIncr: The maximum increase of f(x) we will allow to consider linesearch a success.
+ * \param[in] ladderSize: The number of step lengths to evaluate at once.
+ * \param[in] ladderRatio: The ratio between successive step lengths.
+ * \param[inout]neval: number of function evaluations. The subroutine
+ * adds whatever value is passed in, allowing the caller to keep a
+ * running total.
+ * \return : 0= success, anything else= fail
+ */
+inline int speculativeLinesearch(VecFVec &f, const UBVECTOR &x0,
+                                 double f0, const UBVECTOR &g0,
+                                 const UBVECTOR &dx, UBVECTOR &x,
+                                 double &fx, UBVECTOR& fxVec, const double fxIncr,
+                                 const int ladderSize, const double ladderRatio,
+                                 int &neval, std::ostream *solverlog = 0)
+{
+  const double lseps = 1.0e-7;   // same as linesearch()
+  const double lmin = 1.0e-6;    // same as TOLX in linesearch()
+  // a ratio outside of (0,1) would never shrink the steps
+  const double ratio = ladderRatio > 0.0 && ladderRatio < 1.0 ? ladderRatio : 0.5;
+  double g0dx=g0.dot(dx);
+  double lambda = 1.0;
+
+  if(g0dx >= 0) {
+    if(solverlog)
+      (*solverlog) << "Linesearch aborted.  Not an initial descent direction.  g0dx= "
+                   << g0dx << "\n";
+    return 1;
+  }
+
+  if(solverlog)
+    (*solverlog) << "Beginning speculative linesearch: ladder = " << ladderSize
+                 << "  ratio = " << ratio << "  f0 = " << f0 << "\n";
+
+  std::vector<UBVECTOR> xs;
+  std::vector<UBVECTOR> fxs;
+  std::vector<double> lambdas;
+  while(lambda > lmin) {
+    xs.clear();
+    lambdas.clear();
+    for(int k=0; k<ladderSize && lambda > lmin; ++k) {
+      lambdas.push_back(lambda);
+      xs.push_back(x0 + lambda*dx);
+      lambda *= ratio;
+    }
+    f.evaluateBatch(xs, fxs);
+    neval += xs.size();
+
+    int best = -1;
+    double fbest = 0.0;
+    for(size_t k=0; k<xs.size(); ++k) {
+      double fk = fxs[k].dot(fxs[k]);
+      if(solverlog) {
+        (*solverlog) << "\tlambda = " << lambdas[k] << "  fx = " << fk << std::endl;
+      }
+      if(util::isValidNumber(fk) && fk <= f0 + lseps*lambdas[k]*g0dx + fxIncr &&
+         (best == -1 || fk < fbest)) {
+        best = k;
+        fbest = fk;
+      }
+    }
+
+    if(best != -1) {
+      // SUCCESS, make sure the function state reflects the step we are taking
+      x = xs[best];
+      f(x, fxVec);
+      fx = fxVec.dot(fxVec);
+      neval++;
+      if(solverlog) {
+        (*solverlog) << "\taccepted lambda = " << lambdas[best] << "  fx = " << fx << std::endl;
+      }
+      return 0;
+    }
+  }
+
+  // None of the step lengths were acceptable.  As with linesearch() we leave
+  // the smallest step tried as the result, evaluated so that the function's
+  // state is consistent with it.
+  x = xs.back();
+  f(x, fxVec);
+  fx = fxVec.dot(fxVec);
+  neval++;
+  return 1;
+}
+
 #endif
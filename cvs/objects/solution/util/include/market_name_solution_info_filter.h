@@ -77,6 +77,8 @@ public:
     
     // ISolutionInfoFilter methods
     virtual bool acceptSolutionInfo( const SolutionInfo& aSolutionInfo ) const;
+
+    virtual bool isStatic() const;
     
 private:
     //! The name of the market which will be accepted
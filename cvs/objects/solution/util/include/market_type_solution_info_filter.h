@@ -74,6 +74,8 @@ public:
     
     // ISolutionInfoFilter methods
     virtual bool acceptSolutionInfo( const SolutionInfo& aSolutionInfo ) const;
+
+    virtual bool isStatic() const;
     
 private:
     //! The market type which will be accepted
@@ -44,6 +44,7 @@
  * \author Pralit Patel
  */
 #include <string>
+#include <vector>
 
 #include "solution/util/include/isolution_info_filter.h"
 
@@ -72,6 +73,11 @@ public:
     
     // ISolutionInfoFilter methods
     virtual bool acceptSolutionInfo( const SolutionInfo& aSolutionInfo ) const;
+
+    virtual void acceptSolutionInfos( const std::vector<SolutionInfo>& aSolutionInfos,
+                                      std::vector<bool>& aIsAccepted ) const;
+
+    virtual bool isStatic() const;
     
 private:
     //! The wrapped filter to be negated
@@ -78,6 +78,11 @@ public:
     
     // ISolutionInfoFilter methods
     virtual bool acceptSolutionInfo( const SolutionInfo& aSolutionInfo ) const;
+
+    virtual void acceptSolutionInfos( const std::vector<SolutionInfo>& aSolutionInfos,
+                                      std::vector<bool>& aIsAccepted ) const;
+
+    virtual bool isStatic() const;
     
 private:
     //! The vector of contained filters to be ored
@@ -103,6 +103,8 @@ public:
     double getDemand() const;
     double getSupply() const;
     double getED() const;
+    double getLeftBracket() const;
+    double getRightBracket() const;
     double getEDLeft() const;
     double getEDRight() const;
     double getSolutionFloor() const;
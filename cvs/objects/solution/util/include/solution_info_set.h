@@ -77,6 +77,26 @@ public:
       demand
     };
 
+    /*!
+     * \brief Contiguous copies of the per market solution state.
+     * \details The values are stored as a structure of arrays in the same
+     *          market order as getMarketIDs so that solver algorithms and
+     *          reporting may operate on whole vectors rather than iterating
+     *          over SolutionInfo objects.  The arrays are only reallocated
+     *          when the number of markets changes so a MarketState may be
+     *          reused across iterations.
+     */
+    struct MarketState {
+        std::vector<double> mPrice;
+        std::vector<double> mSupply;
+        std::vector<double> mDemand;
+        std::vector<double> mLeftBracket;
+        std::vector<double> mRightBracket;
+        std::vector<double> mEDLeft;
+        std::vector<double> mEDRight;
+        std::vector<bool> mIsBracketed;
+    };
+
     typedef std::vector<SolutionInfo>::iterator SetIterator;
     typedef std::vector<SolutionInfo>::const_iterator ConstSetIterator;
     SolutionInfoSet( Marketplace* marketplace );
@@ -104,8 +124,9 @@ public:
     SolutionInfo& getSolvable( unsigned int index );
     const SolutionInfo& getAny( unsigned int index ) const;
     SolutionInfo& getAny( unsigned int index );
-    std::vector<SolutionInfo> getSolvableSet() const;
-    std::vector<SolutionInfo> getUnsolvableSet() const;
+    const std::vector<SolutionInfo>& getSolvableSet() const;
+    std::vector<SolutionInfo>& getSolvableSet();
+    const std::vector<SolutionInfo>& getUnsolvableSet() const;
     std::vector<SolutionInfo> getSolvedSet() const;
     std::vector<SolutionInfo> getUnsolvedSet() const;
     bool isAllSolved();
@@ -113,17 +134,18 @@ public:
     void unsetBisectedFlag();
     void printUnsolved( std::ostream& out );
     void findAndPrintSD( World* aWorld, Marketplace* aMarketplace, const int aPeriod, std::ostream& aOut );
+    void writeSDCurves( World* aWorld, Marketplace* aMarketplace, const int aPeriod );
     void printMarketInfo( const std::string& comment, const double worldCalcCount, std::ostream& out ) const;
     void printDerivatives( std::ostream& aOut ) const;
 
     // following functions are used for reporting into solver data log
     const std::vector<int> &getMarketIDs(std::vector<int> &aMktids, bool aSolvableOnly) const;
+    void getMarketState( MarketState& aState, const bool aSolvableOnly ) const;
     
 private:
     unsigned int period;
     Marketplace* marketplace;
     std::vector<SolutionInfo> solvable;
-    std::vector<SolutionInfo> unsolved; // solvable markets that are not currently solved
     std::vector<SolutionInfo> unsolvable;
     void print( std::ostream& out ) const;
 };
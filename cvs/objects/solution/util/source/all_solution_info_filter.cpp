@@ -60,3 +60,7 @@ const string& AllSolutionInfoFilter::getXMLNameStatic() {
 bool AllSolutionInfoFilter::acceptSolutionInfo( const SolutionInfo& aSolutionInfo ) const {
     return true;
 }
+
+bool AllSolutionInfoFilter::isStatic() const {
+    return true;
+}
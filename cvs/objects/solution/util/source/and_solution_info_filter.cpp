@@ -75,3 +75,27 @@ bool AndSolutionInfoFilter::acceptSolutionInfo( const SolutionInfo& aSolutionInf
     // none of the contained filters returned false so we can return true
     return true;
 }
+
+void AndSolutionInfoFilter::acceptSolutionInfos( const vector<SolutionInfo>& aSolutionInfos,
+                                                 vector<bool>& aIsAccepted ) const
+{
+    // no filters is always true and each contained filter can only
+    // remove solution infos from the accepted set
+    aIsAccepted.assign( aSolutionInfos.size(), true );
+    vector<bool> currAccepted;
+    for( CSolutionInfoFilterIterator currFilter = mFilters.begin(); currFilter != mFilters.end(); ++currFilter ) {
+        (*currFilter)->acceptSolutionInfos( aSolutionInfos, currAccepted );
+        for( size_t i = 0; i < aIsAccepted.size(); ++i ) {
+            aIsAccepted[ i ] = aIsAccepted[ i ] && currAccepted[ i ];
+        }
+    }
+}
+
+bool AndSolutionInfoFilter::isStatic() const {
+    for( CSolutionInfoFilterIterator currFilter = mFilters.begin(); currFilter != mFilters.end(); ++currFilter ) {
+        if( !(*currFilter)->isStatic() ) {
+            return false;
+        }
+    }
+    return true;
+}
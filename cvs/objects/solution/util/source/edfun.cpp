@@ -46,6 +46,11 @@
 
 #include "util/base/include/timer.h"
 
+#if GCAM_PARALLEL_ENABLED
+#include <tbb/task_group.h>
+#include <tbb/parallel_for.h>
+#endif
+
 extern Scenario* scenario;
 
 const double LogEDFun::PMAX = 1.0e24;
@@ -219,26 +224,7 @@ void LogEDFun::operator()(const UBVECTOR &ax, UBVECTOR &fx, const int partj)
 
     mktplc->nullSuppliesAndDemands(period);
 
-    /* set prices into the marketplace. If the inputs are log-prices,
-       we have to exp() them first*/
-    if(mLogPricep) {
-      /***** In part 3 we make some exceptions for certain market
-       ***** types.  Perhaps we should consider doing that here too.
-       ***** E.g., we could make the inputs for price and demand
-       ***** markets always linear.
-       *****/
-      for(size_t i=0; i<x.size(); ++i) {
-        if(x[i] > ARGMAX)
-          mkts[i].setPrice(PMAX);
-        else
-          mkts[i].setPrice(exp(x[i])); // input vector = log(price)
-      }
-    }
-    else {
-      for(size_t i=0; i<x.size(); ++i) {
-        mkts[i].setPrice(x[i]); // input vector = price
-      }
-    }
+    setPrices(x);
     edfunMiscTimer.stop();
     edfunPreTimer.stop(); 
 
@@ -331,6 +317,49 @@ void LogEDFun::operator()(const UBVECTOR &ax, UBVECTOR &fx, const int partj)
    *   output vector
    ****/
   
+  calcOutputs(x, fx);
+  
+  edfunPostTimer.stop();
+
+  edfunMiscTimer.stop();
+}
+
+
+/*!
+ * \brief Set the prices of all markets being solved into the marketplace.
+ * \details If the inputs are log-prices we have to exp() them first.
+ * \param x The (unscaled) prices or log-prices to set.
+ */
+void LogEDFun::setPrices(const UBVECTOR &x)
+{
+    if(mLogPricep) {
+      /***** In calcOutputs we make some exceptions for certain market
+       ***** types.  Perhaps we should consider doing that here too.
+       ***** E.g., we could make the inputs for price and demand
+       ***** markets always linear.
+       *****/
+      for(size_t i=0; i<x.size(); ++i) {
+        if(x[i] > ARGMAX)
+          mkts[i].setPrice(PMAX);
+        else
+          mkts[i].setPrice(exp(x[i])); // input vector = log(price)
+      }
+    }
+    else {
+      for(size_t i=0; i<x.size(); ++i) {
+        mkts[i].setPrice(x[i]); // input vector = price
+      }
+    }
+}
+
+/*!
+ * \brief Collect the outputs from the solutionInfo objects after the supplies
+ *        and demands have been recalculated and repack them into the output vector.
+ * \param x The (unscaled) prices or log-prices which were evaluated.
+ * \param fx The scaled output vector to fill in.
+ */
+void LogEDFun::calcOutputs(const UBVECTOR &x, UBVECTOR &fx)
+{
   // at this point we've recalculated all the supplies and demands.
   // Retrieve them, calculate output according to market type, and
   // store them in fx
@@ -397,9 +426,57 @@ void LogEDFun::operator()(const UBVECTOR &ax, UBVECTOR &fx, const int partj)
   // Do the scaling for fx
   for(unsigned i=0; i<fx.size(); ++i)
       fx[i] *= mfxscl[i];
-  
-  edfunPostTimer.stop();
-
-  edfunMiscTimer.stop();
 }
 
+/*!
+ * \brief Evaluate F at several points concurrently.
+ * \details Each point is a full model evaluation which is done in the "scratch"
+ *          state row of the worker thread which picks it up rather than in the
+ *          "base" state.  This reuses the partial derivative machinery:  the
+ *          scratch row is reset to the base state, all prices are set, and every
+ *          activity in the global ordering is recalculated such that the market
+ *          supplies and demands, which accumulate differences from the base state,
+ *          reflect the new prices.  Each point is calculated serially by one thread
+ *          so up to max-parallelism points are evaluated at once.
+ *
+ *          Since the "base" state is not updated the model state after this call
+ *          corresponds to the last point evaluated with operator().  A caller which
+ *          decides to move to one of the points must evaluate it with operator()
+ *          before calculating derivatives from there.
+ * \param axs The points to evaluate.
+ * \param fxs The value of F at each point, resized as necessary.
+ */
+void LogEDFun::evaluateBatch(const std::vector<UBVECTOR> &axs, std::vector<UBVECTOR> &fxs)
+{
+#if !GCAM_PARALLEL_ENABLED
+    VecFVec::evaluateBatch(axs, fxs);
+#else
+    fxs.resize(axs.size());
+    ManageStateVariables* stateVars = scenario->mManageStateVars;
+    Timer& evalBatchTimer = TimerRegistry::getInstance().getTimer( TimerRegistry::EVAL_FULL );
+    evalBatchTimer.start();
+    stateVars->setPartialDeriv(true);
+    mktplc->mIsDerivativeCalc = true;
+
+    tbb::task_group tg;
+    stateVars->mThreadPool.execute([&](){
+        tg.run([&](){
+            tbb::parallel_for(size_t(0), axs.size(), [&](size_t k) {
+                // start from the base state in this thread's scratch row
+                stateVars->copyState();
+                UBVECTOR x(axs[k].size());
+                for(unsigned int i=0; i<x.size(); ++i)
+                    x[i] = axs[k][i]*mxscl[i];
+                setPrices(x);
+                world->calc(period);
+                fxs[k].resize(nr);
+                calcOutputs(x, fxs[k]);
+            });
+        });
+    });
+    stateVars->mThreadPool.execute([&tg](){ tg.wait(); });
+
+    partial(-1);
+    evalBatchTimer.stop();
+#endif
+}
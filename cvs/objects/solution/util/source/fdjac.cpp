@@ -54,20 +54,34 @@ void jacol(VecFVec &F, const UBVECTOR &x,
                   bool usepartial, std::ostream *diagnostic) {
   const double heps = 1.0e-6;
   const double TINY = 1.0e-6;
+  // If a step leaves F unchanged we retry with a step this many times larger,
+  // up to MAX_STEP_RETRIES times.  A column of zeros would otherwise make the
+  // Jacobian singular although it is often just an artifact of the step being
+  // too small to register through a flat or stepwise region of the model.
+  const double STEP_GROWTH = 100.0;
+  const int MAX_STEP_RETRIES = 2;
   UBVECTOR xx(x); // temporary, so we can respect the const on x
   UBVECTOR fxx(fx.size());        // hold the values of F(xx)
   double t = xx[j];            // store the old value
-  double h = heps * (fabs(t)+TINY);
-  
-  xx[j] = t+h;
-  h     = xx[j]-t; // reduce roundoff error, since (t+h)-t is not
-                   // necessarily identical to the original h
-  if(diagnostic) {
-      (*diagnostic) << "j= " << j << "\th= " << h << "\nxx:\n" << xx << "\n";
+  double hscl = heps;
+  double h;
+  for(int attempt = 0; ; ++attempt) {
+    h = hscl * (fabs(t)+TINY);
+    xx[j] = t+h;
+    h     = xx[j]-t; // reduce roundoff error, since (t+h)-t is not
+                     // necessarily identical to the original h
+    if(diagnostic) {
+        (*diagnostic) << "j= " << j << "\th= " << h << "\nxx:\n" << xx << "\n";
+    }
+    if(usepartial) {F.partial(j);}    // hint to the function that this is a partial derivative calculation
+      F(xx,fxx, usepartial ? j : -1);       // eval the function
+    xx[j] = t;       // restore the old value
+
+    if(attempt == MAX_STEP_RETRIES || fxx != fx) {
+      break;
+    }
+    hscl *= STEP_GROWTH;
   }
-  if(usepartial) {F.partial(j);}    // hint to the function that this is a partial derivative calculation
-    F(xx,fxx, usepartial ? j : -1);       // eval the function
-  xx[j] = t;       // restore the old value
   
   if(diagnostic) {
     (*diagnostic) << "fxx:\n" << fxx << "\n";
@@ -67,3 +67,7 @@ bool HasMarketFlagSolutionInfoFilter::acceptSolutionInfo( const SolutionInfo& aS
     assert( !mMarketInfoKey.empty() );
     return aSolutionInfo.getMarketInfo()->getBoolean( mMarketInfoKey, false );
 }
+
+bool HasMarketFlagSolutionInfoFilter::isStatic() const {
+    return true;
+}
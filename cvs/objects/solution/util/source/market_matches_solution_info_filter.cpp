@@ -61,4 +61,8 @@ const string& MarketMatchesSolutionInfoFilter::getXMLNameStatic() {
 
 bool MarketMatchesSolutionInfoFilter::acceptSolutionInfo( const SolutionInfo& aSolutionInfo ) const {
     return regex_search(aSolutionInfo.getName(), mAcceptMarketMatches);
-}
\ No newline at end of file
+}
+
+bool MarketMatchesSolutionInfoFilter::isStatic() const {
+    return true;
+}
@@ -67,3 +67,7 @@ bool MarketNameSolutionInfoFilter::acceptSolutionInfo( const SolutionInfo& aSolu
     
     return mAcceptMarketName == aSolutionInfo.getName();
 }
+
+bool MarketNameSolutionInfoFilter::isStatic() const {
+    return true;
+}
@@ -100,3 +100,7 @@ IMarketType::Type MarketTypeSolutionInfoFilter::getMarketTypeFromString( const s
         << getXMLNameStatic() << "." << endl;
     return IMarketType::END;
 }
+
+bool MarketTypeSolutionInfoFilter::isStatic() const {
+    return true;
+}
@@ -63,3 +63,15 @@ bool NotSolutionInfoFilter::acceptSolutionInfo( const SolutionInfo& aSolutionInf
     // return the opposite of the wrapped filter
     return !mWrappedFilter->acceptSolutionInfo( aSolutionInfo );
 }
+
+void NotSolutionInfoFilter::acceptSolutionInfos( const vector<SolutionInfo>& aSolutionInfos,
+                                                 vector<bool>& aIsAccepted ) const
+{
+    // return the opposite of the wrapped filter
+    mWrappedFilter->acceptSolutionInfos( aSolutionInfos, aIsAccepted );
+    aIsAccepted.flip();
+}
+
+bool NotSolutionInfoFilter::isStatic() const {
+    return mWrappedFilter->isStatic();
+}
@@ -80,3 +80,26 @@ bool OrSolutionInfoFilter::acceptSolutionInfo( const SolutionInfo& aSolutionInfo
     // none of the contained filters returned true so we can return false
     return false;
 }
+
+void OrSolutionInfoFilter::acceptSolutionInfos( const vector<SolutionInfo>& aSolutionInfos,
+                                                vector<bool>& aIsAccepted ) const
+{
+    // no filters is always true
+    aIsAccepted.assign( aSolutionInfos.size(), mFilters.empty() );
+    vector<bool> currAccepted;
+    for( CSolutionInfoFilterIterator currFilter = mFilters.begin(); currFilter != mFilters.end(); ++currFilter ) {
+        (*currFilter)->acceptSolutionInfos( aSolutionInfos, currAccepted );
+        for( size_t i = 0; i < aIsAccepted.size(); ++i ) {
+            aIsAccepted[ i ] = aIsAccepted[ i ] || currAccepted[ i ];
+        }
+    }
+}
+
+bool OrSolutionInfoFilter::isStatic() const {
+    for( CSolutionInfoFilterIterator currFilter = mFilters.begin(); currFilter != mFilters.end(); ++currFilter ) {
+        if( !(*currFilter)->isStatic() ) {
+            return false;
+        }
+    }
+    return true;
+}
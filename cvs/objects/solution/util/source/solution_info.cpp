@@ -217,6 +217,16 @@ double SolutionInfo::getED() const {
     return getDemand() - getSupply();
 }
 
+//! Get the price at the left bracket.
+double SolutionInfo::getLeftBracket() const {
+    return XL;
+}
+
+//! Get the price at the right bracket.
+double SolutionInfo::getRightBracket() const {
+    return XR;
+}
+
 //! Get the ED at the left bracket.
 double SolutionInfo::getEDLeft() const {
     return EDL;
@@ -663,7 +673,7 @@ double SolutionInfo::getUpperBoundSupplyPrice() const
 
 double SolutionInfo::getLowerBoundSupplyPriceInternal() const
 {
-    const string LOWER_BOUND_KEY = "lower-bound-supply-price";
+    static const InfoKey LOWER_BOUND_KEY( "lower-bound-supply-price" );
     return linkedMarket->getMarketInfo()->hasValue( LOWER_BOUND_KEY ) ?
         linkedMarket->getMarketInfo()->getDouble( LOWER_BOUND_KEY, true ) :
         -util::getLargeNumber();
@@ -671,7 +681,7 @@ double SolutionInfo::getLowerBoundSupplyPriceInternal() const
 
 double SolutionInfo::getUpperBoundSupplyPriceInternal() const
 {
-    const string UPPER_BOUND_KEY = "upper-bound-supply-price";
+    static const InfoKey UPPER_BOUND_KEY( "upper-bound-supply-price" );
     return linkedMarket->getMarketInfo()->hasValue( UPPER_BOUND_KEY ) ?
         linkedMarket->getMarketInfo()->getDouble( UPPER_BOUND_KEY, true ) :
         util::getLargeNumber();
@@ -705,7 +715,7 @@ void SolutionInfo::setForecastDemand(const double aDemand) {
  * \return The noramalized correction slope to use.
  */
 double SolutionInfo::getCorrectionSlope( const double aPriceScale, const double aDemandScale ) const {
-    const string SLOPE_KEY = "correction-slope";
+    static const InfoKey SLOPE_KEY( "correction-slope" );
     return linkedMarket->getMarketInfo()->hasValue( SLOPE_KEY ) ?
         linkedMarket->getMarketInfo()->getDouble( SLOPE_KEY, true ) * (aPriceScale / aDemandScale) :
         1.0;
@@ -59,6 +59,7 @@
 #include "solution/util/include/and_solution_info_filter.h"
 #include "solution/util/include/or_solution_info_filter.h"
 #include "solution/util/include/not_solution_info_filter.h"
+#include "solution/util/include/cached_solution_info_filter.h"
 
 using namespace std;
 
@@ -165,6 +166,12 @@ ISolutionInfoFilter* SolutionInfoFilterFactory::createSolutionInfoFilterFromStri
         mainLog.setLevel( ILogger::WARNING );
         mainLog << "Could not parse filter string: " << aFilterString << endl;
     }
+    // If the entire filter is static then only cache it here, otherwise
+    // the static operands have already been cached as the operators were
+    // created.
+    else if( parsedSyntaxTree->isStatic() ) {
+        parsedSyntaxTree = new CachedSolutionInfoFilter( parsedSyntaxTree );
+    }
     return parsedSyntaxTree;
 }
 
@@ -320,6 +327,19 @@ ISolutionInfoFilter* SolutionInfoFilterFactory::buildSolutionInfoFilterString( c
     if( childFilter ) {
         operands[1] = childFilter;
     }
+
+    // If only part of this operation is static then the static operands can be
+    // cached so that they are evaluated just once per period.  If the entire
+    // operation is static we instead leave it to be cached as a whole.
+    bool isAllStatic = true;
+    for( size_t i = 0; i < operands.size(); ++i ) {
+        isAllStatic = isAllStatic && ( !operands[ i ] || operands[ i ]->isStatic() );
+    }
+    for( size_t i = 0; i < operands.size() && !isAllStatic; ++i ) {
+        if( operands[ i ] && operands[ i ]->isStatic() ) {
+            operands[ i ] = new CachedSolutionInfoFilter( operands[ i ] );
+        }
+    }
     ISolutionInfoFilter* opFilter = currOpName == andOperatorStr ? static_cast<ISolutionInfoFilter*>(new AndSolutionInfoFilter(operands))
                                                                  : static_cast<ISolutionInfoFilter*>(new OrSolutionInfoFilter(operands));
     
@@ -40,6 +40,7 @@
 #include "util/base/include/definitions.h"
 #include <cassert>
 #include <algorithm>
+#include <stdexcept>
 #include "util/base/include/util.h"
 #include "solution/util/include/solution_info_set.h"
 #include "solution/util/include/solution_info.h"
@@ -51,6 +52,12 @@
 #include "marketplace/include/market.h"
 #include "solution/util/include/solution_info_param_parser.h"
 #include "containers/include/market_dependency_finder.h"
+#include "marketplace/include/warm_start_store.h"
+#include "util/base/include/auto_file.h"
+#include "util/base/include/model_time.h"
+#include "containers/include/scenario.h"
+
+extern Scenario* scenario;
 
 using namespace std;
 
@@ -95,6 +102,7 @@ void SolutionInfoSet::init( const unsigned int aPeriod, const double aDefaultSol
     // Create and initialize a SolutionInfo object for each market.
     typedef vector<Market*>::const_iterator ConstMarketIterator;
     MarketDependencyFinder* depFinder = marketplace->getDependencyFinder();
+    const WarmStartStore* warmStartStore = marketplace->getWarmStartStore();
     for( ConstMarketIterator iter = marketsToSolve.begin(); iter != marketsToSolve.end(); ++iter ){
         const bool isSolvable = (*iter)->isSolvable();
         const int marketNumber = iter - marketsToSolve.begin();
@@ -109,9 +117,15 @@ void SolutionInfoSet::init( const unsigned int aPeriod, const double aDefaultSol
 #else
         SolutionInfo currInfo( *iter, partialList );
 #endif
-        currInfo.init( aDefaultSolutionTolerance, aDefaultSolutionFloor,
-                       aSolutionInfoParamParser->getSolutionInfoValuesForMarket( (*iter)->getGoodName(), (*iter)->getRegionName(),
-                                                                                 currInfo.getTypeName(), period ) );
+        SolutionInfoParamParser::SolutionInfoValues solutionInfoValues =
+            aSolutionInfoParamParser->getSolutionInfoValuesForMarket( (*iter)->getGoodName(), (*iter)->getRegionName(),
+                                                                      currInfo.getTypeName(), period );
+        // Use the bracket interval suggested by the warm start store unless
+        // one was explicitly set.
+        if( solutionInfoValues.mBracketInterval == 0 && warmStartStore ) {
+            solutionInfoValues.mBracketInterval = warmStartStore->getBracketInterval( (*iter)->getName(), period );
+        }
+        currInfo.init( aDefaultSolutionTolerance, aDefaultSolutionFloor, solutionInfoValues );
         if( currInfo.shouldSolve( false ) ){
             solvable.push_back( currInfo );
         }
@@ -131,52 +145,59 @@ SolutionInfoSet::UpdateCode SolutionInfoSet::updateSolvable( const ISolutionInfo
     solverLog.setLevel( ILogger::DEBUG );
     solverLog << "Updating the solvable set." << endl;
 
-    // Iterate through the solvable markets and determine if any are now unsolvable.
-    for( SetIterator iter = solvable.begin(); iter != solvable.end(); ){
-        // If it should not be solved for the current method, move it to the unsolvable vector.
-        if( !aSolutionInfoFilter->acceptSolutionInfo( *iter ) ){
-            unsolvable.push_back( *iter );
-
+    // Evaluate the filter for the whole of each set at once which allows
+    // filters to reuse results across markets.
+    vector<bool> isSolvableAccepted;
+    aSolutionInfoFilter->acceptSolutionInfos( solvable, isSolvableAccepted );
+    vector<bool> isUnsolvableAccepted;
+    aSolutionInfoFilter->acceptSolutionInfos( unsolvable, isUnsolvableAccepted );
+
+    // Rebuild the sets keeping the relative order of the markets.  Markets
+    // which should no longer be solved for the current method are moved to
+    // the end of the unsolvable set and markets which should now be solved
+    // are moved to the end of the solvable set.
+    vector<SolutionInfo> newSolvable;
+    vector<SolutionInfo> newUnsolvable;
+    newSolvable.reserve( solvable.size() + unsolvable.size() );
+    newUnsolvable.reserve( solvable.size() + unsolvable.size() );
+    bool isRemoved = false;
+    bool isAdded = false;
+    for( size_t i = 0; i < solvable.size(); ++i ) {
+        if( isSolvableAccepted[ i ] ) {
+            newSolvable.push_back( std::move( solvable[ i ] ) );
+        }
+    }
+    for( size_t i = 0; i < unsolvable.size(); ++i ) {
+        if( isUnsolvableAccepted[ i ] ) {
             // Print a debugging log message.
-            solverLog << iter->getName() << " was removed from the solvable set." << endl;
-
-            // After the erase, iter will point to the next element in the array
-            iter = solvable.erase( iter );
-
-            // Update the return code.
-            code = REMOVED;
+            solverLog << unsolvable[ i ].getName() << " was added to the solvable set." << endl;
+            newSolvable.push_back( std::move( unsolvable[ i ] ) );
+            isAdded = true;
         }
-        else{
-            // If we don't erase an element, we need to increment iter
-            ++iter;
+        else {
+            newUnsolvable.push_back( std::move( unsolvable[ i ] ) );
         }
     }
-
-    // Loop through the unsolvable set to see if they should be added to the solved. 
-    // This will double check markets that were just added, slightly inefficient.
-    for( SetIterator iter = unsolvable.begin(); iter != unsolvable.end(); ){
-        // If it should be solved for the current method, move it to the solvable vector.
-        if( aSolutionInfoFilter->acceptSolutionInfo( *iter ) ){
-            solvable.push_back( *iter );
+    for( size_t i = 0; i < solvable.size(); ++i ) {
+        if( !isSolvableAccepted[ i ] ) {
             // Print a debugging log message.
-            solverLog << iter->getName() << " was added to the solvable set." << endl;
-
-            // After the erase, iter will point to the next element in the array
-            iter = unsolvable.erase( iter );
-
-            // Update return code.
-            if( code == UNCHANGED || ADDED ){
-                code = ADDED;
-            }
-            else {
-                code = ADDED_AND_REMOVED;
-            }
-        }
-        else{
-            // If we don't erase an element, we need to increment iter
-            ++iter;
+            solverLog << solvable[ i ].getName() << " was removed from the solvable set." << endl;
+            newUnsolvable.push_back( std::move( solvable[ i ] ) );
+            isRemoved = true;
         }
     }
+    solvable.swap( newSolvable );
+    unsolvable.swap( newUnsolvable );
+
+    if( isAdded && isRemoved ) {
+        code = ADDED_AND_REMOVED;
+    }
+    else if( isAdded ) {
+        code = ADDED;
+    }
+    else if( isRemoved ) {
+        code = REMOVED;
+    }
     return code;
 }
 
@@ -388,13 +409,29 @@ const SolutionInfo& SolutionInfoSet::getSolvable( unsigned int index ) const {
     return solvable.at( index );
 }
 
-//! Get the solvable set (may not be solved).
-vector<SolutionInfo> SolutionInfoSet::getSolvableSet() const{
+/*!
+ * \brief Get the solvable set (may not be solved).
+ * \details A reference to the internal set is returned to avoid copying each
+ *          SolutionInfo.  The reference is only valid until the next call to
+ *          updateSolvable or any other method which reorders the set.
+ * \return The solvable set.
+ */
+const vector<SolutionInfo>& SolutionInfoSet::getSolvableSet() const{
+    return solvable;
+}
+
+/*!
+ * \brief Get the solvable set (may not be solved).
+ * \details Non-const version of getSolvableSet which is still subject to the
+ *          same restrictions on the lifetime of the returned reference.
+ * \return The solvable set.
+ */
+vector<SolutionInfo>& SolutionInfoSet::getSolvableSet() {
     return solvable;
 }
 
-//! Get the unsolvable set
-vector<SolutionInfo> SolutionInfoSet::getUnsolvableSet() const {
+//! Get the unsolvable set, again only valid until the next updateSolvable.
+const vector<SolutionInfo>& SolutionInfoSet::getUnsolvableSet() const {
     return unsolvable;
 }
 
@@ -419,15 +456,19 @@ vector<SolutionInfo> SolutionInfoSet::getSolvedSet() const{
     return solvedSet;
 }
 
-//! Const getter which references the unsolved vector.
+/*!
+ * \brief Get the index-th solvable SolutionInfo which is not currently solved.
+ * \param index The index into the unsolved subset of the solvable markets.
+ * \return The requested unsolved SolutionInfo.
+ */
 SolutionInfo& SolutionInfoSet::getUnsolved( unsigned int index ) {
-    unsolved.clear();
+    unsigned int unsolvedCount = 0;
     for( SetIterator curr = solvable.begin(); curr != solvable.end(); ++curr ){
-        if( !curr->isSolved() ){
-            unsolved.push_back( *curr );
+        if( !curr->isSolved() && unsolvedCount++ == index ){
+            return *curr;
         }
     }
-    return unsolved.at( index );
+    throw out_of_range( "SolutionInfoSet::getUnsolved" );
 }
  
 //! Get the unsolved set.
@@ -618,23 +659,25 @@ void SolutionInfoSet::printMarketInfo( const string& aLocation,
 *
 * This function determines the n worst markets, where n is defined by the configuration file, 
 * and creates a SupplyDemandCurve for each. It then instructs the SupplyDemandCurve to calculate the 
-* supply and demand at a series of prices, and to print the resulting curve.
+* supply and demand at a series of prices, and prints all of the curves as a single CSV table.
 *
 * \author Josh Lurz
 * \param aWorld The world to use to calculate new points.
 * \param aMarketplace The marketplace to use to calculate new points.
 * \param aPeriod Period for which to print supply-demand curves.
-* \param aLogger Logger stream to print the curves to.
+* \param aOut Stream to print the curves to.
 */
 void SolutionInfoSet::findAndPrintSD( World* aWorld, Marketplace* aMarketplace, const int aPeriod, ostream& aOut) {
     const Configuration* conf = Configuration::getInstance();
-    const int numMarketsToFindSD = conf->getInt( "numMarketsToFindSD", 5 );
+    const int numMarketsToFindSD = min( conf->getInt( "numMarketsToFindSD", 5 ),
+                                        static_cast<int>( solvable.size() ) );
     const int numPointsForSD = conf->getInt( "numPointsForSD", 5 );
    
     // Sort the vector so the worst markets are first.
     sort( solvable.begin(), solvable.end(), SolutionInfo::GreaterRelativeED() );
 
     // Now determine supply and demand curves for each.
+    bool printHeader = true;
     for ( int i = 0; i < numMarketsToFindSD; ++i ) {
         // If its solved, skip it.
         if( solvable[ i ].isSolved() ){
@@ -642,8 +685,47 @@ void SolutionInfoSet::findAndPrintSD( World* aWorld, Marketplace* aMarketplace,
         }
         SupplyDemandCurve sdCurve( i, solvable[ i ].getName() );
         sdCurve.calculatePoints( numPointsForSD, *this, aWorld, aMarketplace, aPeriod );
-        sdCurve.print( aOut );
+        sdCurve.printCSV( aOut, aPeriod, printHeader );
+        printHeader = false;
+    }
+}
+
+/*! \brief Write supply-demand curves for unsolved markets to a file for the period.
+*
+* Does nothing unless the supplyDemandOutputFileName has been flagged to be written.  The
+* curves for each period are written to a separate CSV file named by inserting the model
+* year before the extension of the configured file name.
+*
+* \param aWorld The world to use to calculate new points.
+* \param aMarketplace The marketplace to use to calculate new points.
+* \param aPeriod Period for which to write supply-demand curves.
+*/
+void SolutionInfoSet::writeSDCurves( World* aWorld, Marketplace* aMarketplace, const int aPeriod ) {
+    const Configuration* conf = Configuration::getInstance();
+    if( !conf->shouldWriteFile( "supplyDemandOutputFileName" ) ) {
+        return;
     }
+
+    string fileName = conf->getFile( "supplyDemandOutputFileName", "supply_demand_curves.csv" );
+    if( conf->shouldAppendScnToFile( "supplyDemandOutputFileName" ) ) {
+        fileName = util::appendScenarioToFileName( fileName );
+    }
+    const string year = util::toString( scenario->getModeltime()->getper_to_yr( aPeriod ) );
+    const size_t extension = fileName.rfind( '.' );
+    if( extension == string::npos || fileName.find( '/', extension ) != string::npos ) {
+        fileName += "_" + year;
+    }
+    else {
+        fileName.insert( extension, "_" + year );
+    }
+
+    ILogger& mainLog = ILogger::getLogger( "main_log" );
+    mainLog.setLevel( ILogger::NOTICE );
+    mainLog << "Writing supply and demand curves for markets that did not solve in period "
+            << aPeriod << " to " << fileName << "." << endl;
+
+    AutoOutputFile sdFile( fileName );
+    findAndPrintSD( aWorld, aMarketplace, aPeriod, *sdFile );
 }
 
 //! Print the derivatives.
@@ -697,3 +779,37 @@ const std::vector<int> &SolutionInfoSet::getMarketIDs(std::vector<int> &aMktids,
     return aMktids;
 }
 
+/*!
+ * \brief Copy the price, supply, demand and bracket information into contiguous
+ *        arrays.
+ * \details The markets are ordered the same as getMarketIDs: all solvable
+ *          markets followed by the unsolvable markets if requested.
+ * \param aState The arrays to fill which are resized only if necessary.
+ * \param aSolvableOnly If only the solvable markets should be included.
+ */
+void SolutionInfoSet::getMarketState( MarketState& aState, const bool aSolvableOnly ) const {
+    const size_t numMarkets = aSolvableOnly ? solvable.size() : solvable.size() + unsolvable.size();
+    if( aState.mPrice.size() != numMarkets ) {
+        aState.mPrice.resize( numMarkets );
+        aState.mSupply.resize( numMarkets );
+        aState.mDemand.resize( numMarkets );
+        aState.mLeftBracket.resize( numMarkets );
+        aState.mRightBracket.resize( numMarkets );
+        aState.mEDLeft.resize( numMarkets );
+        aState.mEDRight.resize( numMarkets );
+        aState.mIsBracketed.resize( numMarkets );
+    }
+
+    for( size_t i = 0; i < numMarkets; ++i ) {
+        const SolutionInfo& currInfo = i < solvable.size() ? solvable[ i ] : unsolvable[ i - solvable.size() ];
+        aState.mPrice[ i ] = currInfo.getPrice();
+        aState.mSupply[ i ] = currInfo.getSupply();
+        aState.mDemand[ i ] = currInfo.getDemand();
+        aState.mLeftBracket[ i ] = currInfo.getLeftBracket();
+        aState.mRightBracket[ i ] = currInfo.getRightBracket();
+        aState.mEDLeft[ i ] = currInfo.getEDLeft();
+        aState.mEDRight[ i ] = currInfo.getEDRight();
+        aState.mIsBracketed[ i ] = currInfo.isBracketed();
+    }
+}
+
@@ -49,6 +49,7 @@
 #include "technologies/include/technology.h"
 #include "util/base/include/value.h"
 #include "sectors/include/ibackup_calculator.h"
+#include "marketplace/include/cached_market.h"
 
 class IInfo;
 /*
@@ -177,6 +178,18 @@ protected:
     
     //! Info object used to pass parameter information into backup calculators.
     std::unique_ptr<IInfo> mIntermittTechInfo;
+
+    //! The full name of the trial market which is saved to avoid rebuilding it
+    //! during every model evaluation.
+    std::string mTrialSupplyMarketName;
+
+    //! The trial market located during initCalc so that it can be accessed
+    //! during calc without name lookups.
+    CachedMarket mTrialMarket;
+
+    //! The electricity sector market located during initCalc so that it can be
+    //! accessed during calc without name lookups.
+    CachedMarket mElectricMarket;
     
     void copy( const IntermittentTechnology& aOther );
 
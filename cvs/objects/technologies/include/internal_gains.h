@@ -51,6 +51,7 @@ class Tabs;
 #include "technologies/include/ioutput.h"
 #include "util/base/include/value.h"
 #include "util/base/include/time_vector.h"
+#include "marketplace/include/cached_market.h"
 
 /*! 
  * \ingroup Objects
@@ -182,6 +183,14 @@ protected:
         //! primary output multiplied by the ratio is equal to internal gains.
         DEFINE_VARIABLE( SIMPLE, "output-ratio", mOutputRatio, Value )
     )
+
+    //! The full name of the trial market which is saved to avoid rebuilding it
+    //! during every model evaluation.
+    std::string mTrialSupplyMarketName;
+
+    //! The trial market located during initCalc so that it can be accessed
+    //! during calc without name lookups.
+    CachedMarket mTrialMarket;
     
     void copy( const InternalGains& aOther );
 };
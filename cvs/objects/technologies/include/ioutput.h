@@ -57,6 +57,7 @@ class ILandAllocator;
 #include "util/base/include/ivisitable.h"
 #include "util/base/include/aparsable.h"
 #include "util/base/include/data_definition_util.h"
+#include "util/base/include/object_arena.h"
 
 // Need to forward declare the subclasses as well.
 class PrimaryOutput;
@@ -82,7 +83,7 @@ class OutputAccounting;
 *          and quantity calculations.
 * \author Josh Lurz
 */
-class IOutput : public INamed, public AParsable, private boost::noncopyable {
+class IOutput : public INamed, public AParsable, public ArenaAllocated, private boost::noncopyable {
 public:
     /*! 
      * \brief Constructor.
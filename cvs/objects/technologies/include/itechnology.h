@@ -52,6 +52,7 @@
 #include "util/base/include/iyeared.h"
 #include "util/base/include/value.h"
 #include "util/base/include/data_definition_util.h"
+#include "util/base/include/object_arena.h"
 
 // Forward declaration
 class AGHG;
@@ -109,7 +110,7 @@ struct PreviousPeriodInfo {
 *
 * \author Pralit Patel
 */
-class ITechnology: public IYeared, private boost::noncopyable
+class ITechnology: public IYeared, public ArenaAllocated, private boost::noncopyable
 {
 public:
     virtual ITechnology* clone() const = 0;
@@ -150,6 +151,12 @@ public:
     virtual double calcShare( const std::string& aRegionName,
                               const IDiscreteChoice* aChoiceFn,
                               int aPeriod ) const = 0;
+
+    virtual bool getDiscreteChoiceTerms( const std::string& aRegionName,
+                                         const int aPeriod,
+                                         double& aShareWeight,
+                                         double& aCost,
+                                         double& aLogShareAdjust ) const = 0;
     
     virtual void calcCost( const std::string& aRegionName,
                            const std::string& aSectorName,
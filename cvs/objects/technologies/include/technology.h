@@ -193,6 +193,12 @@ public:
     virtual double calcShare( const std::string& aRegionName,
                               const IDiscreteChoice* aChoiceFn,
                               int aPeriod ) const;
+
+    virtual bool getDiscreteChoiceTerms( const std::string& aRegionName,
+                                         const int aPeriod,
+                                         double& aShareWeight,
+                                         double& aCost,
+                                         double& aLogShareAdjust ) const;
     
     virtual void calcCost( const std::string& aRegionName,
                            const std::string& aSectorName,
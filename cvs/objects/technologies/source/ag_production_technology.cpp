@@ -360,6 +360,25 @@ double AgProductionTechnology::calcShare( const std::string& aRegionName,
     return 0.0;
 }
 
+/*!
+ * \brief Ag production technologies do not share with the discrete choice
+ *        function.
+ * \param aRegionName Region name.
+ * \param aPeriod Model period.
+ * \param aShareWeight Unused.
+ * \param aCost Unused.
+ * \param aLogShareAdjust Unused.
+ * \return False, calcShare should be used instead.
+ */
+bool AgProductionTechnology::getDiscreteChoiceTerms( const std::string& aRegionName,
+                                                     const int aPeriod,
+                                                     double& aShareWeight,
+                                                     double& aCost,
+                                                     double& aLogShareAdjust ) const
+{
+    return false;
+}
+
 
 /* agTechnologies are not shared on cost, so this calCost method is overwritten
    by a calculation of technology profit which is passed to the land allocator
@@ -113,6 +113,15 @@ double EmptyTechnology::calcShare( const std::string& aRegionName,
     return -numeric_limits<double>::infinity();
 }
 
+bool EmptyTechnology::getDiscreteChoiceTerms( const std::string& aRegionName,
+                                              const int aPeriod,
+                                              double& aShareWeight,
+                                              double& aCost,
+                                              double& aLogShareAdjust ) const
+{
+    return false;
+}
+
 double EmptyTechnology::getFixedOutput( const string& aRegionName,
                                   const string& aSectorName,
                                   const bool aHasRequiredInput,
@@ -285,13 +285,15 @@ void IntermittentTechnology::initCalc( const string& aRegionName,
     // Note: initCalc is called for all past, current and future technologies.
     Technology::initCalc( aRegionName, aSectorName, aSubsectorInfo,
         aDemographics, aPrevPeriodInfo, aPeriod );
+    mTrialSupplyMarketName = SectorUtils::getTrialMarketName( mTrialMarketName );
+    mTrialMarket = SectorUtils::locateTrialMarket( aRegionName, mTrialMarketName );
+    mElectricMarket = scenario->getMarketplace()->locateMarket( mElectricSectorName, mElectricSectorMarket );
     if ( mBackupCalculator ) {
         mBackupCalculator->initCalc( mIntermittTechInfo.get() );
 
         // The renewable trial market is a share calculation so we can give the
         // solver some additional hints that the range should be between 0 and 1.
-        SectorUtils::setSupplyBehaviorBounds( SectorUtils::getTrialMarketName( mTrialMarketName ),
-                                              aRegionName, 0, 1, aPeriod );
+        SectorUtils::setSupplyBehaviorBounds( mTrialSupplyMarketName, aRegionName, 0, 1, aPeriod );
     }
     initializeInputLocations( aRegionName, aSectorName, aPeriod );
 }
@@ -324,7 +326,7 @@ void IntermittentTechnology::production( const string& aRegionName,
     
     // For the trial intermittent technology market, set the trial supply amount to
     // the ratio of intermittent-technology output to the electricity output.
-    double dependentSectorOutput = scenario->getMarketplace()->getDemand( mElectricSectorName, mElectricSectorMarket, aPeriod );
+    double dependentSectorOutput = mElectricMarket.getDemand( mElectricSectorName, mElectricSectorMarket, aPeriod );
 
     if ( dependentSectorOutput > 0 ){
         mIntermitOutTechRatio = std::min( getOutput( aPeriod ) / dependentSectorOutput, 1.0 );
@@ -335,7 +337,7 @@ void IntermittentTechnology::production( const string& aRegionName,
 
     // Multiple vintaged intermittent technology ratios are additive. This gives one 
     // share for backup calculation and proper behavior for vintaging intermittent technologies.
-    SectorUtils::addToTrialDemand( aRegionName, mTrialMarketName, mIntermitOutTechRatio, aPeriod );
+    SectorUtils::addToTrialDemand( mTrialMarket, aRegionName, mTrialSupplyMarketName, mIntermitOutTechRatio, aPeriod );
 }
 
 /*! \brief Set tech shares based on backup energy needs for an intermittent
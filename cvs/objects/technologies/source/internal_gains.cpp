@@ -138,7 +138,9 @@ void InternalGains::initCalc( const string& aRegionName,
                               const string& aSectorName,
                               const int aPeriod )
 {
-    SectorUtils::setSupplyBehaviorBounds(SectorUtils::getTrialMarketName( mTrialMarketName ), aRegionName, 0.0, util::getLargeNumber(), aPeriod);
+    mTrialSupplyMarketName = SectorUtils::getTrialMarketName( mTrialMarketName );
+    mTrialMarket = SectorUtils::locateTrialMarket( aRegionName, mTrialMarketName );
+    SectorUtils::setSupplyBehaviorBounds( mTrialSupplyMarketName, aRegionName, 0.0, util::getLargeNumber(), aPeriod );
 }
 
 void InternalGains::postCalc( const string& aRegionName,
@@ -177,7 +179,7 @@ void InternalGains::setPhysicalOutput( const double aPrimaryOutput,
     mPhysicalOutputs[ aPeriod ] = internalGains;
 
     // Add to the actual internal gains in the trials market
-    SectorUtils::addToTrialDemand( aRegionName, mTrialMarketName, mPhysicalOutputs[ aPeriod ], aPeriod );
+    SectorUtils::addToTrialDemand( mTrialMarket, aRegionName, mTrialSupplyMarketName, mPhysicalOutputs[ aPeriod ], aPeriod );
 }
 
 double InternalGains::getPhysicalOutput( const int aPeriod ) const
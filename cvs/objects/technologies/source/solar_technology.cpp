@@ -293,7 +293,7 @@ double SolarTechnology::getSolarPenetration( const int aPeriod ) const
    // Compute the CSP penetration level
    double SolarPenetration = 0;
    if ( aPeriod > 0 && mMaxSectorLoadServed > 0 ){
-      SolarPenetration = SectorUtils::getTrialSupply( mRegionName, mTrialMarketName, aPeriod )
+      SolarPenetration = SectorUtils::getTrialSupply( mTrialMarket, mRegionName, mTrialSupplyMarketName, aPeriod )
                          / mMaxSectorLoadServed;
    }
 
@@ -677,32 +677,67 @@ double Technology::calcShare( const std::string& aRegionName,
                               const IDiscreteChoice* aChoiceFn,
                               int aPeriod ) const
 {
-    const double mininf = -numeric_limits<double>::infinity();
+    double shareWeight;
+    double cost;
+    double fuelPrefTerm;
+    getDiscreteChoiceTerms( aRegionName, aPeriod, shareWeight, cost, fuelPrefTerm );
+    double logshare = aChoiceFn->calcUnnormalizedShare( shareWeight, cost, aPeriod ) + fuelPrefTerm;
+
+    assert( util::isValidNumber( logshare ) || logshare == -numeric_limits<double>::infinity() );
+    return logshare;
+}
+
+/*!
+ * \brief Get the terms used to calculate the share of this technology with the
+ *        discrete choice function of the subsector.
+ * \details Technologies which should not have a share, because they are not
+ *          operating, are vintages, or have fixed output, are given a share
+ *          weight and cost of zero which results in a zero share.  This allows
+ *          the subsector to calculate the shares of all of its technologies at
+ *          once with IDiscreteChoice::calcUnnormalizedShares.
+ * \param aRegionName Region name.
+ * \param aPeriod Model period.
+ * \param aShareWeight The share weight to use.
+ * \param aCost The cost to share on.
+ * \param aLogShareAdjust The fuel preference elasticity term to add to the log
+ *                        of the share.
+ * \return Whether the share is calculated from these terms, always true for
+ *         Technology.
+ * \sa Subsector::calcTechShares
+ */
+bool Technology::getDiscreteChoiceTerms( const std::string& aRegionName,
+                                         const int aPeriod,
+                                         double& aShareWeight,
+                                         double& aCost,
+                                         double& aLogShareAdjust ) const
+{
+    aShareWeight = 0.0;
+    aCost = 0.0;
+    aLogShareAdjust = 0.0;
 
     // A Technology which is not operating does not have a share.
     if( !mProductionState[ aPeriod ] || !mProductionState[ aPeriod ]->isOperating() ){
-        return mininf;
+        return true;
     } 
     // Vintages and fixed output technologies should never have a share.
     if( !mProductionState[ aPeriod ]->isNewInvestment() ||
         mFixedOutput != IProductionState::fixedOutputDefault() )
     {
-        return mininf;
+        return true;
     }
 
     /* Calculation for regular cases */
-    double cost = getCost( aPeriod ); 
-    double logshare = aChoiceFn->calcUnnormalizedShare( mShareWeight, cost, aPeriod );
+    aShareWeight = mShareWeight;
+    aCost = getCost( aPeriod );
 
     double fuelPrefElasticity = calcFuelPrefElasticity( aPeriod );
     if( fuelPrefElasticity != 0 ) {
         double scaledGdpPerCapita = SectorUtils::getGDPPerCapScaled( aRegionName, aPeriod );
 
         assert( scaledGdpPerCapita > 0.0) ;
-        logshare += fuelPrefElasticity * log( scaledGdpPerCapita );
+        aLogShareAdjust = fuelPrefElasticity * log( scaledGdpPerCapita );
     }
-    assert( util::isValidNumber( logshare ) || logshare == mininf );
-    return logshare;
+    return true;
 }
 
 /*! \brief Return true if technology is fixed for no output or input
@@ -45,12 +45,64 @@
 * \author Josh Lurz
 */
 
+#include "util/base/include/definitions.h"
 #include <boost/iostreams/filtering_stream.hpp>
 #include <boost/iostreams/device/file.hpp>
 #include <boost/iostreams/device/null.hpp>
 #include <string>
 #include "util/base/include/configuration.h"
 #include "util/base/include/util.h"
+#include "util/logger/include/ilogger.h"
+
+#if USE_ZLIB
+#include <zlib.h>
+#include <boost/shared_ptr.hpp>
+
+/*!
+* \ingroup util
+* \brief A boost iostreams sink which writes a gzip compressed file using zlib.
+*/
+class GzipFileSink {
+public:
+    typedef char char_type;
+    typedef boost::iostreams::sink_tag category;
+
+    /*! \brief Open the compressed file.
+    * \param aFileName Name of the file to open.
+    */
+    explicit GzipFileSink( const std::string& aFileName )
+        :mFile( gzopen( aFileName.c_str(), "wb" ), &GzipFileSink::closeFile )
+    {
+    }
+
+    /*! \brief Check if the file was opened successfully.
+    * \return True if the file is open.
+    */
+    bool is_open() const {
+        return mFile.get() != 0;
+    }
+
+    /*! \brief Compress and write the given characters.
+    * \param aData The characters to write.
+    * \param aSize The number of characters to write.
+    * \return The number of characters written.
+    */
+    std::streamsize write( const char* aData, std::streamsize aSize ) {
+        return gzwrite( mFile.get(), aData, static_cast<unsigned int>( aSize ) );
+    }
+private:
+    //! The zlib file handle which is shared between copies of this sink and
+    //! closed when the last of them is gone.
+    boost::shared_ptr<gzFile_s> mFile;
+
+    //! Close the zlib file handle if it was opened.
+    static void closeFile( gzFile aFile ) {
+        if( aFile ) {
+            gzclose( aFile );
+        }
+    }
+};
+#endif
 
 /*!
 * \ingroup util
@@ -69,10 +121,14 @@ public:
     * \param aDefaultName Filename to use if the variable is not found.
     * \param aShouldWriteOverride If we should not write the file even if the user
     *                             specified they want it, i.e. when target finding.
+    * \param aCompress If the file should be gzip compressed, in which case .gz is
+    *                  added to the file name.  This is only possible when GCAM
+    *                  was built with USE_ZLIB.
     */
     AutoOutputFile( const std::string& aConfVariableName,
                     const std::string& aDefaultName,
-                    const bool aShouldWriteOverride = true )
+                    const bool aShouldWriteOverride = true,
+                    const bool aCompress = false )
         :mShouldWrite( aShouldWriteOverride && Configuration::getInstance()->shouldWriteFile( aConfVariableName ) )
     {
         const Configuration* conf = Configuration::getInstance();
@@ -81,6 +137,20 @@ public:
             if( conf->shouldAppendScnToFile( aConfVariableName ) ) {
                 fileName = util::appendScenarioToFileName( fileName );
             }
+            if( aCompress ) {
+#if USE_ZLIB
+                fileName += ".gz";
+                GzipFileSink gzipBuffer( fileName );
+                util::checkIsOpen( gzipBuffer, fileName );
+                mWrappedFile.push( gzipBuffer );
+                return;
+#else
+                ILogger& mainLog = ILogger::getLogger( "main_log" );
+                mainLog.setLevel( ILogger::WARNING );
+                mainLog << "Compressed output requires building with USE_ZLIB, writing "
+                        << fileName << " uncompressed." << std::endl;
+#endif
+            }
             boost::iostreams::file_sink fileBuffer( fileName );
             mWrappedFile.push( fileBuffer );
             util::checkIsOpen( fileBuffer, fileName );
@@ -0,0 +1,86 @@
+#ifndef _DEBUG_FILTER_H_
+#define _DEBUG_FILTER_H_
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+
+
+/*! 
+* \file debug_filter.h
+* \ingroup Objects
+* \brief The DebugFilter class header file.
+*/
+
+#include <string>
+#include <vector>
+#include <set>
+
+/*!
+* \ingroup Objects
+* \brief Determines which regions, sectors, and periods are included in the
+*        debugging output.
+* \details The filters are read from the configuration the first time they are
+*          needed:
+*          - debug-region A comma separated list of regions for which debug XML
+*            and graphs are written, defaulting to USA.
+*          - debug-sectors A comma separated list of the sectors, resources, and
+*            final demands to include in the debug XML, all if not set.
+*          - debug-years A comma separated list of the model years to write
+*            debugging output for, all if not set.
+*          Restricting the output to a single region, a handful of sectors, and
+*          the years of interest keeps the debugging files for a full production
+*          run small enough to be practical.
+*/
+class DebugFilter {
+public:
+    static const std::vector<std::string>& getDebugRegions();
+
+    static bool isDebugRegion( const std::string& aRegionName );
+
+    static bool isDebugSector( const std::string& aSectorName );
+
+    static bool isDebugPeriod( const int aPeriod );
+
+    static std::string getRegionFileName( const std::string& aFileName,
+                                          const std::string& aRegionName );
+
+private:
+    static std::vector<std::string> parseList( const std::string& aConfVariableName,
+                                               const std::string& aDefaultValue );
+};
+
+#endif // _DEBUG_FILTER_H_
+
@@ -67,6 +67,11 @@
 #define USE_HECTOR 1
 #endif
 
+//! A flag which turns on or off the ability to write compressed output using zlib.
+#ifndef USE_ZLIB
+#define USE_ZLIB 0
+#endif
+
 //! A flag which turns on or off parallel calculation using intel TBB
 #ifndef GCAM_PARALLEL_ENABLED
 #define GCAM_PARALLEL_ENABLED 1
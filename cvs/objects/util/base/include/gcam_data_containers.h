@@ -207,6 +207,7 @@
 #include "solution/solvers/include/bisect_all.h"
 #include "solution/solvers/include/logbroyden.hpp"
 #include "solution/solvers/include/preconditioner.hpp"
+#include "solution/solvers/include/newton_krylov.hpp"
 #include "util/base/include/data_definition_util.h"
 #include "util/base/include/fixed_interpolation_function.h"
 #include "util/base/include/iinterpolation_function.h"
@@ -46,9 +46,11 @@
 #include <cassert>
 #include <forward_list>
 #include <string>
+#include <vector>
 #include "util/base/include/definitions.h"
 
 class Value;
+class ITechnology;
 
 #if GCAM_PARALLEL_ENABLED
 #include <tbb/task_arena.h>
@@ -58,8 +60,11 @@ class Value;
  * \brief A utility for collecting all self declared GCAM state variables so that
  *        they can be managed and reset as appropriate.
  * \details All Data definitions marked as STATE will be searched for using GCAMFusion
- *          and only those that could possibly be changed during World.calc of the
- *          period for which this class was created will be managed as active state.
+ *          once, after the scenario has been initialized, and kept in a registry
+ *          grouped by the Technology, Market, or NationalAccount that contains them.
+ *          Each period only those groups that could possibly be changed during
+ *          World.calc of the period for which this class was created are checked
+ *          and their Values managed as active state.
  *          The Value class is used in conjunction with this class such that the
  *          actual state data is stored in tightly packed arrays that can quickly
  *          get reset.  In addition the Value can be set at the same time from multiple
@@ -71,10 +76,15 @@ class Value;
  */
 class ManageStateVariables {
     friend class SolutionDebugger;
+    friend class GCAMBench;
 public:
     ManageStateVariables( const int aPeriod );
     ~ManageStateVariables();
     
+    static void collectStateRegistry();
+    
+    static void clearStateRegistry();
+    
     void copyState();
     
     void setPartialDeriv( const bool aIsPartialDeriv );
@@ -122,8 +132,52 @@ private:
     //! - When we are done with this period copy the "base" state back into each Value.
     std::forward_list<Value*> mStateValues;
     
+    //! The kinds of Data flagged as STATE which the registry may hold.
+    enum StateDataType {
+        SINGLE_VALUE,
+        PERIOD_VECTOR,
+        VINTAGE_VECTOR,
+        YEAR_VECTOR
+    };
+    
+    //! A single Data flagged as STATE found while building the registry.
+    struct StateEntry {
+        //! Which kind of Data mData points to.
+        StateDataType mType;
+        
+        //! The Value or the vector of Values, as given by mType.
+        void* mData;
+    };
+    
+    /*!
+     * \brief A group of STATE Data which all become active or inactive together.
+     * \details Groups are kept in the order GCAMFusion found the Data so that the
+     *          order of the state, and therefore restart files, is unchanged.
+     */
+    struct StateGroup {
+        //! The Technology which contains this Data which is only active in the
+        //! periods it is operating or null if it is not in a Technology.
+        ITechnology* mTechnology;
+        
+        //! The year of the Market or NationalAccount which contains this Data
+        //! or -1 if the Data is not specific to a year.
+        int mYear;
+        
+        //! The STATE Data in this group.
+        std::vector<StateEntry> mEntries;
+    };
+    
+    //! The registry of all STATE Data in the scenario, built once after the
+    //! scenario is initialized and reused by each period.  This will be null
+    //! when it needs to be (re)built.
+    static std::vector<StateGroup>* sStateRegistry;
+    
     void collectState();
     
+    bool isGroupActive( const StateGroup& aGroup ) const;
+    
+    void addActiveValues( const StateEntry& aEntry );
+    
     void resetState();
     
     std::string getRestartFileName() const;
@@ -137,19 +191,25 @@ private:
      *        for data flagged STATE.
      * \details In addition to handling the processData call back we also are
      *          interested in the push/pop filter steps, particularly for Technology
-     *          and MarketContainer to avoid collecting Data in a Technology or
-     *          Market that is going to be inactive during mPeriodToCollect.
+     *          and MarketContainer so that Data in a Technology or Market is put in
+     *          a group which can be skipped in periods where it will be inactive.
      */
     struct DoCollect {
-        //! A reference to the containing class where each collected state data
-        //! will be added.
-        ManageStateVariables* mParentClass;
+        //! The registry in which each collected state data will be added.
+        std::vector<StateGroup>* mRegistry;
+        
+        //! The Technology we are currently in or null if none.
+        ITechnology* mCurrTechnology = 0;
+        
+        //! The year of the Market or NationalAccount we are currently in or -1
+        //! if none.
+        int mCurrYear = -1;
+        
+        //! A flag indicating we have moved in to or out of a Technology, Market,
+        //! or NationalAccount and so the next Data found starts a new group.
+        bool mStartNewGroup = true;
         
-        //! A state variable while processing GCAMFusion which when set indicates
-        //! we are in a Technology or MarketContainer that is inactive in the
-        //! current period.  This flag gets reset when the corresponding popFilterStep
-        //! is found.
-        bool mIgnoreCurrValue = false;
+        void addEntry( const StateDataType aType, void* aData );
         
         // Templated callbacks for GCAMFusion
         template<typename DataType>
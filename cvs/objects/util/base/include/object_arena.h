@@ -0,0 +1,142 @@
+#ifndef _OBJECT_ARENA_H_
+#define _OBJECT_ARENA_H_
+#if defined(_MSC_VER)
+#pragma once
+#endif
+
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+
+
+/*! 
+* \file object_arena.h
+* \ingroup Objects
+* \brief The ObjectArena and ArenaAllocated class header file.
+*/
+
+#include <vector>
+#include <cstddef>
+#include <boost/core/noncopyable.hpp>
+
+/*!
+* \ingroup Objects
+* \brief A simple arena from which many small, long lived model objects can be
+*        allocated contiguously.
+* \details The model tree consists of a very large number of individually
+*          allocated objects such as technologies, inputs, outputs, and GHGs.
+*          When allocated from the general heap the objects of a single region
+*          end up scattered across memory which hurts cache and TLB behavior
+*          when calculating that region.  An ObjectArena hands out memory by
+*          simply bumping a pointer through large blocks so that objects
+*          created one after another, such as while parsing a region or
+*          interpolating its technology vintages, are laid out next to each
+*          other.
+*
+*          Memory is never returned to the arena on delete.  Instead all of the
+*          blocks are freed at once when the arena itself is destroyed, which
+*          must therefore outlive every object allocated from it.  Note that
+*          the destructors of the objects are still run as usual.
+*
+*          Classes opt in to arena allocation by deriving from ArenaAllocated.
+*          Such objects are only allocated from an arena while an
+*          ObjectArena::Scope for it is active on the current thread and from
+*          the general heap otherwise.
+*/
+class ObjectArena : private boost::noncopyable {
+public:
+    ObjectArena( const size_t aBlockSize = DEFAULT_BLOCK_SIZE );
+    ~ObjectArena();
+
+    void* allocate( const size_t aSize );
+
+    size_t getBytesAllocated() const;
+
+    static void* allocateObject( const size_t aSize );
+
+    static void deallocateObject( void* aPtr );
+
+    /*!
+     * \brief Sets the arena which ArenaAllocated objects created on the current
+     *        thread will be allocated from for the lifetime of this object.
+     * \details Scopes may be nested, a scope created with a null arena leaves the
+     *          current arena unchanged.
+     */
+    class Scope : private boost::noncopyable {
+    public:
+        explicit Scope( ObjectArena* aArena );
+        ~Scope();
+    private:
+        //! The arena that was current when this scope was created.
+        ObjectArena* mPrevArena;
+    };
+
+private:
+    //! The default size of each block of memory.
+    static const size_t DEFAULT_BLOCK_SIZE = 1 << 20;
+
+    //! The size of each block of memory.
+    const size_t mBlockSize;
+
+    //! All of the blocks of memory allocated so far.
+    std::vector<char*> mBlocks;
+
+    //! The next free position in the current block.
+    char* mCurrPos;
+
+    //! The end of the current block.
+    char* mCurrEnd;
+
+    //! The total bytes handed out by this arena.
+    size_t mBytesAllocated;
+
+    //! The arena to allocate from on the current thread, if any.
+    static thread_local ObjectArena* sCurrentArena;
+};
+
+/*!
+* \ingroup Objects
+* \brief A base class which routes the allocation of subclasses through the
+*        ObjectArena that is current on the allocating thread, if any.
+*/
+class ArenaAllocated {
+public:
+    static void* operator new( size_t aSize ) {
+        return ObjectArena::allocateObject( aSize );
+    }
+
+    static void operator delete( void* aPtr ) {
+        ObjectArena::deallocateObject( aPtr );
+    }
+};
+
+#endif // _OBJECT_ARENA_H_
@@ -98,6 +98,7 @@ struct XMLParseHelper {
     static bool parseXML( const std::string& aXMLFile, IScenarioRunner* & aRootElement );
     static bool parseXML( const std::string& aXMLFile, LoggerFactoryWrapper* aRootElement );
     static bool parseXML( const std::string& aXMLFile, Configuration* aRootElement );
+    static bool parseXMLString( const std::string& aXMLContent, Scenario* aRootElement );
     
     /*!
      * \brief Extract the node name of the given node as a std::string.
@@ -0,0 +1,143 @@
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+
+
+/*! 
+* \file debug_filter.cpp
+* \ingroup Objects
+* \brief The DebugFilter class source file.
+*/
+
+#include "util/base/include/definitions.h"
+#include <algorithm>
+#include <boost/algorithm/string.hpp>
+
+#include "util/base/include/debug_filter.h"
+#include "util/base/include/configuration.h"
+#include "util/base/include/model_time.h"
+#include "util/base/include/util.h"
+#include "containers/include/scenario.h"
+
+using namespace std;
+
+extern Scenario* scenario;
+
+/*!
+ * \brief Get the regions for which debugging output should be written.
+ * \return The regions in the order they were listed in the configuration.
+ */
+const vector<string>& DebugFilter::getDebugRegions() {
+    const static vector<string> debugRegions = parseList( "debug-region", "USA" );
+    return debugRegions;
+}
+
+/*!
+ * \brief Check if debugging output should be written for the given region.
+ * \param aRegionName The name of the region.
+ * \return True if the region is one of the debug regions.
+ */
+bool DebugFilter::isDebugRegion( const string& aRegionName ) {
+    const vector<string>& debugRegions = getDebugRegions();
+    return find( debugRegions.begin(), debugRegions.end(), aRegionName ) != debugRegions.end();
+}
+
+/*!
+ * \brief Check if the debug XML should include the given sector, resource, or
+ *        final demand.
+ * \param aSectorName The name of the sector.
+ * \return True if no sector filter was set or the sector is in it.
+ */
+bool DebugFilter::isDebugSector( const string& aSectorName ) {
+    const static vector<string> sectorList = parseList( "debug-sectors", "" );
+    const static set<string> debugSectors( sectorList.begin(), sectorList.end() );
+    return debugSectors.empty() || debugSectors.find( aSectorName ) != debugSectors.end();
+}
+
+/*!
+ * \brief Check if debugging output should be written for the given period.
+ * \param aPeriod The model period.
+ * \return True if no year filter was set or the year of the period is in it.
+ */
+bool DebugFilter::isDebugPeriod( const int aPeriod ) {
+    const static vector<string> yearList = parseList( "debug-years", "" );
+    if( yearList.empty() ) {
+        return true;
+    }
+    const string year = util::toString( scenario->getModeltime()->getper_to_yr( aPeriod ) );
+    return find( yearList.begin(), yearList.end(), year ) != yearList.end();
+}
+
+/*!
+ * \brief Get the name of the file to write the debugging output of a single region to.
+ * \details When there is only a single debug region the file name is unchanged,
+ *          otherwise the region name is inserted before the extension so that
+ *          each region is written to its own file.
+ * \param aFileName The configured file name.
+ * \param aRegionName The name of the region.
+ * \return The file name to use for the region.
+ */
+string DebugFilter::getRegionFileName( const string& aFileName, const string& aRegionName ) {
+    if( getDebugRegions().size() <= 1 ) {
+        return aFileName;
+    }
+    const string regionSuffix = "_" + util::replaceSpaces( aRegionName );
+    const size_t extensionPos = aFileName.find_last_of( '.' );
+    const size_t dirPos = aFileName.find_last_of( "/\\" );
+    if( extensionPos == string::npos || ( dirPos != string::npos && extensionPos < dirPos ) ) {
+        return aFileName + regionSuffix;
+    }
+    return aFileName.substr( 0, extensionPos ) + regionSuffix + aFileName.substr( extensionPos );
+}
+
+/*!
+ * \brief Split a comma separated configuration string into its trimmed, non-empty
+ *        elements.
+ * \param aConfVariableName The name of the configuration string.
+ * \param aDefaultValue The value to use if it was not set.
+ * \return The elements of the list.
+ */
+vector<string> DebugFilter::parseList( const string& aConfVariableName,
+                                       const string& aDefaultValue )
+{
+    const string listStr = Configuration::getInstance()->getString( aConfVariableName, aDefaultValue );
+    vector<string> elements;
+    boost::split( elements, listStr, boost::is_any_of( "," ) );
+    vector<string> list;
+    for( auto element : elements ) {
+        boost::trim( element );
+        if( !element.empty() ) {
+            list.push_back( element );
+        }
+    }
+    return list;
+}
@@ -50,8 +50,12 @@
 #include "util/base/include/gcam_data_containers.h"
 
 #if GCAM_PARALLEL_ENABLED
+#include <atomic>
+#include <memory>
 #include <tbb/concurrent_queue.h>
 #include <tbb/global_control.h>
+#include <tbb/task_arena.h>
+#include "marketplace/include/marketplace.h"
 #endif
 
 using namespace std;
@@ -64,6 +68,8 @@ extern Scenario* scenario;
 Value::CentralValueType Value::sCentralValue( (double*)0 );
 double* Value::sBaseCentralValue( 0 );
 
+vector<ManageStateVariables::StateGroup>* ManageStateVariables::sStateRegistry = 0;
+
 #if GCAM_PARALLEL_ENABLED
 #define NUM_STATES tbb::global_control::active_value(tbb::global_control::max_allowed_parallelism)+1
 #else
@@ -90,8 +96,20 @@ struct AssignThreadStateFun {
     //! assigned that state slot.
     tbb::concurrent_queue<int> mThreadStateIndex;
     
+    //! When in deterministic mode whether each index into mStateData has been
+    //! assigned to a thread.  Shared as the thread local storage keeps a copy
+    //! of this functor.
+    std::shared_ptr<std::vector<std::atomic<bool> > > mIsAssigned;
+    
     //! Constructor
     AssignThreadStateFun( double** aArr, const int aMaxStates ):mArr( aArr ), mMaxStates( aMaxStates ) {
+        if( Marketplace::mIsDeterministicCalc ) {
+            mIsAssigned.reset( new std::vector<std::atomic<bool> >( mMaxStates ) );
+            for( int i = 0; i < mMaxStates; ++i ) {
+                ( *mIsAssigned )[ i ] = false;
+            }
+            return;
+        }
         // initialize the state index slots starting from 1 as 0 is always the
         // "base" state.
         for( int i = 1; i < mMaxStates; ++i ) {
@@ -109,7 +127,7 @@ struct AssignThreadStateFun {
      */
     double* operator()() {
         int nextState;
-        bool gotState = mThreadStateIndex.try_pop( nextState );
+        bool gotState = mIsAssigned ? assignByArenaSlot( nextState ) : mThreadStateIndex.try_pop( nextState );
         if( !gotState ) {
             ILogger& mainLog = ILogger::getLogger( "main_log" );
             mainLog.setLevel( ILogger::SEVERE );
@@ -119,6 +137,28 @@ struct AssignThreadStateFun {
         
         return mArr[ nextState ];
     }
+    
+    /*!
+     * \brief Assign the state slot following this thread's slot in the task arena
+     *        so that the same tasks use the same state regardless of the order
+     *        in which threads first arrive.
+     * \details If that slot has already been taken, which could happen if a
+     *          thread changed arena slots, the next free slot is used instead.
+     * \param aState The assigned state slot.
+     * \return Whether a free state slot was found.
+     */
+    bool assignByArenaSlot( int& aState ) {
+        const int arenaSlot = tbb::this_task_arena::current_thread_index();
+        const int numScratch = mMaxStates - 1;
+        const int first = arenaSlot >= 0 ? arenaSlot % numScratch : 0;
+        for( int i = 0; i < numScratch; ++i ) {
+            aState = 1 + ( first + i ) % numScratch;
+            if( !( *mIsAssigned )[ aState ].exchange( true ) ) {
+                return true;
+            }
+        }
+        return false;
+    }
 };
 #endif
 
@@ -162,15 +202,20 @@ ManageStateVariables::~ManageStateVariables() {
 }
 
 /*!
- * \brief Search for all relevant STATE Values and allocate space for them in the
- *        central state data arrays.  The "base" state will get initialized as the
- *        actual value set in the individual Value objects before being collected.
+ * \brief Search for all STATE Data in the scenario and build the registry that
+ *        each period will use to find its active state.
+ * \details This is a full GCAMFusion search of the model and so should only be
+ *          done once the scenario has been completely initialized.  Any existing
+ *          registry will be replaced.
  */
-void ManageStateVariables::collectState() {
+void ManageStateVariables::collectStateRegistry() {
+    clearStateRegistry();
+    sStateRegistry = new vector<StateGroup>();
+    
     // Set up the GCAM Fusion steps as well as the callback struct that will handle
     // the results from the search.
     DoCollect doCollectProc;
-    doCollectProc.mParentClass = this;
+    doCollectProc.mRegistry = sStateRegistry;
     // Note an empty string for the data name indicates match any name.  The first
     // step that does not match any name nor value indicates a "descendant" step
     // allowing for GCAM fusion to search at any depth to find Data of any name
@@ -183,7 +228,48 @@ void ManageStateVariables::collectState() {
     GCAMFusion<DoCollect, true, true, true> gatherState( doCollectProc, collectStateSteps );
     gatherState.startFilter( scenario );
     
-    // DoCollect has now gathered all active state into the mStateValues list to
+    ILogger& mainLog = ILogger::getLogger( "main_log" );
+    mainLog.setLevel( ILogger::DEBUG );
+    mainLog << "Number of state groups registered: " << sStateRegistry->size() << endl;
+    
+    // clean up GCAMFusion related memory
+    for( auto filterStep : collectStateSteps ) {
+        delete filterStep;
+    }
+}
+
+/*!
+ * \brief Discard the registry of STATE Data.
+ * \details This must be called whenever objects containing STATE Data may have
+ *          been created or deleted, such as when a new policy is set, after which
+ *          the registry will be rebuilt when it is next needed.
+ */
+void ManageStateVariables::clearStateRegistry() {
+    delete sStateRegistry;
+    sStateRegistry = 0;
+}
+
+/*!
+ * \brief Find all relevant STATE Values from the registry and allocate space for
+ *        them in the central state data arrays.  The "base" state will get initialized
+ *        as the actual value set in the individual Value objects before being collected.
+ */
+void ManageStateVariables::collectState() {
+    if( !sStateRegistry ) {
+        collectStateRegistry();
+    }
+    
+    // Only the groups which could be changed this period are active, the rest
+    // are skipped without looking at any of their Data.
+    for( const auto& group : *sStateRegistry ) {
+        if( isGroupActive( group ) ) {
+            for( const auto& entry : group.mEntries ) {
+                addActiveValues( entry );
+            }
+        }
+    }
+    
+    // We have now gathered all active state into the mStateValues list to
     // allow faster/easier processing for the remaining tasks at hand.
     ILogger& mainLog = ILogger::getLogger( "main_log" );
     mainLog.setLevel( ILogger::DEBUG );
@@ -229,10 +315,59 @@ void ManageStateVariables::collectState() {
     if( newRestartPeriod != -1 && mPeriodToCollect < newRestartPeriod ) {
         loadRestartFile();
     }
-    
-    // clean up GCAMFusion related memory
-    for( auto filterStep : collectStateSteps ) {
-        delete filterStep;
+}
+
+/*!
+ * \brief Check if the Data in a group of the registry could be changed while
+ *        calculating mPeriodToCollect.
+ * \param aGroup The group of STATE Data to check.
+ * \return True if the group contains active state this period.
+ */
+bool ManageStateVariables::isGroupActive( const StateGroup& aGroup ) const {
+    // Ignore any data set within a Technology that is not operating in the current
+    // model period.
+    if( aGroup.mTechnology && !aGroup.mTechnology->isOperating( mPeriodToCollect ) ) {
+        return false;
+    }
+    // Ignore any data set within a Market or NationalAccount which is not for
+    // the current model year.
+    return aGroup.mYear == -1 || aGroup.mYear == mYearToCollect;
+}
+
+/*!
+ * \brief Add the Values of a STATE Data which are active in mPeriodToCollect to
+ *        mStateValues.
+ * \param aEntry The STATE Data from an active group.
+ */
+void ManageStateVariables::addActiveValues( const StateEntry& aEntry ) {
+    switch( aEntry.mType ) {
+        case SINGLE_VALUE:
+            // Any SINGLE value that is tagged is considered active.
+            mStateValues.push_front( static_cast<Value*>( aEntry.mData ) );
+            ++mNumCollected;
+            break;
+        case PERIOD_VECTOR:
+            // When an ARRAY of values are tagged only the Value in [ mPeriodToCollect] is
+            // considered active.
+            mStateValues.push_front( &( *static_cast<objects::PeriodVector<Value>*>( aEntry.mData ) )[ mPeriodToCollect ] );
+            ++mNumCollected;
+            break;
+        case VINTAGE_VECTOR:
+            // Note, the Technology being operating should take care of out of bounds here
+            mStateValues.push_front( &( *static_cast<objects::TechVintageVector<Value>*>( aEntry.mData ) )[ mPeriodToCollect ] );
+            ++mNumCollected;
+            break;
+        case YEAR_VECTOR: {
+            // When a year vector is tagged we only need to worry about values in the current
+            // timestep (already calculated the years ahead of time in the interest of speed
+            // to be from [mCCStartYear, mYearToCollect])
+            objects::YearVector<Value>& data = *static_cast<objects::YearVector<Value>*>( aEntry.mData );
+            for( int year = std::max( mCCStartYear, data.getStartYear() ); year <= mYearToCollect; ++year ) {
+                mStateValues.push_front( &data[ year ] );
+                ++mNumCollected;
+            }
+            break;
+        }
     }
 }
 
@@ -409,6 +544,27 @@ void Value::doStateCheck() const {
 }
 #endif
 
+/*!
+ * \brief Add a STATE Data to the current group of the registry, starting a new
+ *        group if we have moved in to or out of a container which controls when
+ *        the Data is active.
+ * \param aType The kind of STATE Data.
+ * \param aData The STATE Data.
+ */
+void ManageStateVariables::DoCollect::addEntry( const StateDataType aType, void* aData ) {
+    if( mStartNewGroup ) {
+        StateGroup newGroup;
+        newGroup.mTechnology = mCurrTechnology;
+        newGroup.mYear = mCurrYear;
+        mRegistry->push_back( newGroup );
+        mStartNewGroup = false;
+    }
+    StateEntry entry;
+    entry.mType = aType;
+    entry.mData = aData;
+    mRegistry->back().mEntries.push_back( entry );
+}
+
 template<typename DataType>
 void ManageStateVariables::DoCollect::processData( DataType& aData ) {
 #if DEBUG_STATE
@@ -420,47 +576,22 @@ void ManageStateVariables::DoCollect::processData( DataType& aData ) {
 
 template<>
 void ManageStateVariables::DoCollect::processData<Value>( Value& aData ) {
-    // Any SINGLE value that is tagged is considered active so long as it is not
-    // contained in a retired technology for instance.
-    if( !mIgnoreCurrValue ) {
-        mParentClass->mStateValues.push_front( &aData );
-        ++mParentClass->mNumCollected;
-    }
+    addEntry( SINGLE_VALUE, &aData );
 }
 
 template<>
 void ManageStateVariables::DoCollect::processData<objects::PeriodVector<Value> >( objects::PeriodVector<Value>& aData ) {
-    // When an ARRAY of values are tagged only the Value in [ mPeriodToCollect] is
-    // considered active.
-    if( !mIgnoreCurrValue ) {
-        mParentClass->mStateValues.push_front( &aData[ mParentClass->mPeriodToCollect ] );
-        ++mParentClass->mNumCollected;
-    }
+    addEntry( PERIOD_VECTOR, &aData );
 }
 
 template<>
 void ManageStateVariables::DoCollect::processData<objects::TechVintageVector<Value> >( objects::TechVintageVector<Value>& aData ) {
-    // When an ARRAY of values are tagged only the Value in [ mPeriodToCollect] is
-    // considered active.
-    
-    // Note, mIgnoreCurrValue should take care of out of bounds here
-    if( !mIgnoreCurrValue ) {
-        mParentClass->mStateValues.push_front( &aData[ mParentClass->mPeriodToCollect ] );
-        ++mParentClass->mNumCollected;
-    }
+    addEntry( VINTAGE_VECTOR, &aData );
 }
 
 template<>
 void ManageStateVariables::DoCollect::processData<objects::YearVector<Value> >( objects::YearVector<Value>& aData ) {
-    // When a year vector is tagged we only need to worry about values in the current
-    // timestep (already calculated the years ahead of time in the interest of speed
-    // to be from [mCCStartYear, mYearToCollect])
-    if( !mIgnoreCurrValue ) {
-        for( int year = std::max( mParentClass->mCCStartYear, aData.getStartYear() ); year <= mParentClass->mYearToCollect; ++year ) {
-            mParentClass->mStateValues.push_front( &aData[ year ] );
-            ++mParentClass->mNumCollected;
-        }
-    }
+    addEntry( YEAR_VECTOR, &aData );
 }
 
 template<typename DataType>
@@ -476,44 +607,42 @@ void ManageStateVariables::DoCollect::popFilterStep( const DataType& aData ) {
 
 template<>
 void ManageStateVariables::DoCollect::pushFilterStep<ITechnology*>( ITechnology* const& aData ) {
-    // Ignore any data set within a Technology that is not operating in the current
-    // model period.
-    if( !aData->isOperating( mParentClass->mPeriodToCollect ) ) {
-        mIgnoreCurrValue = true;
-    }
+    // Data set within a Technology is only active while it is operating.
+    mCurrTechnology = aData;
+    mStartNewGroup = true;
 }
 
 template<>
 void ManageStateVariables::DoCollect::popFilterStep<ITechnology*>( ITechnology* const& aData ) {
-    // Moving out of the current Technology so reset the ignore flag.
-    mIgnoreCurrValue = false;
+    // Moving out of the current Technology.
+    mCurrTechnology = 0;
+    mStartNewGroup = true;
 }
 
 template<>
 void ManageStateVariables::DoCollect::pushFilterStep<Market*>( Market* const& aData ) {
-    // Ignore any data set within a Market which is not for the current model year.
-    if( aData->getYear() != mParentClass->mYearToCollect ) {
-        mIgnoreCurrValue = true;
-    }
+    // Data set within a Market is only active in the Market's year.
+    mCurrYear = aData->getYear();
+    mStartNewGroup = true;
 }
 
 template<>
 void ManageStateVariables::DoCollect::popFilterStep<Market*>( Market* const& aData ) {
-    // Moving out of the current Market so reset the ignore flag.
-    mIgnoreCurrValue = false;
+    // Moving out of the current Market.
+    mCurrYear = -1;
+    mStartNewGroup = true;
 }
             
 template<>
 void ManageStateVariables::DoCollect::pushFilterStep<NationalAccount*>( NationalAccount* const& aData ) {
-    // Ignore any data set within a NationalAccount which is not for the current model year.
-    if( aData->getYear() != mParentClass->mYearToCollect ) {
-        mIgnoreCurrValue = true;
-    }
+    // Data set within a NationalAccount is only active in the NationalAccount's year.
+    mCurrYear = aData->getYear();
+    mStartNewGroup = true;
 }
 
 template<>
 void ManageStateVariables::DoCollect::popFilterStep<NationalAccount*>( NationalAccount* const& aData ) {
-    // Moving out of the current NationalAccount so reset the ignore flag.
-    mIgnoreCurrValue = false;
+    // Moving out of the current NationalAccount.
+    mCurrYear = -1;
+    mStartNewGroup = true;
 }
-
@@ -0,0 +1,156 @@
+/*
+* LEGAL NOTICE
+* This computer software was prepared by Battelle Memorial Institute,
+* hereinafter the Contractor, under Contract No. DE-AC05-76RL0 1830
+* with the Department of Energy (DOE). NEITHER THE GOVERNMENT NOR THE
+* CONTRACTOR MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR ASSUMES ANY
+* LIABILITY FOR THE USE OF THIS SOFTWARE. This notice including this
+* sentence must appear on any copies of this computer software.
+* 
+* EXPORT CONTROL
+* User agrees that the Software will not be shipped, transferred or
+* exported into any country or used in any manner prohibited by the
+* United States Export Administration Act or any other applicable
+* export laws, restrictions or regulations (collectively the "Export Laws").
+* Export of the Software may require some form of license or other
+* authority from the U.S. Government, and failure to obtain such
+* export control license may result in criminal liability under
+* U.S. laws. In addition, if the Software is identified as export controlled
+* items under the Export Laws, User represents and warrants that User
+* is not a citizen, or otherwise located within, an embargoed nation
+* (including without limitation Iran, Syria, Sudan, Cuba, and North Korea)
+*     and that User is not otherwise prohibited
+* under the Export Laws from receiving the Software.
+* 
+* Copyright 2011 Battelle Memorial Institute.  All Rights Reserved.
+* Distributed as open-source under the terms of the Educational Community 
+* License version 2.0 (ECL 2.0). http://www.opensource.org/licenses/ecl2.php
+* 
+* For further details, see: http://www.globalchange.umd.edu/models/gcam/
+*
+*/
+
+
+/*! 
+* \file object_arena.cpp
+* \ingroup Objects
+* \brief The ObjectArena class source file.
+*/
+
+#include "util/base/include/definitions.h"
+#include <new>
+#include <algorithm>
+
+#include "util/base/include/object_arena.h"
+
+using namespace std;
+
+thread_local ObjectArena* ObjectArena::sCurrentArena = 0;
+
+namespace {
+    /*!
+     * \brief The header written in front of every object allocated through
+     *        ObjectArena::allocateObject so that it knows how to free it.
+     * \details The alignment ensures the object which follows the header is
+     *          suitably aligned for any type.
+     */
+    struct alignas( max_align_t ) ObjectHeader {
+        //! The arena the object was allocated from or null if from the heap.
+        ObjectArena* mArena;
+    };
+}
+
+/*!
+ * \brief Constructor.
+ * \param aBlockSize The size of each block of memory to allocate.
+ */
+ObjectArena::ObjectArena( const size_t aBlockSize ):
+mBlockSize( aBlockSize ),
+mCurrPos( 0 ),
+mCurrEnd( 0 ),
+mBytesAllocated( 0 )
+{
+}
+
+//! Destructor which frees all of the memory handed out at once.
+ObjectArena::~ObjectArena() {
+    for( char* block : mBlocks ) {
+        ::operator delete( block );
+    }
+}
+
+/*!
+ * \brief Allocate memory from the arena.
+ * \details Allocations are aligned for any type.  Requests larger than the
+ *          block size get a block of their own.
+ * \param aSize The number of bytes requested.
+ * \return A pointer to the allocated memory.
+ */
+void* ObjectArena::allocate( const size_t aSize ) {
+    const size_t alignedSize = ( aSize + alignof( max_align_t ) - 1 ) & ~( alignof( max_align_t ) - 1 );
+    if( static_cast<size_t>( mCurrEnd - mCurrPos ) < alignedSize ) {
+        const size_t blockSize = max( mBlockSize, alignedSize );
+        char* block = static_cast<char*>( ::operator new( blockSize ) );
+        mBlocks.push_back( block );
+        mCurrPos = block;
+        mCurrEnd = block + blockSize;
+    }
+    void* ret = mCurrPos;
+    mCurrPos += alignedSize;
+    mBytesAllocated += alignedSize;
+    return ret;
+}
+
+/*!
+ * \brief Get the total number of bytes handed out by this arena.
+ * \return The bytes allocated.
+ */
+size_t ObjectArena::getBytesAllocated() const {
+    return mBytesAllocated;
+}
+
+/*!
+ * \brief Allocate an object from the arena that is current on this thread or
+ *        from the heap if there is none.
+ * \param aSize The size of the object.
+ * \return A pointer to memory for the object.
+ */
+void* ObjectArena::allocateObject( const size_t aSize ) {
+    const size_t totalSize = sizeof( ObjectHeader ) + aSize;
+    ObjectHeader* header = static_cast<ObjectHeader*>( sCurrentArena ?
+        sCurrentArena->allocate( totalSize ) : ::operator new( totalSize ) );
+    header->mArena = sCurrentArena;
+    return header + 1;
+}
+
+/*!
+ * \brief Free an object allocated with allocateObject.
+ * \details Objects from an arena are only freed when the arena is destroyed.
+ * \param aPtr The object to free.
+ */
+void ObjectArena::deallocateObject( void* aPtr ) {
+    if( aPtr ) {
+        ObjectHeader* header = static_cast<ObjectHeader*>( aPtr ) - 1;
+        if( !header->mArena ) {
+            ::operator delete( header );
+        }
+    }
+}
+
+/*!
+ * \brief Constructor which makes the given arena current on this thread.
+ * \param aArena The arena to allocate from, a null arena leaves the current
+ *        arena unchanged.
+ */
+ObjectArena::Scope::Scope( ObjectArena* aArena ):
+mPrevArena( sCurrentArena )
+{
+    if( aArena ) {
+        sCurrentArena = aArena;
+    }
+}
+
+//! Destructor which restores the previously current arena.
+ObjectArena::Scope::~Scope() {
+    sCurrentArena = mPrevArena;
+}
@@ -52,6 +52,11 @@
 #include "containers/include/scenario.h"
 #include "util/base/include/manage_state_variables.hpp"
 
+#if GCAM_PARALLEL_ENABLED
+#include <tbb/parallel_for.h>
+#include <tbb/task_group.h>
+#endif
+
 extern Scenario* scenario;
 
 using namespace std;
@@ -114,17 +119,40 @@ void SupplyDemandCurve::calculatePoints( const std::vector<double>& aPrices, Sol
     // Have the state manage save the current state as a "clean" state.
     scenario->getManageStateVariables()->setPartialDeriv(true);
     
-    // iterate through the prices and determine supply and demand.
-    for ( int i = 0; i < numPrices; i++ ) {
-        F.partial(mMarketNumber);
+    // Only the price of this market changes between points so each one is
+    // calculated just as a partial derivative would be: the state is reset to
+    // the clean state and only the activities which depend on this market are
+    // recalculated.  This allows the points to be calculated in parallel, each
+    // in the state of the thread which picked it up.
+    const size_t firstPoint = mPoints.size();
+    mPoints.resize( firstPoint + numPrices );
+    auto calcPoint = [&]( int i ) {
+        UBVECTOR xx( x );
+        UBVECTOR fxx( nsolv );
+        F.partial( mMarketNumber );
         
-        x[ mMarketNumber ] = aPrices[ i ] * scalingFactor;
+        xx[ mMarketNumber ] = aPrices[ i ] * scalingFactor;
         
-        F(x, fx, mMarketNumber);
+        F( xx, fxx, mMarketNumber );
         
-        SolutionInfo s = aSolnSet.getSolvable( mMarketNumber );
-        mPoints.push_back( new SupplyDemandPoint( s.getPrice(), s.getDemand(), s.getSupply(), fx[ mMarketNumber ] ) );
+        const SolutionInfo& s = aSolnSet.getSolvable( mMarketNumber );
+        mPoints[ firstPoint + i ] = new SupplyDemandPoint( s.getPrice(), s.getDemand(), s.getSupply(), fxx[ mMarketNumber ] );
+    };
+
+#if !GCAM_PARALLEL_ENABLED
+    for ( int i = 0; i < numPrices; i++ ) {
+        calcPoint( i );
     }
+#else
+    tbb::task_arena& threadPool = scenario->getManageStateVariables()->mThreadPool;
+    tbb::task_group tg;
+    threadPool.execute([&](){
+        tg.run([&](){
+            tbb::parallel_for( 0, numPrices, calcPoint );
+        });
+    });
+    threadPool.execute([&tg](){ tg.wait(); });
+#endif
     
     // restore state information for summary.
     F.partial(-1);
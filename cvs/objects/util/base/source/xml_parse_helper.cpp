@@ -89,6 +89,7 @@
 #include "util/logger/include/logger_factory.h"
 #include "util/logger/include/logger.h"
 #include "util/base/include/configuration.h"
+#include "util/base/include/object_arena.h"
 
 using namespace std;
 using namespace rapidxml;
@@ -178,6 +179,21 @@ void XMLParseHelper::cleanupParser() {
 
 //=============================================================================
 
+/*!
+ * \brief Get the arena to allocate the children of the given container from.
+ * \details Only Regions currently have an arena, all other containers allocate
+ *          from the arena of their enclosing Region if any.
+ * \return The arena to use or null to keep using the current arena.
+ */
+template<typename ContainerType>
+ObjectArena* getObjectArena( ContainerType* aContainer ) {
+    return 0;
+}
+
+ObjectArena* getObjectArena( Region* aRegion ) {
+    return aRegion->getObjectArena();
+}
+
 // A specialization Factory for Technology Containers since they get parsed
 // with the various technology tags or the stub-technology tag
 template<>
@@ -514,6 +530,10 @@ void>::type parseDataI(const rapidxml::xml_node<char>* aNode, DataType& aData) {
         }
     }
     
+    // Objects created while parsing the children of a Region are allocated from
+    // that region's arena, if it has one.
+    ObjectArena::Scope arenaScope( getObjectArena( currContainer ) );
+
     // parse child nodes
     ParseChildData parseChildHelper(aNode, attrs);
     parseChildHelper.setContainer(currContainer);
@@ -612,6 +632,10 @@ void>::type parseDataI(const rapidxml::xml_node<char>* aNode, DataType& aData) {
         }
     }
     
+    // Objects created while parsing the children of a Region are allocated from
+    // that region's arena, if it has one.
+    ObjectArena::Scope arenaScope( getObjectArena( currContainer ) );
+
     // parse child nodes
     ParseChildData parseChildHelper(aNode, attrs);
     parseChildHelper.setContainer(currContainer);
@@ -935,6 +959,38 @@ bool XMLParseHelper::parseXML(const string& aXMLFile, Scenario* aRootElement) {
     return parseXMLInternal(aXMLFile, aRootElement);
 }
 
+/*!
+* \brief Parse XML held in memory using the given Scenario as the parsing context to start processing the XML.
+* \details This allows callers that embed the model to apply small add-on changes to a Scenario without
+*          having to write them out to a file first.  The content is otherwise handled exactly as if it
+*          had been read from an add-on XML file.
+* \param aXMLContent The XML document to parse.
+* \param aRootElement A valid Scenario instance, which starts the processing of the XML nodes.
+* \return False if there was an error with the XML syntax of aXMLContent.
+*/
+bool XMLParseHelper::parseXMLString(const string& aXMLContent, Scenario* aRootElement) {
+    try {
+        Data<Scenario*, CONTAINER> root(aRootElement, "");
+        
+        // Rapid XML requires a modifiable, null terminated buffer which must stay
+        // alive for the duration of the parse.
+        vector<char> buffer(aXMLContent.begin(), aXMLContent.end());
+        buffer.push_back('\0');
+        
+        rapidxml::xml_document<> doc;
+        doc.parse<rapidxml::parse_non_destructive>(&buffer[0]);
+        
+        XMLParseHelper::parseData(doc.first_node(), root);
+    }
+    catch(rapidxml::parse_error parseException) {
+        cerr << "Failed to parse XML string with error: "
+             << parseException.what() << endl;
+        return false;
+    }
+    
+    return true;
+}
+
 /*!
 * \brief Parse the given XML file using the given IScenarioRunner as the parsing context to start processing the XML.
  * \details Note that aRootElement may not exist yet and will need to open the XML file to determine what the